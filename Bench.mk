@@ -0,0 +1,80 @@
+CC ?= gcc
+
+CFLAGS := -std=gnu17 -Wall -Wextra -Wpedantic -O2 -DNDEBUG -DPLATFORM_DESKTOP -Ivendor/wyhash
+LDLIBS := -lm
+
+DEPS := \
+	src/bit_mask.c \
+	src/bytes.c \
+	src/replay.c \
+	src/replay_mapping.c \
+
+DEPS.containers := \
+	src/allocations.c \
+	src/bit_mask.c \
+	src/bytes.c \
+	src/collections/deque.c \
+	src/counters.c \
+	src/replay.c \
+	src/replay_mapping.c \
+	src/rng.c \
+	src/utils/arena_allocator.c \
+	src/utils/quadtree.c \
+
+$(VERBOSE).SILENT:
+
+.PHONY: @all
+@all: build/benches/replay_loading build/benches/input_stream build/benches/rng \
+	build/benches/containers build/benches/startup build/benches/input_latency
+
+build:
+	mkdir $@
+
+build/benches: | build
+	mkdir $@
+
+build/benches/replay_loading: benches/replay_loading.c $(DEPS) | build/benches
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+build/benches/input_stream: benches/input_stream.c $(DEPS) | build/benches
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+build/benches/rng: benches/rng.c src/rng.c | build/benches
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+build/benches/containers: benches/containers.c $(DEPS.containers) | build/benches
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+build/benches/startup: benches/startup.c | build/benches
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+build/benches/input_latency: benches/input_latency.c | build/benches
+	$(CC) $(CFLAGS) -o $@ $^ $(LDLIBS)
+
+.PHONY: @bench/containers
+@bench/containers: build/benches/containers | build/benches
+	cd build/benches; ./containers
+
+.PHONY: @bench/input-latency
+@bench/input-latency: build/benches/input_latency | build/benches
+	cd build/benches; ./input_latency
+
+.PHONY: @bench/input-stream
+@bench/input-stream: build/benches/input_stream | build/benches
+	cd build/benches; ./input_stream
+
+.PHONY: @bench/replay-loading
+@bench/replay-loading: build/benches/replay_loading | build/benches
+	cd build/benches; ./replay_loading
+
+.PHONY: @bench/rng
+@bench/rng: build/benches/rng | build/benches
+	cd build/benches; ./rng
+
+.PHONY: @bench/startup
+@bench/startup: build/benches/startup | build/benches
+	cd build/benches; ./startup
+
+.PHONY: @clean
+@clean:
+	if [ -d "build/benches" ]; then $(RM) -r build/benches; fi
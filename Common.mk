@@ -16,6 +16,10 @@ sources.vendor.raylib := \
 
 cflags.src.vendor := -Ivendor/raylib/src -Ivendor/wyhash
 
+# Whether floats get fused into FMAs differs between compilers and targets, which makes Replays
+# play back differently from one build to another.
+cflags.src.determinism := -ffp-contract=off
+
 objects.src := $(patsubst %.c,$(OUTDIR)/%.o,$(sources.src))
 objects.vendor.raylib := $(patsubst %.c,$(OUTDIR)/%.o,$(sources.vendor.raylib))
 
@@ -38,7 +38,7 @@ CFLAGS ?= $(cflags.$(build))
 private cflags.src.warnings := -Wall -Wextra -Wpedantic
 private cflags.src.defines := -DPLATFORM_DESKTOP
 
-cflags.src := -std=gnu17 $(cflags.src.warnings) $(cflags.src.defines) $(cflags.src.vendor) -MMD -g $(CFLAGS)
+cflags.src := -std=gnu17 $(cflags.src.warnings) $(cflags.src.defines) $(cflags.src.determinism) $(cflags.src.vendor) -MMD -g $(CFLAGS)
 
 private cflags.vendor.raylib.defines := -D_GNU_SOURCE -DPLATFORM_DESKTOP -DGRAPHICS_API_OPENGL_33
 
@@ -47,10 +47,51 @@ cflags.vendor.raylib := -std=gnu99 $(cflags.vendor.raylib.defines) -MMD -g $(CFL
 pkgs := glfw3
 
 LDFLAGS ?= $(shell pkg-config --libs-only-L $(pkgs))
-LDLIBS ?= -lm -ldl -lrt $(shell pkg-config --libs-only-l $(pkgs))
+LDLIBS ?= -lm -ldl -lrt -lpthread $(shell pkg-config --libs-only-l $(pkgs))
 
 include Build.mk
 
+# The simulation without a window: every source but the entry point and the game loop, plus a
+# headless stand-in for the few raylib functions the simulation calls.
+sources.sim := $(filter-out src/main.c src/game.c,$(sources.src)) sim/headless.c
+
+objects.sim := $(patsubst %.c,$(OUTDIR)/headless/%.o,$(sources.sim))
+objects.sim.cli := $(OUTDIR)/headless/sim/main.o
+objects.sim.bench := $(OUTDIR)/headless/sim/bench.o
+objects.sim.tests := $(OUTDIR)/headless/tests/sim_tests.o $(OUTDIR)/headless/tests/testing.o
+objects.sim.executables := $(objects.sim.cli) $(objects.sim.bench) $(objects.sim.tests)
+objects.sim.directories := $(sort $(dir $(objects.sim) $(objects.sim.executables)))
+objects.sim.prerequisites := $(patsubst %.o,%.d,$(objects.sim) $(objects.sim.executables))
+
+output.sim.library := $(OUTDIR)/libltlr-sim.a
+output.sim := $(OUTDIR)/ltlr-sim
+output.sim.bench := $(OUTDIR)/ltlr-bench
+output.sim.tests := $(OUTDIR)/ltlr-sim-tests
+
+# Profiled sections are always compiled in so that benchmarks can break frames down by system; they
+# cost next to nothing unless a Profiler frame is in progress. Every heap allocation is counted, not
+# just the annotated ones (see TRACK_ALLOCATION).
+private cflags.sim.defines := -DPLATFORM_HEADLESS -DPROFILING -DALLOCATIONS_INTERPOSE
+
+ldflags.sim := -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc
+ldlibs.sim := -lm -lpthread -ldl
+
+cflags.sim := -std=gnu17 $(cflags.src.warnings) $(cflags.sim.defines) $(cflags.src.determinism) $(cflags.src.vendor) -MMD -g $(CFLAGS)
+
+-include $(objects.sim.prerequisites)
+
+$(objects.sim) $(objects.sim.executables): $(OUTDIR)/headless/%.o: %.c
+	$(CC) $(cflags.sim) -o $@ -c $<
+
+# The replays that `@bench` measures, and where its results (and the baseline they are compared
+# against) are kept. Timings only compare on the same machine, so the baseline is not checked in;
+# it lives outside of build/benches so that cleaning up after Bench.mk does not throw it away.
+bench.replays := $(sort $(wildcard benches/replays/*.ltlrr))
+bench.results := build/benches/replays.json
+bench.baseline := build/baselines/replays.txt
+# How many entities every stress stage that `@bench/stress` sweeps has.
+bench.stress := 64,128,256,384,512,640,768,896
+
 .PHONY: @all
 @all: @build/release
 
@@ -66,12 +107,24 @@ include Build.mk
 	$(RM) $(DESTDIR)$(bindir)/$(BIN)
 	$(RM) -r $(DESTDIR)$(datadir)/$(BIN)
 
-$(objects.directories):
+$(objects.directories) $(objects.sim.directories):
 	mkdir -p $@
 
 $(output): $(objects)
 	$(CC) $(CFLAGS) -o $@ $^ $(LDFLAGS) $(LDLIBS)
 
+$(output.sim.library): $(objects.sim)
+	$(AR) rcs $@ $^
+
+$(output.sim): $(objects.sim.cli) $(output.sim.library)
+	$(CC) $(CFLAGS) $(ldflags.sim) -o $@ $^ $(ldlibs.sim)
+
+$(output.sim.bench): $(objects.sim.bench) $(output.sim.library)
+	$(CC) $(CFLAGS) $(ldflags.sim) -o $@ $^ $(ldlibs.sim)
+
+$(output.sim.tests): $(objects.sim.tests) $(output.sim.library)
+	$(CC) $(CFLAGS) $(ldflags.sim) -o $@ $^ $(ldlibs.sim)
+
 .PHONY: @build/debug
 @build/debug: $(objects.directories)
 	@$(MAKE) -f $(self) $(output) build=debug
@@ -80,6 +133,42 @@ $(output): $(objects)
 @build/release: $(objects.directories)
 	@$(MAKE) -f $(self) $(output) build=release
 
+.PHONY: @sim/debug
+@sim/debug: $(objects.sim.directories)
+	@$(MAKE) -f $(self) $(output.sim) build=debug
+
+.PHONY: @sim/release
+@sim/release: $(objects.sim.directories)
+	@$(MAKE) -f $(self) $(output.sim) build=release
+
+# Runs the tests that need the whole simulation (e.g. those of memory budgets).
+.PHONY: @sim/test
+@sim/test: $(objects.sim.directories)
+	@$(MAKE) -f $(self) $(output.sim.tests) build=release
+	./$(output.sim.tests)
+
+build/benches build/baselines:
+	mkdir -p $@
+
+# Fails if any replay got slower than the baseline (see `@bench/baseline`) by more than 10%.
+.PHONY: @bench
+@bench: $(objects.sim.directories) | build/benches
+	@$(MAKE) -f $(self) $(output.sim.bench) build=release
+	./$(output.sim.bench) --baseline $(bench.baseline) --output $(bench.results) $(bench.replays)
+
+.PHONY: @bench/baseline
+@bench/baseline: $(objects.sim.directories) | build/benches build/baselines
+	@$(MAKE) -f $(self) $(output.sim.bench) build=release
+	./$(output.sim.bench) --save-baseline $(bench.baseline) --output $(bench.results) \
+		$(bench.replays)
+
+# Writes how much every system costs per stress stage to a csv that is ready to be plotted.
+.PHONY: @bench/stress
+@bench/stress: $(objects.sim.directories) | build/benches
+	@$(MAKE) -f $(self) $(output.sim.bench) build=release
+	./$(output.sim.bench) --runs 3 --frames 600 --stress $(bench.stress) \
+		--curve build/benches/stress.csv --output build/benches/stress.json
+
 .PHONY: @zig/build
 @zig/build:
 	$(ZIG) build
@@ -111,3 +200,6 @@ compile_commands.json: scripts/generate.nu $(sources.directories)
 	-@$(RM) $(objects)
 	-@$(RM) $(objects.prerequisites)
 	-@$(RM) $(output)
+	-@$(RM) $(objects.sim) $(objects.sim.executables)
+	-@$(RM) $(objects.sim.prerequisites)
+	-@$(RM) $(output.sim.library) $(output.sim) $(output.sim.bench) $(output.sim.tests)
@@ -1,11 +1,22 @@
 CC ?= gcc
 GPROF ?= gprof
 
-CFLAGS := -std=gnu17 -Wall -Wextra -Wpedantic -g -pg -Og -DPLATFORM_DESKTOP
+CFLAGS := -std=gnu17 -Wall -Wextra -Wpedantic -g -pg -Og -DPLATFORM_DESKTOP -Ivendor/raylib/src -Ivendor/wyhash
 LDLIBS := -lm
 
 DEPS := \
+	src/allocations.c \
+	src/bit_mask.c \
+	src/bytes.c \
+	src/counters.c \
 	src/collections/deque.c \
+	src/fixed.c \
+	src/input_queue.c \
+	src/profiler.c \
+	src/replay.c \
+	src/rng.c \
+	src/startup.c \
+	src/tracing.c \
 	src/utils/quadtree.c \
 	tests/testing.c \
 
@@ -0,0 +1,467 @@
+// Measures the containers and small utilities that the rest of the game is built on one operation
+// at a time, so that a change to any of them can be judged on its own.
+
+#include "../src/bit_mask.h"
+#include "../src/collections/deque.h"
+#include "../src/replay.h"
+#include "../src/rng.h"
+#include "../src/utils/arena_allocator.h"
+#include "../src/utils/quadtree.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_TOTAL_ITERATIONS (1 << 20)
+#define DEFAULT_TOTAL_RUNS (5)
+
+// A stage is a handful of segments laid side by side; every segment is a screen wide.
+#define STAGE_WIDTH (320 * 5)
+#define STAGE_HEIGHT (180)
+#define QUADTREE_DEPTH (4)
+// The size of an entity, and of the area around it that is checked for collisions.
+#define ENTITY_SIZE (16)
+#define NEIGHBORHOOD_SIZE (48)
+
+// Thirty minutes of input, just like the Scene's InputStreams.
+#define INPUT_CAPACITY (60 * 60 * 30)
+#define INPUT_BINDINGS (4)
+// The Scene's jump buffer.
+#define INPUT_BUFFER (8)
+
+#define ARENA_SIZE (1024 * 8)
+
+typedef double f64;
+
+// Runs `iterations` operations (with an optional parameter, e.g. the size of an element) and
+// returns how long they took in nanoseconds. Setting up and tearing down is not part of the time.
+typedef f64 (*BenchmarkFn)(usize parameter, usize iterations);
+
+typedef struct
+{
+	const char* name;
+	BenchmarkFn run;
+	usize parameter;
+} Benchmark;
+
+// Results are folded into this so that the compiler cannot throw the work away.
+static volatile u64 sink;
+
+static f64 Now(void)
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+// A cheap source of noise that is not the Rng being measured.
+static u32 NextNoise(u32* state)
+{
+	*state = *state * 1664525 + 1013904223;
+
+	return *state >> 8;
+}
+
+static f64 DequePushPop(const usize elementSize, const usize iterations)
+{
+	Deque deque = DequeCreate(elementSize, 64);
+	u8 value[64] = { 0 };
+	u64 total = 0;
+
+	const f64 start = Now();
+
+	for (usize i = 0; i < iterations; ++i)
+	{
+		value[0] = (u8)i;
+		DequePushBack(&deque, value);
+		total += *(u8*)DequePopFront(&deque);
+	}
+
+	const f64 elapsed = Now() - start;
+
+	sink += total;
+	DequeDestroy(&deque);
+
+	return elapsed;
+}
+
+static f64 DequeGetSequential(const usize elementSize, const usize iterations)
+{
+	Deque deque = DequeCreate(elementSize, 1024);
+	u8 value[64] = { 0 };
+	u64 total = 0;
+
+	for (usize i = 0; i < 1024; ++i)
+	{
+		value[0] = (u8)i;
+		DequePushBack(&deque, value);
+	}
+
+	const f64 start = Now();
+
+	for (usize i = 0; i < iterations; ++i)
+	{
+		total += *(u8*)DequeGet(&deque, i % 1024);
+	}
+
+	const f64 elapsed = Now() - start;
+
+	sink += total;
+	DequeDestroy(&deque);
+
+	return elapsed;
+}
+
+static Region EntityRegion(u32* noise)
+{
+	return (Region) {
+		.x = NextNoise(noise) % (STAGE_WIDTH - ENTITY_SIZE),
+		.y = NextNoise(noise) % (STAGE_HEIGHT - ENTITY_SIZE),
+		.width = ENTITY_SIZE,
+		.height = ENTITY_SIZE,
+	};
+}
+
+static Region Neighborhood(const Region entity)
+{
+	return (Region) {
+		.x = entity.x - (NEIGHBORHOOD_SIZE - ENTITY_SIZE) / 2,
+		.y = entity.y - (NEIGHBORHOOD_SIZE - ENTITY_SIZE) / 2,
+		.width = NEIGHBORHOOD_SIZE,
+		.height = NEIGHBORHOOD_SIZE,
+	};
+}
+
+// Fills a stage with `entities` entities at a time, then starts over.
+static f64 QuadtreeAddDensity(const usize entities, const usize iterations)
+{
+	const Region stage = { 0, 0, STAGE_WIDTH, STAGE_HEIGHT };
+	Quadtree* quadtree = QuadtreeNew(stage, QUADTREE_DEPTH);
+	u32 noise = 20180217;
+	f64 elapsed = 0;
+
+	// The first fill grows every Deque in the tree; only fills that reuse them are measured.
+	for (usize i = 0; i < entities; ++i)
+	{
+		QuadtreeAdd(quadtree, i, EntityRegion(&noise));
+	}
+
+	for (usize done = 0; done < iterations; done += entities)
+	{
+		Region regions[1024];
+		const usize total = entities < iterations - done ? entities : iterations - done;
+
+		QuadtreeClear(quadtree);
+
+		for (usize i = 0; i < total; ++i)
+		{
+			regions[i] = EntityRegion(&noise);
+		}
+
+		const f64 start = Now();
+
+		for (usize i = 0; i < total; ++i)
+		{
+			sink += QuadtreeAdd(quadtree, i, regions[i]);
+		}
+
+		elapsed += Now() - start;
+	}
+
+	QuadtreeDestroy(quadtree);
+
+	return elapsed;
+}
+
+// Asks what is near each of `entities` entities, just like a broad phase would.
+static f64 QuadtreeQueryDensity(const usize entities, const usize iterations)
+{
+	const Region stage = { 0, 0, STAGE_WIDTH, STAGE_HEIGHT };
+	Quadtree* quadtree = QuadtreeNew(stage, QUADTREE_DEPTH);
+	Region regions[1024];
+	Deque result = DEQUE_OF(usize);
+	u32 noise = 20180217;
+	u64 total = 0;
+
+	for (usize i = 0; i < entities; ++i)
+	{
+		regions[i] = EntityRegion(&noise);
+		QuadtreeAdd(quadtree, i, regions[i]);
+	}
+
+	const f64 start = Now();
+
+	for (usize i = 0; i < iterations; ++i)
+	{
+		DequeClear(&result);
+		QuadtreeQueryInto(quadtree, Neighborhood(regions[i % entities]), &result);
+		total += DequeGetSize(&result);
+	}
+
+	const f64 elapsed = Now() - start;
+
+	sink += total;
+	DequeDestroy(&result);
+	QuadtreeDestroy(quadtree);
+
+	return elapsed;
+}
+
+typedef enum
+{
+	// Walks every row in order, like the InputStream does.
+	PATTERN_ROWS,
+	// Walks every column in order, which jumps a whole row at a time.
+	PATTERN_COLUMNS,
+	PATTERN_RANDOM,
+} Pattern;
+
+static void PatternCoordinates(
+	const Pattern pattern,
+	const usize i,
+	const usize side,
+	u32* noise,
+	i32* x,
+	i32* y
+)
+{
+	switch (pattern)
+	{
+		case PATTERN_ROWS:
+		{
+			*x = i % side;
+			*y = (i / side) % side;
+			break;
+		}
+		case PATTERN_COLUMNS:
+		{
+			*x = (i / side) % side;
+			*y = i % side;
+			break;
+		}
+		case PATTERN_RANDOM:
+		{
+			*x = NextNoise(noise) % side;
+			*y = NextNoise(noise) % side;
+			break;
+		}
+	}
+}
+
+static f64 BitMaskGetPattern(const usize pattern, const usize iterations)
+{
+	const usize side = 1024;
+	BitMask mask = BitMaskCreate(side, side);
+	u32 noise = 20180217;
+	u64 total = 0;
+
+	for (usize i = 0; i < side * side; i += 3)
+	{
+		BitMaskSet(&mask, i % side, i / side, true);
+	}
+
+	const f64 start = Now();
+
+	for (usize i = 0; i < iterations; ++i)
+	{
+		i32 x = 0;
+		i32 y = 0;
+		PatternCoordinates(pattern, i, side, &noise, &x, &y);
+
+		total += BitMaskGet(&mask, x, y);
+	}
+
+	const f64 elapsed = Now() - start;
+
+	sink += total;
+	BitMaskDestroy(&mask);
+
+	return elapsed;
+}
+
+static f64 BitMaskSetPattern(const usize pattern, const usize iterations)
+{
+	const usize side = 1024;
+	BitMask mask = BitMaskCreate(side, side);
+	u32 noise = 20180217;
+
+	const f64 start = Now();
+
+	for (usize i = 0; i < iterations; ++i)
+	{
+		i32 x = 0;
+		i32 y = 0;
+		PatternCoordinates(pattern, i, side, &noise, &x, &y);
+
+		BitMaskSet(&mask, x, y, i & 1);
+	}
+
+	const f64 elapsed = Now() - start;
+
+	sink += mask.contents[0];
+	BitMaskDestroy(&mask);
+
+	return elapsed;
+}
+
+// Takes `size` bytes at a time, and flushes whenever the arena is full (like a new stage would).
+static f64 ArenaTake(const usize size, const usize iterations)
+{
+	ArenaAllocator arena = ArenaAllocatorCreate(ARENA_SIZE);
+	u64 total = 0;
+
+	const f64 start = Now();
+
+	for (usize i = 0; i < iterations; ++i)
+	{
+		if (arena.head + size > arena.size)
+		{
+			ArenaAllocatorFlush(&arena);
+		}
+
+		u8* taken = ArenaAllocatorTake(&arena, size);
+		taken[0] = (u8)i;
+		total += taken[0];
+	}
+
+	const f64 elapsed = Now() - start;
+
+	sink += total;
+	ArenaAllocatorDestroy(&arena);
+
+	return elapsed;
+}
+
+static f64 RngRange(const usize sequential, const usize iterations)
+{
+	Rng rng = sequential ? RngCreateSequential(20180217) : RngCreate(20180217);
+	u64 total = 0;
+
+	const f64 start = Now();
+
+	for (usize i = 0; i < iterations; ++i)
+	{
+		total += RngNextRange(&rng, 1, 31);
+	}
+
+	const f64 elapsed = Now() - start;
+
+	sink += total;
+
+	return elapsed;
+}
+
+// Holds every binding down for a random amount of frames, then lets go for a random amount of
+// frames (see benches/input_stream.c), and asks whether each binding was just pressed.
+static f64 InputPressed(const usize parameter, const usize iterations)
+{
+	(void)parameter;
+
+	InputStream stream = InputStreamCreate(INPUT_BINDINGS, INPUT_CAPACITY);
+	u32 noise = 20180217;
+	u32 remaining[INPUT_BINDINGS] = { 0 };
+	bool payload[INPUT_BINDINGS] = { false };
+	const u32 frames = INPUT_CAPACITY - 1;
+	u64 total = 0;
+
+	for (u32 frame = 0; frame < frames; ++frame)
+	{
+		for (usize i = 0; i < INPUT_BINDINGS; ++i)
+		{
+			if (remaining[i] == 0)
+			{
+				payload[i] = !payload[i];
+				remaining[i] = 1 + NextNoise(&noise) % 64;
+			}
+
+			remaining[i] -= 1;
+		}
+
+		InputStreamPush(&stream, payload);
+	}
+
+	const f64 start = Now();
+
+	for (usize i = 0; i < iterations; ++i)
+	{
+		const u32 frame = (u32)(i / INPUT_BINDINGS) % frames;
+		const u8 binding = i % INPUT_BINDINGS;
+
+		total += InputStreamPressed(&stream, binding, INPUT_BUFFER, frame);
+	}
+
+	const f64 elapsed = Now() - start;
+
+	sink += total;
+	InputStreamDestroy(&stream);
+
+	return elapsed;
+}
+
+static const Benchmark benchmarks[] = {
+	{ "DequePushBack+PopFront/4B", DequePushPop, 4 },
+	{ "DequePushBack+PopFront/16B", DequePushPop, 16 },
+	{ "DequePushBack+PopFront/64B", DequePushPop, 64 },
+	{ "DequeGet/4B", DequeGetSequential, 4 },
+	{ "DequeGet/16B", DequeGetSequential, 16 },
+	{ "DequeGet/64B", DequeGetSequential, 64 },
+	{ "QuadtreeAdd/64", QuadtreeAddDensity, 64 },
+	{ "QuadtreeAdd/256", QuadtreeAddDensity, 256 },
+	{ "QuadtreeAdd/1024", QuadtreeAddDensity, 1024 },
+	{ "QuadtreeQueryInto/64", QuadtreeQueryDensity, 64 },
+	{ "QuadtreeQueryInto/256", QuadtreeQueryDensity, 256 },
+	{ "QuadtreeQueryInto/1024", QuadtreeQueryDensity, 1024 },
+	{ "BitMaskGet/rows", BitMaskGetPattern, PATTERN_ROWS },
+	{ "BitMaskGet/columns", BitMaskGetPattern, PATTERN_COLUMNS },
+	{ "BitMaskGet/random", BitMaskGetPattern, PATTERN_RANDOM },
+	{ "BitMaskSet/rows", BitMaskSetPattern, PATTERN_ROWS },
+	{ "BitMaskSet/columns", BitMaskSetPattern, PATTERN_COLUMNS },
+	{ "BitMaskSet/random", BitMaskSetPattern, PATTERN_RANDOM },
+	{ "ArenaAllocatorTake/16B", ArenaTake, 16 },
+	{ "ArenaAllocatorTake/128B", ArenaTake, 128 },
+	{ "RngNextRange/counter", RngRange, 0 },
+	{ "RngNextRange/sequential", RngRange, 1 },
+	{ "InputStreamPressed", InputPressed, 0 },
+};
+
+// Usage: containers [iterations] [runs] [filter]
+// Only benchmarks whose name contains the filter (e.g. "Deque") are run.
+int main(int argc, char** argv)
+{
+	const usize iterations = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_TOTAL_ITERATIONS;
+	const usize runs = argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_TOTAL_RUNS;
+	const char* filter = argc > 3 ? argv[3] : "";
+
+	if (iterations == 0 || runs == 0)
+	{
+		fprintf(stderr, "Both the iterations and the runs have to be greater than zero.\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("%zu iterations, best of %zu runs\n", iterations, runs);
+
+	for (usize i = 0; i < sizeof(benchmarks) / sizeof(Benchmark); ++i)
+	{
+		const Benchmark* benchmark = &benchmarks[i];
+
+		if (strstr(benchmark->name, filter) == NULL)
+		{
+			continue;
+		}
+
+		f64 best = 0;
+
+		for (usize run = 0; run < runs; ++run)
+		{
+			const f64 elapsed = benchmark->run(benchmark->parameter, iterations);
+
+			best = run == 0 || elapsed < best ? elapsed : best;
+		}
+
+		printf("%-28s %8.2f ns/op\n", benchmark->name, best / iterations);
+	}
+
+	return EXIT_SUCCESS;
+}
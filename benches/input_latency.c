@@ -0,0 +1,288 @@
+// Models the game loop to estimate how long a key press takes to reach the update that consumes
+// it. Single-threaded, Timestep polls input either right before each update or (like the game used
+// to) right after it. With a simulation thread, the main thread samples input once per drawn frame
+// (and every simulated frame while it waits on a frame rate limit), and the simulation applies
+// whatever was sampled by the time each of its frames is due; a dedicated thread that polls input
+// every millisecond is modeled for comparison. Nothing is actually simulated or drawn: every update
+// and draw takes a fixed amount of time, and presenting blocks until the next vblank (unless vsync
+// is ineffective, in which case the game limits its own frame rate to the refresh rate).
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DEFAULT_TOTAL_PRESSES (20000)
+#define TARGET_FRAME_TIME (1.0 / 60)
+#define MAX_DELTA_TIME (0.25)
+#define INPUT_THREAD_PERIOD (1.0 / 1000)
+
+typedef double f64;
+typedef size_t usize;
+typedef uint64_t u64;
+
+typedef enum
+{
+	POLLING_AFTER_UPDATE,
+	POLLING_BEFORE_UPDATE,
+	// The simulation thread, with input sampled by the main thread (see LimitFrameRate).
+	POLLING_SIMULATION_THREAD,
+	// The simulation thread, with input sampled by a thread of its own.
+	POLLING_INPUT_THREAD,
+	POLLING_TOTAL,
+} Polling;
+
+static const char* const pollingNames[POLLING_TOTAL] = {
+	"after update",
+	"before update",
+	"per drawn frame",
+	"at 1 kHz",
+};
+
+typedef struct
+{
+	// How long a single update and a single draw take (in seconds).
+	f64 update;
+	f64 draw;
+	f64 refreshRate;
+	bool vsync;
+	Polling polling;
+} Model;
+
+// SplitMix64; any decent generator will do, it only decides when keys are pressed.
+static f64 NextUniform(u64* state)
+{
+	*state += 0x9E3779B97F4A7C15;
+
+	u64 z = *state;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+	z ^= z >> 31;
+
+	return (z >> 11) * 0x1.0p-53;
+}
+
+typedef struct
+{
+	f64 time;
+	f64 nextFrameTime;
+	// The last time input was sampled at before the frame was presented, if it was at all.
+	f64 lastSample;
+} Presenter;
+
+// Waits until the next frame is due: either the next vblank or, if vsync is ineffective, the next
+// multiple of the refresh period, sampling input every simulated frame in the meantime like
+// LimitFrameRate does with a simulation thread.
+static void WaitForNextFrame(const Model* model, Presenter* presenter, const bool sampling)
+{
+	const f64 period = 1.0 / model->refreshRate;
+
+	if (model->vsync)
+	{
+		presenter->time = ((usize)(presenter->time / period) + 1) * period;
+
+		return;
+	}
+
+	if (presenter->time < presenter->nextFrameTime)
+	{
+		while (sampling && presenter->time + TARGET_FRAME_TIME < presenter->nextFrameTime)
+		{
+			presenter->time += TARGET_FRAME_TIME;
+			presenter->lastSample = presenter->time;
+		}
+
+		presenter->time = presenter->nextFrameTime;
+	}
+
+	// If a frame ran late, start the next one right away rather than trying to catch up.
+	const f64 next = presenter->nextFrameTime + period;
+	presenter->nextFrameTime = next > presenter->time ? next : presenter->time;
+}
+
+// Runs Timestep from a standstill until the update that consumes a press at the given time, and
+// returns how long after the press that update began.
+static f64 MeasureSingleThreadedPress(const Model* model, const f64 press)
+{
+	Presenter presenter = { 0 };
+
+	f64 previousTime = 0;
+	f64 accumulator = 0;
+	f64 lastPoll = -1;
+
+	while (true)
+	{
+		const f64 deltaTime = presenter.time - previousTime;
+		previousTime = presenter.time;
+		accumulator += deltaTime > MAX_DELTA_TIME ? MAX_DELTA_TIME : deltaTime;
+
+		while (accumulator >= TARGET_FRAME_TIME)
+		{
+			if (model->polling == POLLING_BEFORE_UPDATE)
+			{
+				lastPoll = presenter.time;
+			}
+
+			// The update only sees input as of the last poll.
+			if (lastPoll >= press)
+			{
+				return presenter.time - press;
+			}
+
+			presenter.time += model->update;
+			accumulator -= TARGET_FRAME_TIME;
+
+			if (model->polling == POLLING_AFTER_UPDATE)
+			{
+				lastPoll = presenter.time;
+			}
+		}
+
+		presenter.time += model->draw;
+
+		WaitForNextFrame(model, &presenter, false);
+	}
+}
+
+// Returns when input is first sampled at or after the given time.
+static f64 FindSample(const Model* model, const f64 press)
+{
+	if (model->polling == POLLING_INPUT_THREAD)
+	{
+		return ((usize)(press / INPUT_THREAD_PERIOD) + 1) * INPUT_THREAD_PERIOD;
+	}
+
+	Presenter presenter = {
+		.lastSample = -1,
+	};
+
+	while (true)
+	{
+		// The main thread samples input right after presenting, then draws (see Timestep).
+		presenter.lastSample = presenter.time;
+
+		if (presenter.lastSample >= press)
+		{
+			return presenter.lastSample;
+		}
+
+		presenter.time += model->draw;
+
+		WaitForNextFrame(model, &presenter, true);
+
+		if (presenter.lastSample >= press)
+		{
+			return presenter.lastSample;
+		}
+	}
+}
+
+// The simulation thread keeps to its own schedule, which starts at an arbitrary point within a
+// drawn frame, and only applies input that was sampled by the time a frame was due (see
+// RunSimulation).
+static f64 MeasureThreadedPress(const Model* model, const f64 press, const f64 phase)
+{
+	const f64 sample = FindSample(model, press);
+	const f64 frames = (usize)((sample - phase) / TARGET_FRAME_TIME);
+
+	f64 due = phase + frames * TARGET_FRAME_TIME;
+
+	if (due < sample)
+	{
+		due += TARGET_FRAME_TIME;
+	}
+
+	return due - press;
+}
+
+static int CompareF64(const void* a, const void* b)
+{
+	const f64 x = *(const f64*)a;
+	const f64 y = *(const f64*)b;
+
+	return (x > y) - (x < y);
+}
+
+static void Measure(const Model* model, f64* latencies, const usize total)
+{
+	u64 state = 1;
+	f64 sum = 0;
+
+	for (usize i = 0; i < total; ++i)
+	{
+		// Let the loop settle for a second, then press somewhere within the next one.
+		const f64 press = 1 + NextUniform(&state);
+
+		if (model->polling == POLLING_SIMULATION_THREAD || model->polling == POLLING_INPUT_THREAD)
+		{
+			const f64 phase = NextUniform(&state) * TARGET_FRAME_TIME;
+
+			latencies[i] = MeasureThreadedPress(model, press, phase);
+		}
+		else
+		{
+			latencies[i] = MeasureSingleThreadedPress(model, press);
+		}
+
+		sum += latencies[i];
+	}
+
+	qsort(latencies, total, sizeof(f64), CompareF64);
+
+	printf(
+		"%3.0f Hz%s, poll %-15s: mean %5.1f ms, p99 %5.1f ms\n",
+		model->refreshRate,
+		model->vsync ? "        " : " no vsync",
+		pollingNames[model->polling],
+		sum / total * 1e3,
+		latencies[total * 99 / 100] * 1e3
+	);
+}
+
+// Usage: input_latency [presses] [update ms] [draw ms]
+int main(int argc, char** argv)
+{
+	const usize total = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_TOTAL_PRESSES;
+	const f64 update = (argc > 2 ? strtod(argv[2], NULL) : 1) * 1e-3;
+	const f64 draw = (argc > 3 ? strtod(argv[3], NULL) : 3) * 1e-3;
+
+	if (total == 0)
+	{
+		fprintf(stderr, "There has to be at least one press.\n");
+		return EXIT_FAILURE;
+	}
+
+	printf(
+		"Pressing %zu times (%.1f ms updates, %.1f ms draws).\n",
+		total,
+		update * 1e3,
+		draw * 1e3
+	);
+
+	f64* latencies = malloc(sizeof(f64) * total);
+
+	// A display slower than the simulation is where sampling while waiting on a frame matters.
+	const Model displays[] = {
+		{ .refreshRate = 60, .vsync = true },
+		{ .refreshRate = 144, .vsync = true },
+		{ .refreshRate = 30, .vsync = true },
+		{ .refreshRate = 30, .vsync = false },
+	};
+
+	for (usize i = 0; i < sizeof(displays) / sizeof(displays[0]); ++i)
+	{
+		for (Polling j = 0; j < POLLING_TOTAL; ++j)
+		{
+			Model model = displays[i];
+			model.update = update;
+			model.draw = draw;
+			model.polling = j;
+
+			Measure(&model, latencies, total);
+		}
+	}
+
+	free(latencies);
+
+	return EXIT_SUCCESS;
+}
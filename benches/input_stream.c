@@ -0,0 +1,256 @@
+// Compares InputStreamPressed and InputStreamReleased against the original frame by frame
+// implementation, which stored every frame's bits one after another.
+
+#include "../src/bit_mask.h"
+#include "../src/replay.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Thirty minutes of input, just like the Scene's InputStreams.
+#define CAPACITY (60 * 60 * 30)
+#define TOTAL_BINDINGS (4)
+#define DEFAULT_TOTAL_FRAMES (CAPACITY - 1)
+#define DEFAULT_TOTAL_RUNS (5)
+// The Scene's jump buffer.
+#define BUFFER (8)
+
+typedef double f64;
+
+typedef struct
+{
+	u32 capacity;
+	u32 barriers[TOTAL_BINDINGS];
+	BitMask bits;
+} ReferenceStream;
+
+static f64 Now(void)
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+static usize WrapFrame(const ReferenceStream* self, const u32 frame, const i32 offset)
+{
+	return (frame + (u32)offset + self->capacity) % self->capacity;
+}
+
+static bool ReferencePressing(const ReferenceStream* self, const u8 binding, const u32 frame)
+{
+	return BitMaskGet(&self->bits, binding, WrapFrame(self, frame, 0));
+}
+
+static bool ReferencePressed(
+	const ReferenceStream* self,
+	const u8 binding,
+	const usize buffer,
+	const u32 frame
+)
+{
+	const usize wrapped = WrapFrame(self, frame, 0);
+
+	if (!ReferencePressing(self, binding, wrapped))
+	{
+		return false;
+	}
+
+	for (usize i = 1; i <= buffer; ++i)
+	{
+		const usize offsetFrame = WrapFrame(self, wrapped, -i);
+
+		if (frame - i < self->barriers[binding])
+		{
+			return false;
+		}
+
+		if (!ReferencePressing(self, binding, offsetFrame))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool ReferenceReleased(
+	const ReferenceStream* self,
+	const u8 binding,
+	const usize buffer,
+	const u32 frame
+)
+{
+	const usize wrapped = WrapFrame(self, frame, 0);
+
+	if (ReferencePressing(self, binding, wrapped))
+	{
+		return false;
+	}
+
+	for (usize i = 1; i <= buffer; ++i)
+	{
+		const usize offsetFrame = WrapFrame(self, wrapped, -i);
+
+		if (frame - i < self->barriers[binding])
+		{
+			return false;
+		}
+
+		if (ReferencePressing(self, binding, offsetFrame))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Generates input that resembles a player: every binding is held down for a random amount of
+// frames, then released for a random amount of frames.
+static void Record(InputStream* stream, ReferenceStream* reference, const u32 frames)
+{
+	u32 state = 20180217;
+	u32 remaining[TOTAL_BINDINGS] = { 0 };
+	bool payload[TOTAL_BINDINGS] = { false };
+
+	for (u32 frame = 0; frame < frames; ++frame)
+	{
+		for (usize i = 0; i < TOTAL_BINDINGS; ++i)
+		{
+			if (remaining[i] == 0)
+			{
+				state = state * 1664525 + 1013904223;
+				payload[i] = !payload[i];
+				remaining[i] = 1 + (state >> 26);
+			}
+
+			remaining[i] -= 1;
+
+			BitMaskSet(&reference->bits, i, frame % reference->capacity, payload[i]);
+		}
+
+		InputStreamPush(stream, payload);
+	}
+}
+
+typedef bool (*QueryFn)(const void* stream, u8 binding, usize buffer, u32 frame);
+
+static bool QueryReference(
+	const void* stream,
+	const u8 binding,
+	const usize buffer,
+	const u32 frame
+)
+{
+	return ReferencePressed(stream, binding, buffer, frame)
+		   + ReferenceReleased(stream, binding, buffer, frame);
+}
+
+static bool QueryStream(
+	const void* stream,
+	const u8 binding,
+	const usize buffer,
+	const u32 frame
+)
+{
+	return InputStreamPressed(stream, binding, buffer, frame)
+		   + InputStreamReleased(stream, binding, buffer, frame);
+}
+
+// Returns the fastest time (in nanoseconds) it took to query every binding of every frame.
+static f64 Measure(
+	const QueryFn query,
+	const void* stream,
+	const u32 frames,
+	const usize runs,
+	usize* total
+)
+{
+	f64 best = 0;
+
+	for (usize run = 0; run < runs; ++run)
+	{
+		usize count = 0;
+		const f64 start = Now();
+
+		for (u32 frame = 0; frame < frames; ++frame)
+		{
+			for (u8 binding = 0; binding < TOTAL_BINDINGS; ++binding)
+			{
+				count += query(stream, binding, BUFFER, frame);
+			}
+		}
+
+		const f64 elapsed = Now() - start;
+
+		best = run == 0 || elapsed < best ? elapsed : best;
+		*total = count;
+	}
+
+	return best;
+}
+
+// Usage: input_stream [frames] [runs]
+int main(int argc, char** argv)
+{
+	const u32 frames = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_TOTAL_FRAMES;
+	const usize runs = argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_TOTAL_RUNS;
+
+	InputStream stream = InputStreamCreate(TOTAL_BINDINGS, CAPACITY);
+	ReferenceStream reference = (ReferenceStream) {
+		.capacity = CAPACITY,
+		.barriers = { 0 },
+		.bits = BitMaskCreate(TOTAL_BINDINGS, CAPACITY),
+	};
+
+	Record(&stream, &reference, frames);
+
+	// Make sure both implementations agree (even when events have been consumed).
+	for (u32 frame = 0; frame < frames; ++frame)
+	{
+		for (u8 binding = 0; binding < TOTAL_BINDINGS; ++binding)
+		{
+			if (InputStreamPressed(&stream, binding, BUFFER, frame)
+					!= ReferencePressed(&reference, binding, BUFFER, frame)
+				|| InputStreamReleased(&stream, binding, BUFFER, frame)
+					   != ReferenceReleased(&reference, binding, BUFFER, frame))
+			{
+				fprintf(stderr, "Mismatch on frame %u for binding %u.\n", frame, binding);
+				return EXIT_FAILURE;
+			}
+
+			if (frame % 7 == binding)
+			{
+				InputStreamConsume(&stream, binding, frame);
+				reference.barriers[binding] = frame;
+			}
+		}
+	}
+
+	for (u8 binding = 0; binding < TOTAL_BINDINGS; ++binding)
+	{
+		InputStreamConsume(&stream, binding, 0);
+		reference.barriers[binding] = 0;
+	}
+
+	usize referenceTotal = 0;
+	usize streamTotal = 0;
+
+	const f64 referenceTime = Measure(QueryReference, &reference, frames, runs, &referenceTotal);
+	const f64 streamTime = Measure(QueryStream, &stream, frames, runs, &streamTotal);
+
+	const f64 queries = (f64)frames * TOTAL_BINDINGS;
+
+	printf("%u frames, buffer of %d, %zu events\n", frames, BUFFER, streamTotal);
+	printf("frame by frame: %7.2f ns/query\n", referenceTime / queries);
+	printf("word at a time: %7.2f ns/query\n", streamTime / queries);
+
+	BitMaskDestroy(&reference.bits);
+	InputStreamDestroy(&stream);
+
+	return referenceTotal == streamTotal ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,245 @@
+// Compares how long it takes to load (and play back) a corpus of Replay files by either reading and
+// copying them, or by mapping them into memory and viewing them in place.
+
+#include "../src/replay.h"
+#include "../src/replay_mapping.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define DEFAULT_TOTAL_REPLAYS (10000)
+// One minute of input.
+#define DEFAULT_REPLAY_LENGTH (60 * 60)
+#define TOTAL_BINDINGS (4)
+#define CORPUS_DIRECTORY "replays"
+
+typedef double f64;
+
+static f64 Now(void)
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return time.tv_sec * 1e3 + time.tv_nsec / 1e6;
+}
+
+static const char* GetEncodingName(const ReplayEncoding encoding)
+{
+	switch (encoding)
+	{
+		case REPLAY_ENCODING_RAW: {
+			return "raw";
+		}
+		case REPLAY_ENCODING_TOGGLES: {
+			return "toggles";
+		}
+		case REPLAY_ENCODING_PLANAR: {
+			return "planar";
+		}
+		default: {
+			return "unknown";
+		}
+	}
+}
+
+static void GetReplayPath(char* out, const usize size, const ReplayEncoding encoding, const usize i)
+{
+	const char* name = GetEncodingName(encoding);
+
+	snprintf(out, size, "%s/%s_%05zu.ltlrr", CORPUS_DIRECTORY, name, i);
+}
+
+static void WriteCorpus(const ReplayEncoding encoding, const usize total, const u32 length)
+{
+	mkdir(CORPUS_DIRECTORY, 0755);
+
+	for (usize i = 0; i < total; ++i)
+	{
+		InputStream stream = InputStreamCreate(TOTAL_BINDINGS, length + 1);
+
+		for (u32 frame = 0; frame < length; ++frame)
+		{
+			// Hold each binding for a while, at a different rate per Replay.
+			const bool payload[TOTAL_BINDINGS] = {
+				(frame / (7 + i % 5)) % 2 == 0,
+				(frame / 60) % 3 == 1,
+				frame % (13 + i % 3) == 0,
+				frame > length / 2,
+			};
+
+			InputStreamPush(&stream, payload);
+		}
+
+		ReplayResult result = ReplayTryFromInputStream((u32)i, &stream);
+		ReplayBytes bytes = ReplayBytesFromReplayWithEncoding(&result.contents.ok, encoding);
+
+		char path[64];
+		GetReplayPath(path, sizeof(path), encoding, i);
+
+		FILE* file = fopen(path, "wb");
+		fwrite(bytes.data, sizeof(u8), bytes.size, file);
+		fclose(file);
+
+		ReplayBytesDestroy(&bytes);
+		ReplayDestroy(&result.contents.ok);
+		InputStreamDestroy(&stream);
+	}
+}
+
+// Touches every frame of the given InputStream, which is roughly what playing it back would do.
+static usize Playback(const InputStream* stream)
+{
+	usize pressed = 0;
+
+	for (u32 frame = 0; frame < stream->length; ++frame)
+	{
+		pressed += InputStreamPressing(stream, 0, frame);
+	}
+
+	return pressed;
+}
+
+typedef struct
+{
+	f64 loading;
+	f64 playback;
+	usize pressed;
+} Timings;
+
+// The way replays have always been loaded: read the file, decode it, then copy it into a stream.
+static void LoadByCopying(const char* path, InputStream* stream, Timings* timings)
+{
+	const f64 start = Now();
+
+	FILE* file = fopen(path, "rb");
+
+	fseek(file, 0, SEEK_END);
+	const long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	u8* data = malloc(size);
+	fread(data, sizeof(u8), size, file);
+	fclose(file);
+
+	ReplayResult result = ReplayTryFromBytes(data, size);
+
+	if (result.type == REPLAY_RESULT_TYPE_ERR
+		|| !InputStreamLoadReplay(stream, &result.contents.ok))
+	{
+		fprintf(stderr, "Could not load %s.\n", path);
+		exit(EXIT_FAILURE);
+	}
+
+	const f64 loaded = Now();
+
+	timings->pressed += Playback(stream);
+	timings->loading += loaded - start;
+	timings->playback += Now() - loaded;
+
+	ReplayDestroy(&result.contents.ok);
+	free(data);
+}
+
+static void LoadByMapping(const char* path, Timings* timings)
+{
+	const f64 start = Now();
+
+	ReplayMappingResult result = ReplayMappingTryOpen(path);
+
+	if (result.type == REPLAY_RESULT_TYPE_ERR)
+	{
+		fprintf(stderr, "Could not load %s.\n", path);
+		exit(EXIT_FAILURE);
+	}
+
+	InputStream stream = InputStreamCreateView(&result.contents.ok.replay);
+
+	const f64 loaded = Now();
+
+	timings->pressed += Playback(&stream);
+	timings->loading += loaded - start;
+	timings->playback += Now() - loaded;
+
+	InputStreamDestroy(&stream);
+	ReplayMappingDestroy(&result.contents.ok);
+}
+
+static void PresentTimings(
+	const char* name,
+	const char* method,
+	const Timings* timings,
+	const usize total
+)
+{
+	printf(
+		"%-8s %-5s loading: %9.3f ms (%7.2f us/replay), playback: %9.3f ms\n",
+		name,
+		method,
+		timings->loading,
+		timings->loading * 1e3 / total,
+		timings->playback
+	);
+}
+
+static void Measure(const ReplayEncoding encoding, const usize total, const u32 length)
+{
+	const char* name = GetEncodingName(encoding);
+	char path[64];
+
+	// Mirror the Scene, which loads Replays into a preallocated stream.
+	InputStream stream = InputStreamCreate(TOTAL_BINDINGS, length + 1);
+
+	Timings copied = { 0 };
+
+	for (usize i = 0; i < total; ++i)
+	{
+		GetReplayPath(path, sizeof(path), encoding, i);
+		LoadByCopying(path, &stream, &copied);
+	}
+
+	Timings mapped = { 0 };
+
+	for (usize i = 0; i < total; ++i)
+	{
+		GetReplayPath(path, sizeof(path), encoding, i);
+		LoadByMapping(path, &mapped);
+	}
+
+	InputStreamDestroy(&stream);
+
+	if (copied.pressed != mapped.pressed)
+	{
+		fprintf(stderr, "The %s replays did not play back identically.\n", name);
+		exit(EXIT_FAILURE);
+	}
+
+	PresentTimings(name, "copy", &copied, total);
+	PresentTimings(name, "map", &mapped, total);
+}
+
+// Usage: replay_loading [total replays] [frames per replay]
+int main(int argc, char** argv)
+{
+	const usize total = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_TOTAL_REPLAYS;
+	const u32 length = argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_REPLAY_LENGTH;
+
+	printf("Loading %zu replays of %u frames each.\n", total, length);
+
+	const ReplayEncoding encodings[] = {
+		REPLAY_ENCODING_PLANAR,
+		REPLAY_ENCODING_RAW,
+		REPLAY_ENCODING_TOGGLES,
+	};
+
+	for (usize i = 0; i < sizeof(encodings) / sizeof(encodings[0]); ++i)
+	{
+		WriteCorpus(encodings[i], total, length);
+		Measure(encodings[i], total, length);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+// Compares the sequential Rng that older Replays depend on against the counter-based one, both one
+// value at a time and in bulk (RngFillRange).
+
+#include "../src/rng.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_TOTAL_VALUES (1 << 20)
+#define DEFAULT_TOTAL_RUNS (5)
+// Roughly how many values a single particle burst asks for.
+#define BURST (64)
+
+typedef uint32_t u32;
+
+typedef enum
+{
+	METHOD_NEXT_RANGE,
+	METHOD_FILL_RANGE,
+} Method;
+
+static f64 Now(void)
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+static f64 Measure(
+	const Rng rng,
+	const Method method,
+	i32* values,
+	const usize length,
+	const usize runs,
+	u64* checksum
+)
+{
+	f64 best = 0;
+
+	for (usize run = 0; run < runs; ++run)
+	{
+		Rng copy = rng;
+		const f64 start = Now();
+
+		for (usize i = 0; i < length; i += BURST)
+		{
+			if (method == METHOD_FILL_RANGE)
+			{
+				RngFillRange(&copy, values + i, BURST, 1, 31);
+				continue;
+			}
+
+			for (usize j = 0; j < BURST; ++j)
+			{
+				values[i + j] = RngNextRange(&copy, 1, 31);
+			}
+		}
+
+		const f64 elapsed = Now() - start;
+
+		best = run == 0 || elapsed < best ? elapsed : best;
+
+		*checksum = 0;
+
+		for (usize i = 0; i < length; ++i)
+		{
+			*checksum += (u64)values[i];
+		}
+	}
+
+	return best;
+}
+
+// Usage: rng [values] [runs]
+int main(int argc, char** argv)
+{
+	usize length = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_TOTAL_VALUES;
+	const usize runs = argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_TOTAL_RUNS;
+
+	length = (length + BURST - 1) / BURST * BURST;
+
+	i32* values = malloc(sizeof(i32) * length);
+
+	u64 sequentialChecksum = 0;
+	u64 counterChecksum = 0;
+	u64 fillChecksum = 0;
+
+	const f64 sequentialTime = Measure(
+		RngCreateSequential(20180217),
+		METHOD_NEXT_RANGE,
+		values,
+		length,
+		runs,
+		&sequentialChecksum
+	);
+	const f64 counterTime =
+		Measure(RngCreate(20180217), METHOD_NEXT_RANGE, values, length, runs, &counterChecksum);
+	const f64 fillTime =
+		Measure(RngCreate(20180217), METHOD_FILL_RANGE, values, length, runs, &fillChecksum);
+
+	printf("%zu values in bursts of %d\n", length, BURST);
+	printf("sequential RngNextRange: %6.2f ns/value\n", sequentialTime / length);
+	printf("counter RngNextRange:    %6.2f ns/value\n", counterTime / length);
+	printf("counter RngFillRange:    %6.2f ns/value\n", fillTime / length);
+
+	free(values);
+
+	// Filling must produce exactly what RngNextRange would have.
+	return counterChecksum == fillChecksum ? EXIT_SUCCESS : EXIT_FAILURE;
+}
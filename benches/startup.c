@@ -0,0 +1,170 @@
+// Measures the part of startup that the game does on its loading thread: reading every image in
+// content/ and decoding it (with the same decoder raylib's LoadImage uses), both cold (after asking
+// the OS to drop the file from its page cache) and warm. Building the first stage is covered by
+// ltlr-bench's SceneBuildStage section instead.
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#include "../vendor/raylib/src/external/stb_image.h"
+#pragma GCC diagnostic pop
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_TOTAL_RUNS (20)
+#define DEFAULT_CONTENT_DIRECTORY "../../content"
+#define MAX_RUNS (1024)
+
+typedef double f64;
+typedef size_t usize;
+
+static const char* const images[] = {
+	"atlas.png",
+	"icon.png",
+};
+
+static f64 Now(void)
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return time.tv_sec * 1e3 + time.tv_nsec / 1e6;
+}
+
+typedef struct
+{
+	f64 read[MAX_RUNS];
+	f64 decode[MAX_RUNS];
+} Timings;
+
+// Reads and decodes the given file once. A cold load first asks the OS to evict the file from its
+// page cache, which is only a hint; it has no effect on some file systems (e.g. tmpfs).
+static void Load(const char* path, const bool cold, const usize run, Timings* timings)
+{
+	const int descriptor = open(path, O_RDONLY);
+
+	if (descriptor < 0)
+	{
+		fprintf(stderr, "Could not open %s.\n", path);
+		exit(EXIT_FAILURE);
+	}
+
+	if (cold)
+	{
+		posix_fadvise(descriptor, 0, 0, POSIX_FADV_DONTNEED);
+	}
+
+	const f64 start = Now();
+
+	struct stat status;
+	fstat(descriptor, &status);
+
+	unsigned char* data = malloc(status.st_size);
+
+	if (read(descriptor, data, status.st_size) != status.st_size)
+	{
+		fprintf(stderr, "Could not read %s.\n", path);
+		exit(EXIT_FAILURE);
+	}
+
+	const f64 loaded = Now();
+
+	int width = 0;
+	int height = 0;
+	int components = 0;
+	unsigned char* pixels =
+		stbi_load_from_memory(data, status.st_size, &width, &height, &components, 0);
+
+	if (pixels == NULL)
+	{
+		fprintf(stderr, "Could not decode %s.\n", path);
+		exit(EXIT_FAILURE);
+	}
+
+	timings->read[run] = loaded - start;
+	timings->decode[run] = Now() - loaded;
+
+	stbi_image_free(pixels);
+	free(data);
+	close(descriptor);
+}
+
+static int CompareF64(const void* a, const void* b)
+{
+	const f64 x = *(const f64*)a;
+	const f64 y = *(const f64*)b;
+
+	return (x > y) - (x < y);
+}
+
+static f64 GetMedian(f64* values, const usize length)
+{
+	qsort(values, length, sizeof(f64), CompareF64);
+
+	return values[length / 2];
+}
+
+static void PresentTimings(
+	const char* name,
+	const char* temperature,
+	Timings* timings,
+	const usize runs
+)
+{
+	const f64 read = GetMedian(timings->read, runs);
+	const f64 decode = GetMedian(timings->decode, runs);
+
+	printf(
+		"%-10s %-4s read: %8.3f ms, decode: %8.3f ms, total: %8.3f ms\n",
+		name,
+		temperature,
+		read,
+		decode,
+		read + decode
+	);
+}
+
+// Usage: startup [runs] [content directory]
+int main(int argc, char** argv)
+{
+	const usize runs = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_TOTAL_RUNS;
+	const char* directory = argc > 2 ? argv[2] : DEFAULT_CONTENT_DIRECTORY;
+
+	if (runs == 0 || runs > MAX_RUNS)
+	{
+		fprintf(stderr, "The number of runs must be between 1 and %d.\n", MAX_RUNS);
+		return EXIT_FAILURE;
+	}
+
+	printf("Loading every image in %s (median of %zu runs).\n", directory, runs);
+
+	static Timings cold;
+	static Timings warm;
+
+	for (usize i = 0; i < sizeof(images) / sizeof(images[0]); ++i)
+	{
+		char path[256];
+		snprintf(path, sizeof(path), "%s/%s", directory, images[i]);
+
+		// Every warm load finds the file cached by the cold load right before it.
+		for (usize run = 0; run < runs; ++run)
+		{
+			Load(path, true, run, &cold);
+			Load(path, false, run, &warm);
+		}
+
+		PresentTimings(images[i], "cold", &cold, runs);
+		PresentTimings(images[i], "warm", &warm, runs);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -50,6 +50,7 @@ pub fn build(b: *std.Build) !void {
     exe.addCSourceFiles(.{ .files = sources.items, .flags = &.{
         "-std=gnu17",
         "-DPLATFORM_DESKTOP",
+        "-ffp-contract=off",
         "-Ivendor/raylib/src",
         "-Ivendor/wyhash",
     } });
@@ -97,6 +98,7 @@ pub fn build(b: *std.Build) !void {
             exe.linkSystemLibrary("m");
             exe.linkSystemLibrary("dl");
             exe.linkSystemLibrary("rt");
+            exe.linkSystemLibrary("pthread");
             exe.linkSystemLibrary("glfw");
         },
         else => {
@@ -110,4 +112,81 @@ pub fn build(b: *std.Build) !void {
 
     const run_step = b.step("run", "Run the application");
     run_step.dependOn(&run_exe.step);
+
+    // The simulation's command-line tools depend on POSIX (dirent.h, pthread.h, unistd.h), so they
+    // are not built for Windows.
+    if (target.result.os.tag == .windows) {
+        return;
+    }
+
+    // The simulation without a window; see sim/headless.c.
+    var sim_sources = std.ArrayList([]const u8).init(b.allocator);
+    defer sim_sources.deinit();
+
+    for (sources.items) |source| {
+        const basename = std.fs.path.basename(source);
+
+        if (std.mem.eql(u8, basename, "main.c") or std.mem.eql(u8, basename, "game.c")) {
+            continue;
+        }
+
+        try sim_sources.append(source);
+    }
+
+    try sim_sources.append("sim/headless.c");
+
+    // Unlike Desktop.mk, malloc is not interposed (see ALLOCATIONS_INTERPOSE), so only annotated
+    // allocations are counted.
+    const sim_flags = &.{
+        "-std=gnu17",
+        "-DPLATFORM_HEADLESS",
+        "-DPROFILING",
+        "-ffp-contract=off",
+        "-Ivendor/raylib/src",
+        "-Ivendor/wyhash",
+    };
+
+    const sim_lib = b.addStaticLibrary(.{
+        .name = "ltlr-sim",
+        .target = target,
+        .optimize = optimize,
+    });
+
+    sim_lib.linkLibC();
+    sim_lib.addCSourceFiles(.{ .files = sim_sources.items, .flags = sim_flags });
+
+    b.installArtifact(sim_lib);
+
+    const sim_exe = b.addExecutable(.{
+        .name = "ltlr-sim",
+        .target = target,
+        .optimize = optimize,
+    });
+
+    sim_exe.linkLibC();
+    sim_exe.addCSourceFiles(.{ .files = &.{"sim/main.c"}, .flags = sim_flags });
+    sim_exe.linkLibrary(sim_lib);
+
+    b.installArtifact(sim_exe);
+
+    const run_sim = b.addRunArtifact(sim_exe);
+
+    if (b.args) |args| {
+        run_sim.addArgs(args);
+    }
+
+    const sim_step = b.step("sim", "Run the simulation without a window");
+    sim_step.dependOn(&run_sim.step);
+
+    const bench_exe = b.addExecutable(.{
+        .name = "ltlr-bench",
+        .target = target,
+        .optimize = optimize,
+    });
+
+    bench_exe.linkLibC();
+    bench_exe.addCSourceFiles(.{ .files = &.{"sim/bench.c"}, .flags = sim_flags });
+    bench_exe.linkLibrary(sim_lib);
+
+    b.installArtifact(bench_exe);
 }
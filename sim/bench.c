@@ -0,0 +1,953 @@
+// Measures how fast the simulation plays back a set of Replays (as a whole and system by system),
+// and compares the results against a baseline so that performance regressions stand out. It can
+// also sweep synthetic stress stages of growing size (see StressParams) to show how every system
+// scales with the number of entities.
+
+#include "../src/common.h"
+#include "../src/context.h"
+#include "../src/footprint.h"
+#include "../src/profiler.h"
+#include "../src/replay.h"
+#include "../src/replay_mapping.h"
+#include "../src/rng.h"
+#include "../src/scene.h"
+#include "../src/stress.h"
+
+#include <math.h>
+#include <raylib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_RUNS (5)
+#define DEFAULT_WARMUP (1)
+#define DEFAULT_THRESHOLD (0.1)
+#define DEFAULT_STRESS_FRAMES (60 * 60)
+
+typedef struct
+{
+	usize runs;
+	usize warmup;
+	// How much slower than the baseline a Replay may get before it counts as a regression (e.g.
+	// 0.1 for 10%).
+	f64 threshold;
+	const char* baseline;
+	const char* saveBaseline;
+	const char* output;
+	char** paths;
+	usize pathsLength;
+	// How many entities every stress stage has (see --stress).
+	usize* stress;
+	usize stressLength;
+	usize stressFrames;
+	// 0 to keep entities as dense as they are in a real level.
+	u32 stressWidth;
+	bool randomInput;
+	const char* curve;
+} Options;
+
+typedef struct
+{
+	const char* name;
+	u8 depth;
+	// How long the section took across every frame of the profiled run (in seconds).
+	f64 total;
+} SectionTotal;
+
+typedef struct
+{
+	const char* path;
+	// Only used by stress stages, which have no file to be named after; `path` points to this.
+	char stressName[32];
+	StressParams stressParams;
+	// NULL if the Replay was benchmarked successfully.
+	const char* error;
+	usize frames;
+	// The average cost of a frame during each measured run (in nanoseconds).
+	f64* runs;
+	// The median of `runs`.
+	f64 nsPerFrame;
+	// Percentiles of every measured frame's cost (in nanoseconds).
+	f64 p50;
+	f64 p99;
+	SectionTotal sections[PROFILER_MAX_SECTIONS];
+	usize sectionsLength;
+	// The most memory every subsystem held on to at the end of any frame.
+	Footprint footprint;
+	// The baseline's nsPerFrame for the same Replay (0 if the baseline does not have it).
+	f64 baseline;
+	bool regressed;
+} Benchmark;
+
+static void PrintUsage(void)
+{
+	fprintf(
+		stderr,
+		"usage: ltlr-bench [--runs N] [--warmup N] [--baseline PATH] [--threshold PERCENT]\n"
+		"                  [--save-baseline PATH] [--output PATH] [--stress ENTITIES,...\n"
+		"                  [--frames N] [--width PIXELS] [--input scripted|random]\n"
+		"                  [--curve PATH]] [REPLAY...]\n"
+		"\n"
+		"  --runs N           measure every Replay N times (defaults to %d)\n"
+		"  --warmup N         play every Replay back N times before measuring (defaults to %d)\n"
+		"  --baseline PATH    compare against an earlier run's results (see --save-baseline)\n"
+		"  --threshold PERCENT\n"
+		"                     how much slower than the baseline counts as a regression (defaults\n"
+		"                     to %.0f)\n"
+		"  --save-baseline PATH\n"
+		"                     write every result's time per frame to PATH, a line at a time\n"
+		"  --output PATH      write the results to PATH as json (defaults to stdout)\n"
+		"  --stress ENTITIES,...\n"
+		"                     also measure a synthetic stage with every given number of entities\n"
+		"  --frames N         simulate every stress stage for N frames (defaults to %d)\n"
+		"  --width PIXELS     make every stress stage this wide (defaults to as wide as it takes\n"
+		"                     to keep entities as dense as in a real level)\n"
+		"  --input scripted|random\n"
+		"                     how the player moves through a stress stage (defaults to scripted)\n"
+		"  --curve PATH       write every stress stage's cost (per system) to PATH as csv\n",
+		DEFAULT_RUNS,
+		DEFAULT_WARMUP,
+		DEFAULT_THRESHOLD * 100,
+		DEFAULT_STRESS_FRAMES
+	);
+}
+
+static bool TryParseCount(const char* text, usize* out)
+{
+	char* end = NULL;
+	*out = strtoull(text, &end, 10);
+
+	return *text != '\0' && *end == '\0';
+}
+
+// Parses a comma-separated list of counts (e.g. "128,256,512") into `out`, which has room for at
+// least as many counts as the text has characters.
+static bool TryParseCounts(const char* text, usize* out, usize* length)
+{
+	*length = 0;
+
+	while (true)
+	{
+		char* end = NULL;
+		out[*length] = strtoull(text, &end, 10);
+
+		if (end == text || out[*length] == 0 || (*end != ',' && *end != '\0'))
+		{
+			return false;
+		}
+
+		*length += 1;
+
+		if (*end == '\0')
+		{
+			return true;
+		}
+
+		text = end + 1;
+	}
+}
+
+static bool TryParseOptions(const int argc, char** argv, Options* out)
+{
+	*out = (Options) {
+		.runs = DEFAULT_RUNS,
+		.warmup = DEFAULT_WARMUP,
+		.threshold = DEFAULT_THRESHOLD,
+		.baseline = NULL,
+		.saveBaseline = NULL,
+		.output = NULL,
+		.paths = malloc(sizeof(char*) * argc),
+		.pathsLength = 0,
+		.stress = NULL,
+		.stressLength = 0,
+		.stressFrames = DEFAULT_STRESS_FRAMES,
+		.stressWidth = 0,
+		.randomInput = false,
+		.curve = NULL,
+	};
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if (strcmp(argv[i], "--runs") == 0 && hasValue)
+		{
+			if (!TryParseCount(argv[++i], &out->runs) || out->runs == 0)
+			{
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--warmup") == 0 && hasValue)
+		{
+			if (!TryParseCount(argv[++i], &out->warmup))
+			{
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--threshold") == 0 && hasValue)
+		{
+			char* end = NULL;
+			const char* text = argv[++i];
+			out->threshold = strtod(text, &end) / 100;
+
+			if (*text == '\0' || *end != '\0' || out->threshold < 0)
+			{
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--baseline") == 0 && hasValue)
+		{
+			out->baseline = argv[++i];
+		}
+		else if (strcmp(argv[i], "--save-baseline") == 0 && hasValue)
+		{
+			out->saveBaseline = argv[++i];
+		}
+		else if (strcmp(argv[i], "--output") == 0 && hasValue)
+		{
+			out->output = argv[++i];
+		}
+		else if (strcmp(argv[i], "--stress") == 0 && hasValue)
+		{
+			const char* text = argv[++i];
+
+			free(out->stress);
+			out->stress = malloc(sizeof(usize) * (strlen(text) + 1));
+
+			if (!TryParseCounts(text, out->stress, &out->stressLength))
+			{
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--frames") == 0 && hasValue)
+		{
+			if (!TryParseCount(argv[++i], &out->stressFrames) || out->stressFrames == 0
+				|| out->stressFrames >= UINT32_MAX)
+			{
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--width") == 0 && hasValue)
+		{
+			usize width = 0;
+
+			if (!TryParseCount(argv[++i], &width) || width < CTX_VIEWPORT_WIDTH
+				|| width > UINT32_MAX)
+			{
+				return false;
+			}
+
+			out->stressWidth = width;
+		}
+		else if (strcmp(argv[i], "--input") == 0 && hasValue)
+		{
+			const char* input = argv[++i];
+
+			if (strcmp(input, "scripted") != 0 && strcmp(input, "random") != 0)
+			{
+				return false;
+			}
+
+			out->randomInput = strcmp(input, "random") == 0;
+		}
+		else if (strcmp(argv[i], "--curve") == 0 && hasValue)
+		{
+			out->curve = argv[++i];
+		}
+		else if (argv[i][0] != '-')
+		{
+			out->paths[out->pathsLength] = argv[i];
+			out->pathsLength += 1;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return out->pathsLength + out->stressLength > 0;
+}
+
+static f64 Now(void)
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+// Replays are told apart by file name alone, so that results compare across checkouts.
+static const char* GetName(const char* path)
+{
+	const char* slash = strrchr(path, '/');
+
+	return slash != NULL ? slash + 1 : path;
+}
+
+static int CompareF64(const void* a, const void* b)
+{
+	const f64 lhs = *(const f64*)a;
+	const f64 rhs = *(const f64*)b;
+
+	return (lhs > rhs) - (lhs < rhs);
+}
+
+// Returns the value that the given fraction of (sorted) values are at or below.
+static f64 Percentile(const f64* sorted, const usize length, const f64 fraction)
+{
+	const usize index = (usize)ceil(length * fraction);
+
+	return sorted[MIN(MAX(index, 1), length) - 1];
+}
+
+// Plays the scene's Replay back from the start. Every frame's cost is written to `durations` (if
+// it is not NULL), every section's cost is added up with the given Profiler (if it is not NULL),
+// and the benchmark's footprint is raised to every frame's.
+static void Run(
+	Scene* scene,
+	const u32 seed,
+	const u8 flags,
+	const usize frames,
+	f64* durations,
+	Profiler* profiler,
+	Benchmark* benchmark
+)
+{
+	SceneReseed(scene, seed, flags);
+
+	for (usize i = 0; i < frames; ++i)
+	{
+		if (profiler != NULL)
+		{
+			ProfilerBeginFrame(profiler);
+		}
+
+		const f64 start = Now();
+
+		SceneUpdate(scene);
+
+		const f64 duration = Now() - start;
+
+		if (profiler != NULL)
+		{
+			ProfilerEndFrame(profiler);
+
+			const usize latest = (profiler->frames - 1) % PROFILER_HISTORY;
+
+			for (usize j = 0; j < profiler->sectionsLength; ++j)
+			{
+				benchmark->sections[j].total += profiler->sections[j].history[latest];
+			}
+		}
+
+		if (durations != NULL)
+		{
+			durations[i] = duration;
+		}
+
+		const Footprint footprint = FootprintMeasure(scene);
+		FootprintRaise(&benchmark->footprint, &footprint);
+	}
+
+	if (profiler != NULL)
+	{
+		benchmark->sectionsLength = profiler->sectionsLength;
+
+		for (usize j = 0; j < profiler->sectionsLength; ++j)
+		{
+			benchmark->sections[j].name = profiler->sections[j].name;
+			benchmark->sections[j].depth = profiler->sections[j].depth;
+		}
+	}
+}
+
+// Plays the given Replay back as many times as the options ask for, and fills in everything the
+// benchmark has to say about it.
+static void MeasureReplay(
+	Scene* scene,
+	const Replay* replay,
+	const Options* options,
+	Benchmark* benchmark
+)
+{
+	// SceneReseed keeps read-only InputStreams, so every run plays the same Replay back in place.
+	SceneStartPlayback(scene, replay);
+
+	const u32 seed = replay->seed;
+	const u8 flags = replay->flags;
+	const usize frames = replay->length;
+
+	benchmark->frames = frames;
+
+	for (usize i = 0; i < options->warmup; ++i)
+	{
+		Run(scene, seed, flags, frames, NULL, NULL, benchmark);
+	}
+
+	f64* durations = malloc(sizeof(f64) * MAX(frames * options->runs, 1));
+
+	for (usize i = 0; i < options->runs; ++i)
+	{
+		f64* run = &durations[frames * i];
+
+		Run(scene, seed, flags, frames, run, NULL, benchmark);
+
+		f64 total = 0;
+
+		for (usize j = 0; j < frames; ++j)
+		{
+			total += run[j];
+		}
+
+		benchmark->runs[i] = total * 1e9 / MAX(frames, 1);
+	}
+
+	// Profiling adds a little overhead of its own, so sections are measured in a run of their own.
+	Profiler* profiler = malloc(sizeof(Profiler));
+	ProfilerInit(profiler);
+	Run(scene, seed, flags, frames, NULL, profiler, benchmark);
+	free(profiler);
+
+	if (frames > 0)
+	{
+		qsort(durations, frames * options->runs, sizeof(f64), CompareF64);
+
+		benchmark->p50 = Percentile(durations, frames * options->runs, 0.5) * 1e9;
+		benchmark->p99 = Percentile(durations, frames * options->runs, 0.99) * 1e9;
+	}
+
+	f64* runs = malloc(sizeof(f64) * options->runs);
+	memcpy(runs, benchmark->runs, sizeof(f64) * options->runs);
+	qsort(runs, options->runs, sizeof(f64), CompareF64);
+
+	benchmark->nsPerFrame = Percentile(runs, options->runs, 0.5);
+
+	free(runs);
+	free(durations);
+
+	SceneStopPlayback(scene);
+}
+
+static void Measure(Scene* scene, const char* path, const Options* options, Benchmark* benchmark)
+{
+	*benchmark = (Benchmark) {
+		.path = path,
+		.error = NULL,
+		.runs = calloc(options->runs, sizeof(f64)),
+	};
+
+	const ReplayMappingResult result = ReplayMappingTryOpen(path);
+
+	if (result.type == REPLAY_RESULT_TYPE_ERR)
+	{
+		benchmark->error = StringFromReplayError(result.contents.err);
+		return;
+	}
+
+	ReplayMapping mapping = result.contents.ok;
+
+	MeasureReplay(scene, &mapping.replay, options, benchmark);
+
+	ReplayMappingDestroy(&mapping);
+}
+
+// Scripted input runs right and jumps every so often (like benches/replays/runner.ltlrr), while
+// random input holds every binding down (and lets go of it) for random amounts of time. Either way,
+// jump is pressed right away so that the menu is left on the first frame.
+static void RecordStressInput(InputStream* stream, const usize frames, const bool random)
+{
+	Rng rng = RngCreate(MAGIC_NUMBER);
+	u32 remaining[TOTAL_INPUT_BINDINGS] = { 0 };
+	bool payload[TOTAL_INPUT_BINDINGS] = { false };
+
+	for (usize frame = 0; frame < frames; ++frame)
+	{
+		if (!random || frame < 12)
+		{
+			payload[INPUT_BINDING_LEFT] = false;
+			payload[INPUT_BINDING_RIGHT] = true;
+			payload[INPUT_BINDING_JUMP] = frame % 40 < 12;
+			payload[INPUT_BINDING_STOMP] = false;
+		}
+		else
+		{
+			for (usize i = 0; i < TOTAL_INPUT_BINDINGS; ++i)
+			{
+				if (remaining[i] == 0)
+				{
+					payload[i] = !payload[i];
+					remaining[i] = RngNextRange(&rng, 1, 60 + 1);
+				}
+
+				remaining[i] -= 1;
+			}
+		}
+
+		InputStreamPush(stream, payload);
+	}
+}
+
+static void MeasureStress(
+	Scene* scene,
+	const usize entities,
+	const Options* options,
+	Benchmark* benchmark
+)
+{
+	*benchmark = (Benchmark) {
+		.error = NULL,
+		.stressParams = StressParamsCreate(entities, options->stressWidth),
+		.runs = calloc(options->runs, sizeof(f64)),
+	};
+
+	// Stages are named after how many entities they actually have (see StressParamsCreate).
+	snprintf(
+		benchmark->stressName,
+		sizeof(benchmark->stressName),
+		"stress-%zu",
+		StressParamsGetTotalEntities(&benchmark->stressParams)
+	);
+	benchmark->path = benchmark->stressName;
+
+	InputStream stream = InputStreamCreate(TOTAL_INPUT_BINDINGS, options->stressFrames + 1);
+	RecordStressInput(&stream, options->stressFrames, options->randomInput);
+
+	ReplayResult result = ReplayTryFromInputStream(MAGIC_NUMBER, &stream);
+	InputStreamDestroy(&stream);
+
+	if (result.type == REPLAY_RESULT_TYPE_ERR)
+	{
+		benchmark->error = StringFromReplayError(result.contents.err);
+		return;
+	}
+
+	scene->stress = &benchmark->stressParams;
+	MeasureReplay(scene, &result.contents.ok, options, benchmark);
+	scene->stress = NULL;
+
+	ReplayDestroy(&result.contents.ok);
+}
+
+// A baseline has a line per benchmark: its name, a space, and its nsPerFrame (e.g.
+// "long.ltlrr 17345.250"). Names may contain spaces themselves, just not line breaks.
+static void WriteBaseline(FILE* file, const Benchmark* benchmarks, const usize length)
+{
+	for (usize i = 0; i < length; ++i)
+	{
+		const Benchmark* benchmark = &benchmarks[i];
+
+		if (benchmark->error == NULL)
+		{
+			fprintf(file, "%s %.3f\n", GetName(benchmark->path), benchmark->nsPerFrame);
+		}
+	}
+}
+
+// Returns the nsPerFrame that the given baseline (see WriteBaseline) has for the given name, or 0
+// if it has none.
+static f64 FindBaseline(const char* contents, const char* name)
+{
+	const usize nameLength = strlen(name);
+
+	for (const char* line = contents; *line != '\0';)
+	{
+		const char* end = strchr(line, '\n');
+
+		if (end == NULL)
+		{
+			end = line + strlen(line);
+		}
+
+		// The whole rest of the line has to be the value, so that neither a name that merely
+		// starts with this one nor one that continues with a space can be mistaken for it.
+		if ((usize)(end - line) > nameLength + 1 && strncmp(line, name, nameLength) == 0
+			&& line[nameLength] == ' ')
+		{
+			const char* value = line + nameLength + 1;
+			char* valueEnd = NULL;
+			const f64 nsPerFrame = strtod(value, &valueEnd);
+
+			if (valueEnd == end && nsPerFrame > 0)
+			{
+				return nsPerFrame;
+			}
+		}
+
+		line = *end == '\0' ? end : end + 1;
+	}
+
+	return 0;
+}
+
+// Returns the contents of the given file (NULL-terminated), or NULL if it cannot be read.
+static char* ReadFile(const char* path)
+{
+	FILE* file = fopen(path, "rb");
+
+	if (file == NULL)
+	{
+		return NULL;
+	}
+
+	fseek(file, 0, SEEK_END);
+	const long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	char* contents = calloc(MAX(length, 0) + 1, 1);
+
+	if (length < 0 || fread(contents, 1, length, file) != (usize)length)
+	{
+		free(contents);
+		contents = NULL;
+	}
+
+	fclose(file);
+
+	return contents;
+}
+
+static void PrintBenchmarks(
+	FILE* file,
+	const Benchmark* benchmarks,
+	const usize length,
+	const Options* options
+)
+{
+	fprintf(
+		file,
+		"{\"runs\": %zu, \"warmup\": %zu, \"threshold\": %.3f, \"replays\": [\n",
+		options->runs,
+		options->warmup,
+		options->threshold
+	);
+
+	for (usize i = 0; i < length; ++i)
+	{
+		const Benchmark* benchmark = &benchmarks[i];
+
+		// Note that names are assumed not to need escaping.
+		fprintf(file, "  {\"replay\": \"%s\"", GetName(benchmark->path));
+
+		if (benchmark->error != NULL)
+		{
+			fprintf(file, ", \"error\": \"%s\"}", benchmark->error);
+		}
+		else
+		{
+			fprintf(
+				file,
+				", \"frames\": %zu, \"ns_per_frame\": %.1f, \"p50_ns\": %.1f, \"p99_ns\": %.1f, "
+				"\"runs_ns_per_frame\": [",
+				benchmark->frames,
+				benchmark->nsPerFrame,
+				benchmark->p50,
+				benchmark->p99
+			);
+
+			for (usize j = 0; j < options->runs; ++j)
+			{
+				fprintf(file, "%s%.1f", j > 0 ? ", " : "", benchmark->runs[j]);
+			}
+
+			fprintf(file, "], \"sections\": [");
+
+			for (usize j = 0; j < benchmark->sectionsLength; ++j)
+			{
+				const SectionTotal* section = &benchmark->sections[j];
+
+				fprintf(
+					file,
+					"%s{\"name\": \"%s\", \"depth\": %u, \"ns_per_frame\": %.1f}",
+					j > 0 ? ", " : "",
+					section->name,
+					section->depth,
+					section->total * 1e9 / MAX(benchmark->frames, 1)
+				);
+			}
+
+			fprintf(file, "], \"footprint\": [");
+
+			for (usize j = 0; j < FOOTPRINT_TOTAL; ++j)
+			{
+				const FootprintEntry* entry = &benchmark->footprint.entries[j];
+
+				fprintf(
+					file,
+					"%s{\"subsystem\": \"%s\", \"static\": %zu, \"heap\": %zu, \"vram\": %zu}",
+					j > 0 ? ", " : "",
+					FootprintGetName(j),
+					entry->staticBytes,
+					entry->heapBytes,
+					entry->vramBytes
+				);
+			}
+
+			fprintf(file, "]");
+
+			if (benchmark->baseline > 0)
+			{
+				fprintf(
+					file,
+					", \"baseline_ns_per_frame\": %.1f, \"change\": %.4f, \"regressed\": %s",
+					benchmark->baseline,
+					benchmark->nsPerFrame / benchmark->baseline - 1,
+					benchmark->regressed ? "true" : "false"
+				);
+			}
+
+			fprintf(file, "}");
+		}
+
+		fprintf(file, "%s\n", i + 1 < length ? "," : "");
+	}
+
+	fprintf(file, "]}\n");
+}
+
+// Writes a csv with a row per stress stage: how many entities it had, how wide it was, how long a
+// frame took, and how long every section took per frame (0 if a stage never ran it).
+static void PrintCurve(FILE* file, const Benchmark* benchmarks, const usize length)
+{
+	const char* names[PROFILER_MAX_SECTIONS];
+	usize namesLength = 0;
+
+	// Sections are numbered in the order they were first run, which can differ from stage to stage.
+	for (usize i = 0; i < length; ++i)
+	{
+		for (usize j = 0; j < benchmarks[i].sectionsLength; ++j)
+		{
+			const char* name = benchmarks[i].sections[j].name;
+			bool found = false;
+
+			for (usize k = 0; k < namesLength && !found; ++k)
+			{
+				found = strcmp(names[k], name) == 0;
+			}
+
+			if (!found && namesLength < PROFILER_MAX_SECTIONS)
+			{
+				names[namesLength] = name;
+				namesLength += 1;
+			}
+		}
+	}
+
+	fprintf(file, "entities,width,ns_per_frame,p50_ns,p99_ns");
+
+	for (usize i = 0; i < namesLength; ++i)
+	{
+		fprintf(file, ",%s", names[i]);
+	}
+
+	fprintf(file, "\n");
+
+	for (usize i = 0; i < length; ++i)
+	{
+		const Benchmark* benchmark = &benchmarks[i];
+
+		if (benchmark->error != NULL)
+		{
+			continue;
+		}
+
+		fprintf(
+			file,
+			"%zu,%u,%.1f,%.1f,%.1f",
+			StressParamsGetTotalEntities(&benchmark->stressParams),
+			benchmark->stressParams.width,
+			benchmark->nsPerFrame,
+			benchmark->p50,
+			benchmark->p99
+		);
+
+		for (usize j = 0; j < namesLength; ++j)
+		{
+			f64 sectionTotal = 0;
+
+			for (usize k = 0; k < benchmark->sectionsLength; ++k)
+			{
+				if (strcmp(benchmark->sections[k].name, names[j]) == 0)
+				{
+					sectionTotal = benchmark->sections[k].total;
+				}
+			}
+
+			fprintf(file, ",%.1f", sectionTotal * 1e9 / MAX(benchmark->frames, 1));
+		}
+
+		fprintf(file, "\n");
+	}
+}
+
+int main(const int argc, char** argv)
+{
+	Options options;
+
+	if (!TryParseOptions(argc, argv, &options))
+	{
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	SetTraceLogLevel(LOG_WARNING);
+
+	char* baseline = NULL;
+
+	if (options.baseline != NULL)
+	{
+		baseline = ReadFile(options.baseline);
+
+		// There is nothing to compare against the first time around.
+		if (baseline == NULL)
+		{
+			fprintf(stderr, "ltlr-bench: %s: no baseline to compare against\n", options.baseline);
+		}
+	}
+
+	Scene* scene = calloc(1, sizeof(Scene));
+	SceneInit(scene);
+
+	const Footprint startup = FootprintMeasure(scene);
+	Footprint peak = startup;
+
+	const usize total = options.pathsLength + options.stressLength;
+	Benchmark* benchmarks = calloc(total, sizeof(Benchmark));
+	bool failed = false;
+
+	for (usize i = 0; i < total; ++i)
+	{
+		Benchmark* benchmark = &benchmarks[i];
+
+		if (i < options.pathsLength)
+		{
+			Measure(scene, options.paths[i], &options, benchmark);
+		}
+		else
+		{
+			MeasureStress(scene, options.stress[i - options.pathsLength], &options, benchmark);
+		}
+
+		if (benchmark->error != NULL)
+		{
+			fprintf(stderr, "ltlr-bench: %s: %s\n", benchmark->path, benchmark->error);
+			failed = true;
+			continue;
+		}
+
+		FootprintRaise(&peak, &benchmark->footprint);
+
+		if (baseline != NULL)
+		{
+			benchmark->baseline = FindBaseline(baseline, GetName(benchmark->path));
+		}
+
+		fprintf(
+			stderr,
+			"ltlr-bench: %s: %.1f ns/frame (p50 %.1f, p99 %.1f)",
+			GetName(benchmark->path),
+			benchmark->nsPerFrame,
+			benchmark->p50,
+			benchmark->p99
+		);
+
+		if (benchmark->baseline > 0)
+		{
+			const f64 change = benchmark->nsPerFrame / benchmark->baseline - 1;
+
+			benchmark->regressed = change > options.threshold;
+			failed |= benchmark->regressed;
+
+			fprintf(
+				stderr,
+				", %+.1f%% against the baseline%s",
+				change * 100,
+				benchmark->regressed ? " (regression)" : ""
+			);
+		}
+
+		fprintf(stderr, "\n");
+	}
+
+	SceneDestroy(scene);
+	free(scene);
+
+	// Footprints only ever grow by regression, so going over any budget fails the run.
+	FootprintWriteReport(stderr, &startup, &peak);
+
+	for (usize i = 0; i < FOOTPRINT_TOTAL; ++i)
+	{
+		if (!FootprintIsWithinBudget(&peak, i))
+		{
+			fprintf(stderr, "ltlr-bench: %s: over its memory budget\n", FootprintGetName(i));
+			failed = true;
+		}
+	}
+
+	FILE* output = options.output != NULL ? fopen(options.output, "w") : stdout;
+
+	if (output == NULL)
+	{
+		fprintf(stderr, "ltlr-bench: %s: could not be created\n", options.output);
+		return EXIT_FAILURE;
+	}
+
+	PrintBenchmarks(output, benchmarks, total, &options);
+
+	if (output != stdout && fclose(output) != 0)
+	{
+		fprintf(stderr, "ltlr-bench: %s: could not be written\n", options.output);
+		return EXIT_FAILURE;
+	}
+
+	if (options.saveBaseline != NULL)
+	{
+		FILE* saved = fopen(options.saveBaseline, "w");
+
+		if (saved == NULL)
+		{
+			fprintf(stderr, "ltlr-bench: %s: could not be created\n", options.saveBaseline);
+			return EXIT_FAILURE;
+		}
+
+		WriteBaseline(saved, benchmarks, total);
+
+		if (fclose(saved) != 0)
+		{
+			fprintf(stderr, "ltlr-bench: %s: could not be written\n", options.saveBaseline);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (options.curve != NULL)
+	{
+		FILE* curve = fopen(options.curve, "w");
+
+		if (curve == NULL)
+		{
+			fprintf(stderr, "ltlr-bench: %s: could not be created\n", options.curve);
+			return EXIT_FAILURE;
+		}
+
+		PrintCurve(curve, benchmarks + options.pathsLength, options.stressLength);
+
+		if (fclose(curve) != 0)
+		{
+			fprintf(stderr, "ltlr-bench: %s: could not be written\n", options.curve);
+			return EXIT_FAILURE;
+		}
+	}
+
+	for (usize i = 0; i < total; ++i)
+	{
+		free(benchmarks[i].runs);
+	}
+
+	free(benchmarks);
+	free(baseline);
+	free(options.paths);
+	free(options.stress);
+
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,428 @@
+// A stand-in for the handful of raylib functions that the simulation references, so that it can
+// be built and run without a window, a GPU, or GLFW. Input functions report that nothing is
+// pressed (all input comes from InputStreams), and everything that draws does nothing.
+
+#define RAYMATH_IMPLEMENTATION
+
+#include <math.h>
+#include <raylib.h>
+#include <raymath.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+static int logLevel = LOG_INFO;
+
+void SetTraceLogLevel(const int level)
+{
+	logLevel = level;
+}
+
+void TraceLog(const int level, const char* text, ...)
+{
+	if (level < logLevel)
+	{
+		return;
+	}
+
+	va_list args;
+	va_start(args, text);
+
+	vfprintf(stderr, text, args);
+	fputc('\n', stderr);
+
+	va_end(args);
+}
+
+// Unlike raylib's, this starts counting when it is first called rather than when a window opens.
+double GetTime(void)
+{
+	static double start = -1;
+
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	const double now = time.tv_sec + time.tv_nsec * 1e-9;
+
+	if (start < 0)
+	{
+		start = now;
+	}
+
+	return now - start;
+}
+
+// The following must behave exactly like raylib's (see rshapes.c); the simulation depends on them.
+
+bool CheckCollisionRecs(const Rectangle rec1, const Rectangle rec2)
+{
+	return (rec1.x < (rec2.x + rec2.width) && (rec1.x + rec1.width) > rec2.x)
+		&& (rec1.y < (rec2.y + rec2.height) && (rec1.y + rec1.height) > rec2.y);
+}
+
+Rectangle GetCollisionRec(const Rectangle rec1, const Rectangle rec2)
+{
+	Rectangle rec = { 0, 0, 0, 0 };
+
+	if (!CheckCollisionRecs(rec1, rec2))
+	{
+		return rec;
+	}
+
+	const float dxx = fabsf(rec1.x - rec2.x);
+	const float dyy = fabsf(rec1.y - rec2.y);
+
+	if (rec1.x <= rec2.x)
+	{
+		rec.x = rec2.x;
+		rec.width = rec1.width - dxx;
+	}
+	else
+	{
+		rec.x = rec1.x;
+		rec.width = rec2.width - dxx;
+	}
+
+	if (rec1.y <= rec2.y)
+	{
+		rec.y = rec2.y;
+		rec.height = rec1.height - dyy;
+	}
+	else
+	{
+		rec.y = rec1.y;
+		rec.height = rec2.height - dyy;
+	}
+
+	if (rec1.width > rec2.width)
+	{
+		if (rec.width >= rec2.width)
+		{
+			rec.width = rec2.width;
+		}
+	}
+	else
+	{
+		if (rec.width >= rec1.width)
+		{
+			rec.width = rec1.width;
+		}
+	}
+
+	if (rec1.height > rec2.height)
+	{
+		if (rec.height >= rec2.height)
+		{
+			rec.height = rec2.height;
+		}
+	}
+	else
+	{
+		if (rec.height >= rec1.height)
+		{
+			rec.height = rec1.height;
+		}
+	}
+
+	return rec;
+}
+
+// Input.
+
+bool IsKeyDown(const int key)
+{
+	(void)key;
+	return false;
+}
+
+bool IsKeyPressed(const int key)
+{
+	(void)key;
+	return false;
+}
+
+bool IsKeyReleased(const int key)
+{
+	(void)key;
+	return false;
+}
+
+bool IsMouseButtonDown(const int button)
+{
+	(void)button;
+	return false;
+}
+
+bool IsMouseButtonPressed(const int button)
+{
+	(void)button;
+	return false;
+}
+
+bool IsMouseButtonReleased(const int button)
+{
+	(void)button;
+	return false;
+}
+
+bool IsGamepadAvailable(const int gamepad)
+{
+	(void)gamepad;
+	return false;
+}
+
+bool IsGamepadButtonDown(const int gamepad, const int button)
+{
+	(void)gamepad;
+	(void)button;
+	return false;
+}
+
+bool IsGamepadButtonPressed(const int gamepad, const int button)
+{
+	(void)gamepad;
+	(void)button;
+	return false;
+}
+
+bool IsGamepadButtonReleased(const int gamepad, const int button)
+{
+	(void)gamepad;
+	(void)button;
+	return false;
+}
+
+float GetGamepadAxisMovement(const int gamepad, const int axis)
+{
+	(void)gamepad;
+	(void)axis;
+	return 0;
+}
+
+// Window.
+
+int GetCurrentMonitor(void)
+{
+	return 0;
+}
+
+int GetMonitorWidth(const int monitor)
+{
+	(void)monitor;
+	return 0;
+}
+
+int GetMonitorHeight(const int monitor)
+{
+	(void)monitor;
+	return 0;
+}
+
+int GetRenderWidth(void)
+{
+	return 0;
+}
+
+int GetRenderHeight(void)
+{
+	return 0;
+}
+
+Vector2 GetWindowPosition(void)
+{
+	return (Vector2) { 0, 0 };
+}
+
+bool IsWindowFullscreen(void)
+{
+	return false;
+}
+
+void SetWindowPosition(const int x, const int y)
+{
+	(void)x;
+	(void)y;
+}
+
+void SetWindowSize(const int width, const int height)
+{
+	(void)width;
+	(void)height;
+}
+
+void ToggleFullscreen(void)
+{
+}
+
+// Resources.
+
+Texture2D LoadTextureFromImage(const Image image)
+{
+	(void)image;
+	return (Texture2D) { 0 };
+}
+
+void UnloadTexture(const Texture2D texture)
+{
+	(void)texture;
+}
+
+RenderTexture2D LoadRenderTexture(const int width, const int height)
+{
+	(void)width;
+	(void)height;
+	return (RenderTexture2D) { 0 };
+}
+
+void UnloadRenderTexture(const RenderTexture2D target)
+{
+	(void)target;
+}
+
+Shader LoadShaderFromMemory(const char* vsCode, const char* fsCode)
+{
+	(void)vsCode;
+	(void)fsCode;
+	return (Shader) { 0 };
+}
+
+void UnloadShader(const Shader shader)
+{
+	(void)shader;
+}
+
+int GetShaderLocation(const Shader shader, const char* uniformName)
+{
+	(void)shader;
+	(void)uniformName;
+	return -1;
+}
+
+void SetShaderValue(const Shader shader, const int locIndex, const void* value, const int type)
+{
+	(void)shader;
+	(void)locIndex;
+	(void)value;
+	(void)type;
+}
+
+// Drawing.
+
+void BeginDrawing(void)
+{
+}
+
+void EndDrawing(void)
+{
+}
+
+void ClearBackground(const Color color)
+{
+	(void)color;
+}
+
+void BeginMode2D(const Camera2D camera)
+{
+	(void)camera;
+}
+
+void EndMode2D(void)
+{
+}
+
+void BeginTextureMode(const RenderTexture2D target)
+{
+	(void)target;
+}
+
+void EndTextureMode(void)
+{
+}
+
+void BeginShaderMode(const Shader shader)
+{
+	(void)shader;
+}
+
+void EndShaderMode(void)
+{
+}
+
+void BeginBlendMode(const int mode)
+{
+	(void)mode;
+}
+
+void EndBlendMode(void)
+{
+}
+
+void DrawCircleV(const Vector2 center, const float radius, const Color color)
+{
+	(void)center;
+	(void)radius;
+	(void)color;
+}
+
+void DrawPoly(
+	const Vector2 center,
+	const int sides,
+	const float radius,
+	const float rotation,
+	const Color color
+)
+{
+	(void)center;
+	(void)sides;
+	(void)radius;
+	(void)rotation;
+	(void)color;
+}
+
+void DrawRectangle(const int posX, const int posY, const int width, const int height, Color color)
+{
+	(void)posX;
+	(void)posY;
+	(void)width;
+	(void)height;
+	(void)color;
+}
+
+void DrawRectangleRec(const Rectangle rec, const Color color)
+{
+	(void)rec;
+	(void)color;
+}
+
+void DrawRectangleLinesEx(const Rectangle rec, const float lineThick, const Color color)
+{
+	(void)rec;
+	(void)lineThick;
+	(void)color;
+}
+
+void DrawTriangle(const Vector2 v1, const Vector2 v2, const Vector2 v3, const Color color)
+{
+	(void)v1;
+	(void)v2;
+	(void)v3;
+	(void)color;
+}
+
+void DrawTexturePro(
+	const Texture2D texture,
+	const Rectangle source,
+	const Rectangle dest,
+	const Vector2 origin,
+	const float rotation,
+	const Color tint
+)
+{
+	(void)texture;
+	(void)source;
+	(void)dest;
+	(void)origin;
+	(void)rotation;
+	(void)tint;
+}
@@ -0,0 +1,790 @@
+// Runs the simulation without a window, e.g. to check that Replays still play back the same way or
+// to measure how fast the simulation is.
+
+#include "../src/allocations.h"
+#include "../src/common.h"
+#include "../src/context.h"
+#include "../src/counters.h"
+#include "../src/footprint.h"
+#include "../src/replay.h"
+#include "../src/replay_mapping.h"
+#include "../src/scene.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <raylib.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <wyhash.h>
+
+#define REPLAY_EXTENSION ".ltlrr"
+
+typedef enum
+{
+	FORMAT_CSV,
+	FORMAT_JSON,
+} Format;
+
+typedef struct
+{
+	const char* replay;
+	usize frames;
+	bool hash;
+	bool profile;
+	// Where to write every frame's counters as CSV (NULL if they are not wanted).
+	const char* counters;
+	bool footprint;
+	bool noAllocations;
+	bool cosmetics;
+	bool fixedPoint;
+	bool batch;
+	usize jobs;
+	Format format;
+	// Every path (file or directory) given alongside --batch.
+	char** paths;
+	usize pathsLength;
+} Options;
+
+typedef struct
+{
+	const char* path;
+	// NULL if the Replay was simulated successfully.
+	const char* error;
+	usize frames;
+	u32 score;
+	u8 stage;
+	u64 hash;
+	// The duration of the slowest frame (in seconds), and which frame that was; only measured when
+	// profiling.
+	f64 slowestFrame;
+	usize slowestFrameIndex;
+} Simulation;
+
+typedef struct
+{
+	Simulation* simulations;
+	usize simulationsLength;
+	usize frames;
+	bool noAllocations;
+	bool cosmetics;
+	bool fixedPoint;
+	// The index of the next Simulation that has not been claimed by a worker yet.
+	atomic_size_t next;
+} Batch;
+
+static void PrintUsage(void)
+{
+	fprintf(
+		stderr,
+		"usage: ltlr-sim [--replay PATH] [--frames N] [--hash] [--profile] [--counters PATH]\n"
+		"                [--footprint] [--no-allocations] [--cosmetics] [--fixed-point]\n"
+		"       ltlr-sim --batch [--jobs N] [--format csv|json] [--frames N] [--no-allocations]\n"
+		"                [--cosmetics] [--fixed-point] PATH...\n"
+		"\n"
+		"  --replay PATH  play back player-one's input from the given Replay\n"
+		"  --frames N     stop after N frames (defaults to the length of the Replay)\n"
+		"  --hash         print a hash of every simulated frame's state\n"
+		"  --profile      print how long the simulation took\n"
+		"  --counters PATH\n"
+		"                 write every frame's counters (e.g. live entities) to PATH as csv\n"
+		"  --footprint    print how much memory every subsystem held on to at startup and at\n"
+		"                 its peak\n"
+		"  --no-allocations\n"
+		"                 fail if any frame allocates on the heap (other than to build a stage)\n"
+		"  --cosmetics    also simulate visual-only effects (slower; hashes are unaffected); this\n"
+		"                 is always done for Replays older than version 3\n"
+		"  --fixed-point  integrate kinematics with fixed-point numbers, even if the Replay was\n"
+		"                 not recorded that way\n"
+		"  --batch        simulate every given Replay (or every Replay in a given directory)\n"
+		"  --jobs N       simulate N Replays at a time (defaults to the number of cores)\n"
+		"  --format F     print the results of a batch as csv (default) or json\n"
+	);
+}
+
+static bool TryParseCount(const char* text, usize* out)
+{
+	char* end = NULL;
+	*out = strtoull(text, &end, 10);
+
+	return *text != '\0' && *end == '\0';
+}
+
+static bool TryParseOptions(const int argc, char** argv, Options* out)
+{
+	*out = (Options) {
+		.replay = NULL,
+		.frames = 0,
+		.hash = false,
+		.profile = false,
+		.counters = NULL,
+		.footprint = false,
+		.noAllocations = false,
+		.cosmetics = false,
+		.fixedPoint = false,
+		.batch = false,
+		.jobs = 0,
+		.format = FORMAT_CSV,
+		.paths = malloc(sizeof(char*) * argc),
+		.pathsLength = 0,
+	};
+
+	bool hasFrames = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if (strcmp(argv[i], "--replay") == 0 && hasValue)
+		{
+			out->replay = argv[++i];
+		}
+		else if (strcmp(argv[i], "--frames") == 0 && hasValue)
+		{
+			hasFrames = TryParseCount(argv[++i], &out->frames);
+
+			if (!hasFrames)
+			{
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--counters") == 0 && hasValue)
+		{
+			out->counters = argv[++i];
+		}
+		else if (strcmp(argv[i], "--jobs") == 0 && hasValue)
+		{
+			if (!TryParseCount(argv[++i], &out->jobs) || out->jobs == 0)
+			{
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--format") == 0 && hasValue)
+		{
+			const char* format = argv[++i];
+
+			if (strcmp(format, "csv") == 0)
+			{
+				out->format = FORMAT_CSV;
+			}
+			else if (strcmp(format, "json") == 0)
+			{
+				out->format = FORMAT_JSON;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--hash") == 0)
+		{
+			out->hash = true;
+		}
+		else if (strcmp(argv[i], "--profile") == 0)
+		{
+			out->profile = true;
+		}
+		else if (strcmp(argv[i], "--footprint") == 0)
+		{
+			out->footprint = true;
+		}
+		else if (strcmp(argv[i], "--no-allocations") == 0)
+		{
+			out->noAllocations = true;
+		}
+		else if (strcmp(argv[i], "--cosmetics") == 0)
+		{
+			out->cosmetics = true;
+		}
+		else if (strcmp(argv[i], "--fixed-point") == 0)
+		{
+			out->fixedPoint = true;
+		}
+		else if (strcmp(argv[i], "--batch") == 0)
+		{
+			out->batch = true;
+		}
+		else if (argv[i][0] != '-')
+		{
+			out->paths[out->pathsLength] = argv[i];
+			out->pathsLength += 1;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	if (out->batch)
+	{
+		return out->replay == NULL && out->counters == NULL && !out->footprint
+			   && out->pathsLength > 0;
+	}
+
+	if (out->pathsLength > 0)
+	{
+		return false;
+	}
+
+	// Without a Replay there is nothing to decide how long to run for.
+	return out->replay != NULL || hasFrames;
+}
+
+static f64 Now(void)
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+// Whether the given entity only exists to be looked at (see Scene.cosmeticsEnabled).
+static bool IsCosmetic(const Scene* self, const usize entity)
+{
+	return SceneEntityIs(self, entity, ENTITY_TYPE_CLOUD_PARTICLE)
+		|| SceneEntityIs(self, entity, ENTITY_TYPE_FOG_PARTICLE)
+		|| SceneEntityIs(self, entity, ENTITY_TYPE_PLAYER_SHADOW);
+}
+
+// Only gameplay state is hashed, so the result is the same whether or not cosmetics are enabled.
+static u64 HashScene(const Scene* self, const u64 seed)
+{
+	u64 hash = seed;
+
+	const usize total = SceneGetTotalAllocatedEntities(self);
+
+	for (usize i = 0; i < total; ++i)
+	{
+		if (self->components.tags[i] == TAG_NONE || IsCosmetic(self, i))
+		{
+			continue;
+		}
+
+		const u64 tags = self->components.tags[i] & ~TAG_ANIMATION;
+
+		hash = wyhash(&tags, sizeof(tags), hash, _wyp);
+
+		if ((tags & TAG_POSITION) != 0)
+		{
+			const Vector2 position = self->components.positions[i].value;
+
+			hash = wyhash(&position, sizeof(position), hash, _wyp);
+		}
+	}
+
+	hash = wyhash(&self->score, sizeof(self->score), hash, _wyp);
+	hash = wyhash(&self->stage, sizeof(self->stage), hash, _wyp);
+
+	return hash;
+}
+
+// Restarts the given scene and plays back the Replay at the given path (if any) with any extra
+// ReplayFlags given. Every frame's counters are written to `counters` as CSV rows (unless it is
+// NULL), and `peak` is raised to every frame's Footprint (unless it is NULL). With
+// `noAllocations`, the simulation fails as soon as a frame that did not build a stage allocates on
+// the heap. Scenes are meant to be reused between simulations rather than initialized every time.
+static Simulation Simulate(
+	Scene* scene,
+	const char* path,
+	const u8 extraFlags,
+	const usize maxFrames,
+	const bool hash,
+	const bool profile,
+	FILE* counters,
+	Footprint* peak,
+	const bool noAllocations
+)
+{
+	Simulation simulation = {
+		.path = path,
+		.error = NULL,
+		.frames = maxFrames,
+		.score = 0,
+		.stage = 0,
+		.hash = 0,
+		.slowestFrame = 0,
+		.slowestFrameIndex = 0,
+	};
+
+	ReplayMapping mapping = { 0 };
+	u32 seed = MAGIC_NUMBER;
+	u8 flags = REPLAY_FLAGS_CURRENT;
+
+	if (path != NULL)
+	{
+		const ReplayMappingResult result = ReplayMappingTryOpen(path);
+
+		if (result.type == REPLAY_RESULT_TYPE_ERR)
+		{
+			simulation.error = StringFromReplayError(result.contents.err);
+			return simulation;
+		}
+
+		mapping = result.contents.ok;
+
+		// Play the Replay back in place rather than copying it into the scene's InputStream.
+		SceneStartPlayback(scene, &mapping.replay);
+
+		if (simulation.frames == 0 || simulation.frames > mapping.replay.length)
+		{
+			simulation.frames = mapping.replay.length;
+		}
+
+		seed = mapping.replay.seed;
+		flags = mapping.replay.flags;
+	}
+
+	SceneReseed(scene, seed, flags | extraFlags);
+
+	simulation.hash = seed;
+
+	// Whatever was counted while setting up is not part of any frame.
+	CountersSample();
+
+	AllocationSite sites[ALLOCATIONS_MAX_SITES];
+	AllocationsTakeSites(sites);
+
+	for (usize i = 0; i < simulation.frames; ++i)
+	{
+		const f64 frameStart = profile ? Now() : 0;
+
+		SceneUpdate(scene);
+
+		if (profile)
+		{
+			const f64 duration = Now() - frameStart;
+
+			if (duration > simulation.slowestFrame)
+			{
+				simulation.slowestFrame = duration;
+				simulation.slowestFrameIndex = i;
+			}
+		}
+
+		const CounterSample sample = CountersSample();
+		const usize sitesLength = AllocationsTakeSites(sites);
+
+		if (counters != NULL)
+		{
+			CountersWriteCsvRow(counters, i, &sample);
+		}
+
+		if (peak != NULL)
+		{
+			const Footprint footprint = FootprintMeasure(scene);
+			FootprintRaise(peak, &footprint);
+		}
+
+		if (noAllocations && sample.values[COUNTER_STAGE_BUILDS] == 0
+			&& sample.values[COUNTER_HEAP_ALLOCATIONS] != 0)
+		{
+			for (usize j = 0; j < sitesLength; ++j)
+			{
+				char buffer[64];
+
+				fprintf(
+					stderr,
+					"ltlr-sim: %s: frame %zu: %lld allocation(s) at %s\n",
+					path != NULL ? path : "(no replay)",
+					i,
+					(long long)sites[j].count,
+					AllocationsDescribeSite(&sites[j], buffer, sizeof(buffer))
+				);
+			}
+
+			simulation.error = "allocated on the heap outside of building a stage";
+			simulation.frames = i + 1;
+			break;
+		}
+
+		if (hash)
+		{
+			simulation.hash = HashScene(scene, simulation.hash);
+		}
+	}
+
+	simulation.score = scene->score;
+	simulation.stage = scene->stage;
+
+	if (path != NULL)
+	{
+		// The scene must not hold on to the Replay once it is unmapped.
+		SceneStopPlayback(scene);
+		ReplayMappingDestroy(&mapping);
+	}
+
+	return simulation;
+}
+
+static int RunSingle(const Options* options)
+{
+	FILE* counters = NULL;
+
+	if (options->counters != NULL)
+	{
+		counters = fopen(options->counters, "w");
+
+		if (counters == NULL)
+		{
+			fprintf(stderr, "ltlr-sim: %s: could not be created\n", options->counters);
+			return EXIT_FAILURE;
+		}
+
+		CountersWriteCsvHeader(counters);
+	}
+
+	Scene* scene = calloc(1, sizeof(Scene));
+	SceneInit(scene);
+	scene->cosmeticsEnabled = options->cosmetics;
+
+	const Footprint startup = FootprintMeasure(scene);
+	Footprint peak = startup;
+
+	const f64 start = Now();
+
+	const Simulation simulation = Simulate(
+		scene,
+		options->replay,
+		options->fixedPoint ? REPLAY_FLAG_FIXED_POINT : 0,
+		options->frames,
+		options->hash,
+		options->profile,
+		counters,
+		options->footprint ? &peak : NULL,
+		options->noAllocations
+	);
+
+	const f64 elapsed = Now() - start;
+
+	SceneDestroy(scene);
+	free(scene);
+
+	if (counters != NULL && fclose(counters) != 0)
+	{
+		fprintf(stderr, "ltlr-sim: %s: could not be written\n", options->counters);
+		return EXIT_FAILURE;
+	}
+
+	if (simulation.error != NULL)
+	{
+		fprintf(stderr, "ltlr-sim: %s: %s\n", simulation.path, simulation.error);
+		return EXIT_FAILURE;
+	}
+
+	printf("frames: %zu\n", simulation.frames);
+
+	if (options->hash)
+	{
+		printf("hash: %016llx\n", (unsigned long long)simulation.hash);
+	}
+
+	if (options->profile)
+	{
+		printf(
+			"time: %.3f ms (%.0f frames/s; %.4f ms per frame on average, %.4f ms at most on frame "
+			"%zu)\n",
+			elapsed * 1e3,
+			simulation.frames / elapsed,
+			(elapsed * 1e3) / MAX(simulation.frames, 1),
+			simulation.slowestFrame * 1e3,
+			simulation.slowestFrameIndex
+		);
+	}
+
+	if (options->footprint)
+	{
+		FootprintWriteReport(stdout, &startup, &peak);
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static bool HasReplayExtension(const char* name)
+{
+	const usize length = strlen(name);
+	const usize extensionLength = strlen(REPLAY_EXTENSION);
+
+	return length > extensionLength
+		&& strcmp(name + length - extensionLength, REPLAY_EXTENSION) == 0;
+}
+
+static int ComparePaths(const void* a, const void* b)
+{
+	return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+typedef struct
+{
+	char** items;
+	usize length;
+	usize capacity;
+} Paths;
+
+static void PathsPush(Paths* self, char* path)
+{
+	if (self->length >= self->capacity)
+	{
+		self->capacity = MAX(self->capacity * 2, 16);
+		self->items = realloc(self->items, sizeof(char*) * self->capacity);
+	}
+
+	self->items[self->length] = path;
+	self->length += 1;
+}
+
+// Expands every directory into the Replays it contains (sorted by name).
+static Paths CollectPaths(char** paths, const usize pathsLength)
+{
+	Paths result = { NULL, 0, 0 };
+
+	for (usize i = 0; i < pathsLength; ++i)
+	{
+		DIR* directory = opendir(paths[i]);
+
+		if (directory == NULL)
+		{
+			PathsPush(&result, strdup(paths[i]));
+			continue;
+		}
+
+		const usize start = result.length;
+
+		for (struct dirent* entry = readdir(directory); entry != NULL; entry = readdir(directory))
+		{
+			if (!HasReplayExtension(entry->d_name))
+			{
+				continue;
+			}
+
+			const usize size = strlen(paths[i]) + 1 + strlen(entry->d_name) + 1;
+			char* path = malloc(size);
+			snprintf(path, size, "%s/%s", paths[i], entry->d_name);
+
+			PathsPush(&result, path);
+		}
+
+		closedir(directory);
+
+		qsort(result.items + start, result.length - start, sizeof(char*), ComparePaths);
+	}
+
+	return result;
+}
+
+static void* BatchWorker(void* arg)
+{
+	Batch* batch = arg;
+
+	// Every worker gets one Scene for all of its Replays.
+	Scene* scene = calloc(1, sizeof(Scene));
+	SceneInit(scene);
+	scene->cosmeticsEnabled = batch->cosmetics;
+
+	const u8 extraFlags = batch->fixedPoint ? REPLAY_FLAG_FIXED_POINT : 0;
+
+	while (true)
+	{
+		const usize i = atomic_fetch_add_explicit(&batch->next, 1, memory_order_relaxed);
+
+		if (i >= batch->simulationsLength)
+		{
+			break;
+		}
+
+		Simulation* simulation = &batch->simulations[i];
+		*simulation = Simulate(
+			scene,
+			simulation->path,
+			extraFlags,
+			batch->frames,
+			true,
+			false,
+			NULL,
+			NULL,
+			batch->noAllocations
+		);
+	}
+
+	SceneDestroy(scene);
+	free(scene);
+
+	return NULL;
+}
+
+static void PrintJsonString(const char* text)
+{
+	putchar('"');
+
+	for (const char* c = text; *c != '\0'; ++c)
+	{
+		if (*c == '"' || *c == '\\')
+		{
+			putchar('\\');
+		}
+
+		putchar(*c);
+	}
+
+	putchar('"');
+}
+
+static void PrintSimulations(const Simulation* simulations, const usize length, const Format format)
+{
+	if (format == FORMAT_CSV)
+	{
+		printf("replay,frames,stage,score,hash,error\n");
+
+		for (usize i = 0; i < length; ++i)
+		{
+			const Simulation* simulation = &simulations[i];
+
+			printf(
+				"%s,%zu,%u,%u,%016llx,%s\n",
+				simulation->path,
+				simulation->frames,
+				simulation->stage,
+				simulation->score,
+				(unsigned long long)simulation->hash,
+				simulation->error != NULL ? simulation->error : ""
+			);
+		}
+
+		return;
+	}
+
+	printf("[\n");
+
+	for (usize i = 0; i < length; ++i)
+	{
+		const Simulation* simulation = &simulations[i];
+
+		printf("  {\"replay\": ");
+		PrintJsonString(simulation->path);
+		printf(
+			", \"frames\": %zu, \"stage\": %u, \"score\": %u, \"hash\": \"%016llx\", \"error\": ",
+			simulation->frames,
+			simulation->stage,
+			simulation->score,
+			(unsigned long long)simulation->hash
+		);
+
+		if (simulation->error != NULL)
+		{
+			PrintJsonString(simulation->error);
+		}
+		else
+		{
+			printf("null");
+		}
+
+		printf("}%s\n", i + 1 < length ? "," : "");
+	}
+
+	printf("]\n");
+}
+
+static int RunBatch(const Options* options)
+{
+	Paths paths = CollectPaths(options->paths, options->pathsLength);
+	const usize total = paths.length;
+
+	Batch batch = {
+		.simulations = calloc(MAX(total, 1), sizeof(Simulation)),
+		.simulationsLength = total,
+		.frames = options->frames,
+		.noAllocations = options->noAllocations,
+		.cosmetics = options->cosmetics,
+		.fixedPoint = options->fixedPoint,
+	};
+
+	atomic_init(&batch.next, 0);
+
+	for (usize i = 0; i < total; ++i)
+	{
+		batch.simulations[i].path = paths.items[i];
+	}
+
+	usize jobs = options->jobs;
+
+	if (jobs == 0)
+	{
+		const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+		jobs = cores > 0 ? (usize)cores : 1;
+	}
+
+	jobs = MAX(MIN(jobs, total), 1);
+
+	pthread_t* workers = malloc(sizeof(pthread_t) * jobs);
+
+	const f64 start = Now();
+
+	for (usize i = 0; i < jobs; ++i)
+	{
+		pthread_create(&workers[i], NULL, BatchWorker, &batch);
+	}
+
+	for (usize i = 0; i < jobs; ++i)
+	{
+		pthread_join(workers[i], NULL);
+	}
+
+	const f64 elapsed = Now() - start;
+
+	PrintSimulations(batch.simulations, total, options->format);
+
+	usize frames = 0;
+	usize failures = 0;
+
+	for (usize i = 0; i < total; ++i)
+	{
+		frames += batch.simulations[i].frames;
+		failures += batch.simulations[i].error != NULL ? 1 : 0;
+	}
+
+	fprintf(
+		stderr,
+		"ltlr-sim: %zu replays (%zu frames) in %.3f s on %zu workers: %.1f replays/s, %.0f "
+		"frames/s\n",
+		total,
+		frames,
+		elapsed,
+		jobs,
+		total / elapsed,
+		frames / elapsed
+	);
+
+	for (usize i = 0; i < total; ++i)
+	{
+		free(paths.items[i]);
+	}
+
+	free(paths.items);
+	free(batch.simulations);
+	free(workers);
+
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(const int argc, char** argv)
+{
+	Options options;
+
+	if (!TryParseOptions(argc, argv, &options))
+	{
+		PrintUsage();
+		free(options.paths);
+		return EXIT_FAILURE;
+	}
+
+	SetTraceLogLevel(LOG_WARNING);
+
+	const int status = options.batch ? RunBatch(&options) : RunSingle(&options);
+
+	free(options.paths);
+
+	return status;
+}
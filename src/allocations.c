@@ -0,0 +1,128 @@
+#if defined(ALLOCATIONS_INTERPOSE)
+	// For dladdr.
+	#define _GNU_SOURCE
+	#include <dlfcn.h>
+#endif
+
+#include "allocations.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+static _Thread_local AllocationSite sites[ALLOCATIONS_MAX_SITES];
+static _Thread_local usize sitesLength;
+
+static bool SiteMatches(const AllocationSite* self, const char* site, const void* caller)
+{
+	if (self->caller != caller)
+	{
+		return false;
+	}
+
+	// Sites are always string literals, so comparing pointers is usually enough.
+	return self->site == site
+		   || (self->site != NULL && site != NULL && strcmp(self->site, site) == 0);
+}
+
+static void RecordSite(const char* site, const void* caller)
+{
+	for (usize i = 0; i < sitesLength; ++i)
+	{
+		if (SiteMatches(&sites[i], site, caller))
+		{
+			sites[i].count += 1;
+			return;
+		}
+	}
+
+	if (sitesLength < ALLOCATIONS_MAX_SITES)
+	{
+		sites[sitesLength] = (AllocationSite) {
+			.site = site,
+			.caller = caller,
+			.count = 1,
+		};
+		sitesLength += 1;
+	}
+}
+
+void AllocationsRecord(const char* site)
+{
+#if !defined(ALLOCATIONS_INTERPOSE)
+	// Otherwise the allocation itself is counted by __wrap_malloc and friends.
+	CounterAdd(COUNTER_HEAP_ALLOCATIONS, 1);
+#endif
+
+	RecordSite(site, NULL);
+}
+
+usize AllocationsTakeSites(AllocationSite* out)
+{
+	const usize length = sitesLength;
+
+	memcpy(out, sites, sizeof(AllocationSite) * length);
+	sitesLength = 0;
+
+	return length;
+}
+
+const char* AllocationsDescribeSite(const AllocationSite* site, char* buffer, const usize size)
+{
+	if (site->caller == NULL)
+	{
+		return site->site;
+	}
+
+#if defined(ALLOCATIONS_INTERPOSE)
+	Dl_info info;
+
+	if (dladdr(site->caller, &info) != 0 && info.dli_fname != NULL)
+	{
+		const char* name = strrchr(info.dli_fname, '/');
+		const usize offset = (const char*)site->caller - (const char*)info.dli_fbase;
+
+		snprintf(buffer, size, "%s+0x%zx", name != NULL ? name + 1 : info.dli_fname, offset);
+		return buffer;
+	}
+#endif
+
+	snprintf(buffer, size, "%p", site->caller);
+	return buffer;
+}
+
+#if defined(ALLOCATIONS_INTERPOSE)
+
+// Only exist when linking with --wrap; see TRACK_ALLOCATION.
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+
+static void RecordCaller(const void* caller)
+{
+	CounterAdd(COUNTER_HEAP_ALLOCATIONS, 1);
+	RecordSite(NULL, caller);
+}
+
+void* __wrap_malloc(const size_t size)
+{
+	RecordCaller(__builtin_return_address(0));
+
+	return __real_malloc(size);
+}
+
+void* __wrap_calloc(const size_t count, const size_t size)
+{
+	RecordCaller(__builtin_return_address(0));
+
+	return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pointer, const size_t size)
+{
+	RecordCaller(__builtin_return_address(0));
+
+	return __real_realloc(pointer, size);
+}
+
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "counters.h"
+
+// How many distinct call sites are told apart per thread; any others are only counted.
+#define ALLOCATIONS_MAX_SITES (32)
+
+#define ALLOCATIONS_STRINGIFY(mValue) #mValue
+#define ALLOCATIONS_SITE(mFile, mLine) mFile ":" ALLOCATIONS_STRINGIFY(mLine)
+
+// Counts a heap allocation (see COUNTER_HEAP_ALLOCATIONS) and attributes it to the line it is
+// written on. Use this right next to every malloc that can happen once the game is running; it only
+// costs anything when an allocation actually happens.
+//
+// Builds that define ALLOCATIONS_INTERPOSE (and link with -Wl,--wrap=malloc,--wrap=calloc,
+// --wrap=realloc, like ltlr-sim and ltlr-bench) count every allocation the game makes instead,
+// annotated or not, and attribute it to whatever called malloc. TRACK_ALLOCATION then only adds
+// which line (or which Deque) that was on behalf of.
+#define TRACK_ALLOCATION() AllocationsRecord(ALLOCATIONS_SITE(__FILE__, __LINE__))
+
+typedef struct
+{
+	// The file and line that allocated (or that created the Deque that did), e.g. "src/scene.c:42";
+	// NULL if the allocation was only caught by interposing malloc.
+	const char* site;
+	// The code that called malloc, calloc, or realloc; NULL unless the allocation was caught by
+	// interposing malloc.
+	const void* caller;
+	i64 count;
+} AllocationSite;
+
+// Prefer TRACK_ALLOCATION over calling this directly.
+void AllocationsRecord(const char* site);
+// Copies every site the calling thread has allocated from since the last call into `out` (which
+// has room for ALLOCATIONS_MAX_SITES), returns how many there were, and starts over.
+usize AllocationsTakeSites(AllocationSite* out);
+// Describes where the given site is (e.g. "src/scene.c:42" or "ltlr-sim+0x1f2a3", which addr2line
+// can make sense of) using the given buffer if needed.
+const char* AllocationsDescribeSite(const AllocationSite* site, char* buffer, usize size);
@@ -1,6 +1,7 @@
 #include "atlas.h"
 
 #include "common.h"
+#include "counters.h"
 
 #include <raylib.h>
 #include <stdlib.h>
@@ -46,6 +47,7 @@ void AtlasDraw(const Atlas* self, const AtlasDrawParams* params)
 	};
 
 	DrawTexturePro(self->texture, source, destination, VECTOR2_ZERO, 0, params->tint);
+	CounterAdd(COUNTER_ATLAS_DRAWS, 1);
 }
 
 void AtlasDestroy(Atlas* self)
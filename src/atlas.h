@@ -5,6 +5,10 @@
 
 #include <raylib.h>
 
+// The dimensions of content/atlas.png.
+#define ATLAS_WIDTH (512)
+#define ATLAS_HEIGHT (512)
+
 typedef struct
 {
 	u16 width;
@@ -35,6 +39,7 @@ typedef struct
 	Color tint;
 } AtlasDrawParams;
 
-Atlas AtlasCreate(const char* path);
+// Uploads an already decoded image of the atlas (see content/atlas.png) to the GPU.
+Atlas AtlasCreate(const Image* image);
 void AtlasDraw(const Atlas* self, const AtlasDrawParams* params);
 void AtlasDestroy(Atlas* self);
@@ -7,12 +7,12 @@
 #include <raylib.h>
 #include <stdlib.h>
 
-Atlas AtlasCreate(const char* path)
+Atlas AtlasCreate(const Image* image)
 {
 	static const usize length = 179;
 
 	Atlas atlas = (Atlas) {
-		.texture = LoadTexture(path),
+		.texture = LoadTextureFromImage(*image),
 		.entries = malloc(sizeof(AtlasEntry) * length),
 		.entriesLength = length,
 	};
@@ -33,3 +33,39 @@ u32 U32FromBigEndian(const u32 self)
 
 	return U32SwapBytes(self);
 }
+
+usize U64ToVarint(const u64 self, u8* out)
+{
+	u64 remaining = self;
+	usize written = 0;
+
+	while (remaining >= 0x80)
+	{
+		out[written] = (u8)(remaining & 0x7F) | 0x80;
+		remaining >>= 7;
+		written += 1;
+	}
+
+	out[written] = (u8)remaining;
+
+	return written + 1;
+}
+
+usize U64FromVarint(const u8* data, const usize size, u64* out)
+{
+	u64 value = 0;
+
+	for (usize i = 0; i < size && i < VARINT_MAX_SIZE; ++i)
+	{
+		value |= (u64)(data[i] & 0x7F) << (7 * i);
+
+		if ((data[i] & 0x80) == 0)
+		{
+			*out = value;
+
+			return i + 1;
+		}
+	}
+
+	return 0;
+}
@@ -1,9 +1,21 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
+typedef uint8_t u8;
 typedef uint32_t u32;
+typedef uint64_t u64;
+typedef size_t usize;
+
+// The maximum number of bytes a u64 can occupy when encoded as a varint.
+#define VARINT_MAX_SIZE (10)
 
 u32 U32SwapBytes(u32 self);
 u32 U32ToBigEndian(u32 self);
 u32 U32FromBigEndian(u32 self);
+
+// Writes a given u64 as a LEB128 varint and returns the amount of bytes written.
+usize U64ToVarint(u64 self, u8* out);
+// Reads a LEB128 varint and returns the amount of bytes read (zero if the varint is malformed).
+usize U64FromVarint(const u8* data, usize size, u64* out);
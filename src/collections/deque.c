@@ -1,5 +1,8 @@
 #include "deque.h"
 
+#include "../allocations.h"
+#include "../counters.h"
+
 #include <assert.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -32,6 +35,8 @@ static void Resize(Deque* self)
 
 	const size_t newCapacity = (size_t)(self->m_capacity * DEQUE_RESIZE_FACTOR);
 	uint8_t* newData = malloc(self->m_dataSize * newCapacity);
+	CounterAdd(COUNTER_DEQUE_RESIZES, 1);
+	AllocationsRecord(self->m_site);
 
 	self->m_data = newData;
 	self->m_capacity = newCapacity;
@@ -46,8 +51,14 @@ static void Resize(Deque* self)
 }
 
 Deque DequeCreate(const size_t dataSize, const size_t initialCapacity)
+{
+	return DequeCreateAt(dataSize, initialCapacity, ALLOCATIONS_SITE(__FILE__, __LINE__));
+}
+
+Deque DequeCreateAt(const size_t dataSize, const size_t initialCapacity, const char* site)
 {
 	void* data = malloc(dataSize * initialCapacity);
+	AllocationsRecord(site);
 
 	return (Deque) {
 		.m_data = data,
@@ -56,6 +67,7 @@ Deque DequeCreate(const size_t dataSize, const size_t initialCapacity)
 		.m_headIndex = 0,
 		.m_tailIndex = initialCapacity - 1,
 		.m_needsResize = false,
+		.m_site = site,
 	};
 }
 
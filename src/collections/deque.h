@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../allocations.h"
+
 #include <stdbool.h>
 #include <stdlib.h>
 
@@ -17,9 +19,13 @@ typedef struct
 	size_t m_tailIndex;
 	// True if the Deque's internal array is full.
 	bool m_needsResize;
+	// Where the Deque was created; any allocation it makes is attributed to that call site.
+	const char* m_site;
 } Deque;
 
 Deque DequeCreate(size_t dataSize, size_t initialCapacity);
+// Prefer DEQUE_OF or DEQUE_WITH_CAPACITY, which pass in their own call site.
+Deque DequeCreateAt(size_t dataSize, size_t initialCapacity, const char* site);
 void DequePushFront(Deque* self, const void* valuePointer);
 void DequePushBack(Deque* self, const void* valuePointer);
 void* DequePopFront(Deque* self);
@@ -34,8 +40,9 @@ size_t DequeGetSize(const Deque* self);
 void DequeClear(Deque* self);
 void DequeDestroy(Deque* self);
 
-#define DEQUE_OF(mType) DequeCreate(sizeof(mType), 16)
-#define DEQUE_WITH_CAPACITY(mType, mCapacity) DequeCreate(sizeof(mType), mCapacity)
+#define DEQUE_OF(mType) DequeCreateAt(sizeof(mType), 16, ALLOCATIONS_SITE(__FILE__, __LINE__))
+#define DEQUE_WITH_CAPACITY(mType, mCapacity) \
+	DequeCreateAt(sizeof(mType), mCapacity, ALLOCATIONS_SITE(__FILE__, __LINE__))
 #define DEQUE_PUSH_FRONT(mDequePtr, mType, mValue) \
 	do \
 	{ \
@@ -14,8 +14,10 @@
 #define DEFAULT_WINDOW_WIDTH (CTX_VIEWPORT_WIDTH * 4)
 #define DEFAULT_WINDOW_HEIGHT (CTX_VIEWPORT_HEIGHT * 4)
 
+// Target (fixed) update rate.
+#define CTX_FPS (60)
 // Target (fixed) delta time.
-#define CTX_DT (1.0 / 60.0)
+#define CTX_DT (1.0 / CTX_FPS)
 
 typedef struct
 {
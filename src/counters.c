@@ -0,0 +1,75 @@
+#include "counters.h"
+
+#include <string.h>
+
+// Names double as CSV column names, so they are kept short and free of commas.
+static const char* names[COUNTER_TOTAL] = {
+	[COUNTER_LIVE_ENTITIES] = "live_entities",
+	[COUNTER_ENTITY_HIGH_WATER_MARK] = "entity_high_water_mark",
+	[COUNTER_DEFERRED_COMMANDS] = "deferred_commands",
+	[COUNTER_ARENA_BYTES] = "arena_bytes",
+	[COUNTER_COLLISION_TESTS] = "collision_tests",
+	[COUNTER_RESOLUTIONS] = "resolutions",
+	[COUNTER_ATLAS_DRAWS] = "atlas_draws",
+	[COUNTER_DEQUE_RESIZES] = "deque_resizes",
+	[COUNTER_HEAP_ALLOCATIONS] = "heap_allocations",
+	[COUNTER_STAGE_BUILDS] = "stage_builds",
+};
+
+static _Thread_local i64 values[COUNTER_TOTAL];
+
+const char* CounterGetName(const Counter counter)
+{
+	return names[counter];
+}
+
+void CounterAdd(const Counter counter, const i64 amount)
+{
+	values[counter] += amount;
+}
+
+void CounterSet(const Counter counter, const i64 value)
+{
+	values[counter] = value;
+}
+
+void CounterRaise(const Counter counter, const i64 value)
+{
+	if (value > values[counter])
+	{
+		values[counter] = value;
+	}
+}
+
+CounterSample CountersSample(void)
+{
+	CounterSample sample;
+	memcpy(sample.values, values, sizeof(values));
+	memset(values, 0, sizeof(values));
+
+	return sample;
+}
+
+void CountersWriteCsvHeader(FILE* file)
+{
+	fputs("frame", file);
+
+	for (usize i = 0; i < COUNTER_TOTAL; ++i)
+	{
+		fprintf(file, ",%s", names[i]);
+	}
+
+	fputc('\n', file);
+}
+
+void CountersWriteCsvRow(FILE* file, const usize frame, const CounterSample* sample)
+{
+	fprintf(file, "%zu", frame);
+
+	for (usize i = 0; i < COUNTER_TOTAL; ++i)
+	{
+		fprintf(file, ",%lld", (long long)sample->values[i]);
+	}
+
+	fputc('\n', file);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef int64_t i64;
+typedef size_t usize;
+
+// Numbers that are sampled once per frame to see how much work the game does (and how much room
+// it needs) over time, e.g. to size MAX_ENTITIES and the scene's arena from real distributions.
+typedef enum
+{
+	// How many entities are alive at the end of the frame.
+	COUNTER_LIVE_ENTITIES,
+	// How many entity slots have ever been used since the stage was built (see MAX_ENTITIES).
+	COUNTER_ENTITY_HIGH_WATER_MARK,
+	COUNTER_DEFERRED_COMMANDS,
+	// The most bytes the scene's arena held at once.
+	COUNTER_ARENA_BYTES,
+	// How many pairs of colliders were checked for overlap.
+	COUNTER_COLLISION_TESTS,
+	COUNTER_RESOLUTIONS,
+	COUNTER_ATLAS_DRAWS,
+	COUNTER_DEQUE_RESIZES,
+	// Heap allocations made while the game runs (see TRACK_ALLOCATION).
+	COUNTER_HEAP_ALLOCATIONS,
+	// Building a stage is allowed to allocate; the rest of the game should not need to.
+	COUNTER_STAGE_BUILDS,
+	COUNTER_TOTAL,
+} Counter;
+
+typedef struct
+{
+	i64 values[COUNTER_TOTAL];
+} CounterSample;
+
+// Counters are kept per thread (so counting never needs to synchronize), and only the calling
+// thread's counters are ever read or changed.
+
+const char* CounterGetName(Counter counter);
+void CounterAdd(Counter counter, i64 amount);
+void CounterSet(Counter counter, i64 value);
+// Sets the counter to the given value if it is larger than the current one.
+void CounterRaise(Counter counter, i64 value);
+
+// Returns every counter's value for the frame that just ended, and starts the next frame with
+// every counter at zero.
+CounterSample CountersSample(void);
+
+// Writes a CSV header row (a frame column followed by one column per counter).
+void CountersWriteCsvHeader(FILE* file);
+void CountersWriteCsvRow(FILE* file, usize frame, const CounterSample* sample);
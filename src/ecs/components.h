@@ -220,3 +220,16 @@ typedef struct
 	f32 trailTimer;
 	f32 velocityLastFrame;
 } Player;
+
+#define FOG_LUMP_TOTAL (8)
+
+typedef struct
+{
+	f32 lumpRadii[FOG_LUMP_TOTAL];
+	f32 lumpTargetRadii[FOG_LUMP_TOTAL];
+	f32 breathingPhaseTimer;
+	u8 breathingPhase;
+	f32 movingParticleSpawnTimer;
+	bool decelerationTimerEnabled;
+	f32 decelerationTimer;
+} FogState;
@@ -1,6 +1,7 @@
 #include "battery.h"
 
 #include "../../common.h"
+#include "../../fixed.h"
 #include "../../scene.h"
 #include "../../sprites_generated.h"
 #include "../components.h"
@@ -88,5 +89,8 @@ void BatteryUpdate(Scene* scene, const usize entity)
 
 	CKinetic* kinetic = &scene->components.kinetics[entity];
 
-	kinetic->velocity.y = sinf(SceneGetElapsedTime(scene) * 3.0F) * 10.0F;
+	const f64 phase = SceneGetElapsedTime(scene) * 3.0F;
+	const f32 wave = SceneUsesFixedPoint(scene) ? FixedSin(phase) : sinf(phase);
+
+	kinetic->velocity.y = wave * 10.0F;
 }
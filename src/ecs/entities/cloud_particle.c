@@ -75,7 +75,7 @@ void CloudParticleBuild(Scene* scene, const void* params)
 	CloudParticleBuildHelper(scene, params);
 }
 
-void CloudParticleDraw(const Scene* scene, const usize entity)
+void CloudParticleSnapshot(const Scene* scene, const usize entity, RenderSnapshot* snapshot)
 {
 	// clang-format off
 	static const u64 dependencies =
@@ -92,6 +92,8 @@ void CloudParticleDraw(const Scene* scene, const usize entity)
 		return;
 	}
 
+	assert(snapshot->cloudParticlesLength + snapshot->fogParticlesLength < MAX_ENTITIES);
+
 	const CPosition* position = &scene->components.positions[entity];
 	const CFleeting* fleeting = &scene->components.fleetings[entity];
 	const CDimension* dimension = &scene->components.dimensions[entity];
@@ -100,12 +102,18 @@ void CloudParticleDraw(const Scene* scene, const usize entity)
 	const f32 drawSize =
 		dimension->width * (fleeting->lifetime - fleeting->age) / fleeting->lifetime;
 
-	const Vector2 interpolated = Vector2Lerp(smooth->previous, position->value, ContextGetAlpha());
-
-	const Vector2 center = (Vector2) {
-		.x = interpolated.x + (dimension->width * 0.5F),
-		.y = interpolated.y + (dimension->height * 0.5F),
+	const Vector2 offset = (Vector2) {
+		.x = dimension->width * 0.5F,
+		.y = dimension->height * 0.5F,
 	};
 
-	DrawPoly(center, 6, drawSize * 0.5F, 0, COLOR_WHITE);
+	snapshot->polygons[snapshot->cloudParticlesLength] = (RenderPolygon) {
+		.previous = Vector2Add(smooth->previous, offset),
+		.center = Vector2Add(position->value, offset),
+		.radius = drawSize * 0.5F,
+		.rotation = 0,
+		.sides = 6,
+		.color = COLOR_WHITE,
+	};
+	snapshot->cloudParticlesLength += 1;
 }
@@ -5,6 +5,8 @@
 
 #include <raylib.h>
 
+typedef struct RenderSnapshot RenderSnapshot;
+
 typedef struct
 {
 	usize entity;
@@ -17,4 +19,4 @@ typedef struct
 
 void CloudParticleBuild(Scene* scene, const void* params);
 
-void CloudParticleDraw(const Scene* scene, usize entity);
+void CloudParticleSnapshot(const Scene* scene, usize entity, RenderSnapshot* snapshot);
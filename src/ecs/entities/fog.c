@@ -2,6 +2,7 @@
 
 #include "../../common.h"
 #include "../../context.h"
+#include "../../fixed.h"
 #include "../../palette/p8.h"
 #include "../../rng.h"
 #include "../../scene.h"
@@ -22,8 +23,6 @@
 		.x = -CTX_VIEWPORT_WIDTH * 0.5F, .y = -(FOG_HEIGHT - CTX_VIEWPORT_HEIGHT) * 0.5F, \
 	}
 
-#define FOG_LUMP_TOTAL (8)
-
 #define FOG_SPEED (50)
 #define FOG_DECELERATION_DELTA (128.0)
 // a = (vf^2 - vo^2) / (2 * (xf - xo))
@@ -33,38 +32,29 @@
 
 static const f32 baseRadius = (f32)FOG_HEIGHT / FOG_LUMP_TOTAL * 0.75F;
 static const f32 lumpSpacing = (f32)FOG_HEIGHT / FOG_LUMP_TOTAL;
-static f32 lumpRadii[FOG_LUMP_TOTAL];
-static f32 lumpTargetRadii[FOG_LUMP_TOTAL];
 static const f32 breathingPhaseDuration = 4.0F;
-static f32 breathingPhaseTimer = 0;
-static u8 breathingPhase = 0;
-
 static const f32 movingParticleSpawnDuration = 0.025F;
-static f32 movingParticleSpawnTimer = movingParticleSpawnDuration;
-
-static bool decelerationTimerEnabled = false;
-static f32 decelerationTimer = 0.0;
 
-static void FogReset(void)
+static void FogReset(FogState* state)
 {
 	for (usize i = 0; i < FOG_LUMP_TOTAL; ++i)
 	{
-		lumpRadii[i] = baseRadius;
-		lumpTargetRadii[i] = baseRadius;
+		state->lumpRadii[i] = baseRadius;
+		state->lumpTargetRadii[i] = baseRadius;
 	}
 
-	breathingPhaseTimer = 0;
-	breathingPhase = 0;
+	state->breathingPhaseTimer = 0;
+	state->breathingPhase = 0;
 
-	movingParticleSpawnTimer = movingParticleSpawnDuration;
+	state->movingParticleSpawnTimer = movingParticleSpawnDuration;
 
-	decelerationTimerEnabled = false;
-	decelerationTimer = 0.0;
+	state->decelerationTimerEnabled = false;
+	state->decelerationTimer = 0.0;
 }
 
 static void FogBuildHelper(Scene* scene, const FogBuilder* builder)
 {
-	FogReset();
+	FogReset(&scene->fogState);
 
 	// clang-format off
 	scene->components.tags[builder->entity] =
@@ -104,6 +94,7 @@ static void SpawnMovingParticles(Scene* scene, const usize entity)
 
 	const CPosition* position = &scene->components.positions[entity];
 	const CKinetic* kinetic = &scene->components.kinetics[entity];
+	Rng* rng = SceneGetCosmeticRng(scene);
 
 	static const i32 minSize = 3;
 	static const i32 maxSize = 5;
@@ -119,16 +110,16 @@ static void SpawnMovingParticles(Scene* scene, const usize entity)
 	const Vector2 spawnPosition = (Vector2) {
 		.x = position->value.x + (baseRadius * 0.5F),
 		.y = position->value.y + (FOG_HEIGHT * 0.25F)
-			 + RngNextRange(&scene->rng, 0, (FOG_HEIGHT * 0.5F) + 1),
+			 + RngNextRange(rng, 0, (FOG_HEIGHT * 0.5F) + 1),
 	};
 
 	const Vector2 velocity = (Vector2) {
-		.x = kinetic->velocity.x + RngNextRange(&scene->rng, minXSpeed, maxXSpeed + 1),
-		.y = RngNextRange(&scene->rng, minYSpeed, maxYSpeed + 1),
+		.x = kinetic->velocity.x + RngNextRange(rng, minXSpeed, maxXSpeed + 1),
+		.y = RngNextRange(rng, minYSpeed, maxYSpeed + 1),
 	};
 
-	const f32 radius = RngNextRange(&scene->rng, minSize, maxSize + 1);
-	const f32 lifetime = 0.1F * RngNextRange(&scene->rng, minLifetime, maxLifetime + 1);
+	const f32 radius = RngNextRange(rng, minSize, maxSize + 1);
+	const f32 lifetime = 0.1F * RngNextRange(rng, minLifetime, maxLifetime + 1);
 
 	FogParticleBuilder* builder =
 		ArenaAllocatorTake(&scene->arenaAllocator, sizeof(FogParticleBuilder));
@@ -141,9 +132,12 @@ static void SpawnMovingParticles(Scene* scene, const usize entity)
 	SceneDefer(scene, FogParticleBuild, builder);
 }
 
-static void ShiftBreathingPhase(void)
+static void ShiftBreathingPhase(FogState* state)
 {
-	switch (breathingPhase)
+	f32* lumpRadii = state->lumpRadii;
+	f32* lumpTargetRadii = state->lumpTargetRadii;
+
+	switch (state->breathingPhase)
 	{
 		case 0: {
 			for (usize i = 0; i < FOG_LUMP_TOTAL; ++i)
@@ -203,7 +197,7 @@ static void ShiftBreathingPhase(void)
 		};
 	}
 
-	breathingPhase = (breathingPhase + 1) % 4;
+	state->breathingPhase = (state->breathingPhase + 1) % 4;
 }
 
 void FogUpdate(Scene* scene, const usize entity)
@@ -221,6 +215,7 @@ void FogUpdate(Scene* scene, const usize entity)
 	const CPosition* playerPosition = &scene->components.positions[scene->player];
 	CPosition* position = &scene->components.positions[entity];
 	CKinetic* kinetic = &scene->components.kinetics[entity];
+	FogState* state = &scene->fogState;
 
 	const bool hasNotMoved = kinetic->velocity.x == 0;
 
@@ -229,14 +224,17 @@ void FogUpdate(Scene* scene, const usize entity)
 		return;
 	}
 
-	kinetic->velocity.y = cosf(SceneGetElapsedTime(scene) * 0.5F) * 8;
+	const f64 phase = SceneGetElapsedTime(scene) * 0.5F;
+	const f32 wave = SceneUsesFixedPoint(scene) ? FixedCos(phase) : cosf(phase);
+
+	kinetic->velocity.y = wave * 8;
 
 	// Make sure the fog does not overlap the level's last segment.
 	{
 		const f32 lastSegmentWidth = scene->level.segments[scene->level.segmentsLength - 1].width;
 		const f32 xMax = scene->bounds.width - lastSegmentWidth;
 
-		if (!decelerationTimerEnabled)
+		if (!state->decelerationTimerEnabled)
 		{
 			kinetic->velocity.x = FOG_SPEED;
 
@@ -244,15 +242,15 @@ void FogUpdate(Scene* scene, const usize entity)
 			if (position->value.x + baseRadius >= xMax - FOG_DECELERATION_DELTA)
 			{
 				kinetic->acceleration.x = FOG_DECELERATION;
-				decelerationTimerEnabled = true;
-				decelerationTimer = 0;
+				state->decelerationTimerEnabled = true;
+				state->decelerationTimer = 0;
 			}
 		}
 		else
 		{
-			if (decelerationTimer < FOG_DECELERATION_DURATION)
+			if (state->decelerationTimer < FOG_DECELERATION_DURATION)
 			{
-				decelerationTimer += CTX_DT;
+				state->decelerationTimer += CTX_DT;
 			}
 			else
 			{
@@ -262,34 +260,40 @@ void FogUpdate(Scene* scene, const usize entity)
 		}
 	}
 
+	// Everything past this point is purely visual.
+	if (!SceneSimulatesCosmetics(scene))
+	{
+		return;
+	}
+
 	// Moving Particle spawn logic.
 	{
-		movingParticleSpawnTimer += CTX_DT;
+		state->movingParticleSpawnTimer += CTX_DT;
 
-		if (movingParticleSpawnTimer >= movingParticleSpawnDuration)
+		if (state->movingParticleSpawnTimer >= movingParticleSpawnDuration)
 		{
-			if (RngNextF64(&scene->rng) > 0.1)
+			if (RngNextF64(SceneGetCosmeticRng(scene)) > 0.1)
 			{
 				SpawnMovingParticles(scene, entity);
 			}
 
-			movingParticleSpawnTimer = 0;
+			state->movingParticleSpawnTimer = 0;
 		}
 	}
 
 	// Smooth phase transitioning logic for breathing.
 	{
-		breathingPhaseTimer += CTX_DT;
+		state->breathingPhaseTimer += CTX_DT;
 
-		if (breathingPhaseTimer >= breathingPhaseDuration)
+		if (state->breathingPhaseTimer >= breathingPhaseDuration)
 		{
-			ShiftBreathingPhase();
-			breathingPhaseTimer = 0;
+			ShiftBreathingPhase(state);
+			state->breathingPhaseTimer = 0;
 		}
 	}
 }
 
-void FogDraw(const Scene* scene, const usize entity)
+void FogSnapshot(const Scene* scene, const usize entity, RenderSnapshot* snapshot)
 {
 	static const u64 dependencies = TAG_POSITION | TAG_SMOOTH;
 
@@ -299,19 +303,32 @@ void FogDraw(const Scene* scene, const usize entity)
 		return;
 	}
 
-	const CPosition* position = &scene->components.positions[entity];
-	const CSmooth* smooth = &scene->components.smooths[entity];
+	snapshot->fogVisible = true;
+	snapshot->fogPrevious = scene->components.smooths[entity].previous;
+	snapshot->fogPosition = scene->components.positions[entity].value;
+	snapshot->fogState = scene->fogState;
+}
 
-	const Vector2 interpolated = Vector2Lerp(smooth->previous, position->value, ContextGetAlpha());
+void FogDraw(const RenderSnapshot* snapshot)
+{
+	if (!snapshot->fogVisible)
+	{
+		return;
+	}
+
+	const Vector2 interpolated =
+		Vector2Lerp(snapshot->fogPrevious, snapshot->fogPosition, ContextGetAlpha());
 
-	const f32 step = breathingPhaseTimer / breathingPhaseDuration;
+	const FogState* state = &snapshot->fogState;
+
+	const f32 step = state->breathingPhaseTimer / breathingPhaseDuration;
 
 	static const f32 multiplier = 10;
-	const f32 time = SceneGetElapsedTime(scene) * 2;
+	const f32 time = snapshot->elapsedTime * 2;
 
 	for (usize i = 0; i < FOG_LUMP_TOTAL; ++i)
 	{
-		const f32 radius = Lerp(lumpRadii[i], lumpTargetRadii[i], step);
+		const f32 radius = Lerp(state->lumpRadii[i], state->lumpTargetRadii[i], step);
 		const f32 offset = cosf(((f32)i / FOG_LUMP_TOTAL * 2 * PI) + time) * multiplier;
 		const Vector2 center =
 			Vector2Create(interpolated.x + offset, interpolated.y + (lumpSpacing * i));
@@ -320,7 +337,7 @@ void FogDraw(const Scene* scene, const usize entity)
 
 	for (usize i = 0; i < FOG_LUMP_TOTAL; ++i)
 	{
-		const f32 radius = Lerp(lumpRadii[i], lumpTargetRadii[i], step);
+		const f32 radius = Lerp(state->lumpRadii[i], state->lumpTargetRadii[i], step);
 		const f32 offset = cosf(((f32)i / FOG_LUMP_TOTAL * 2 * PI) + time) * multiplier;
 		const Vector2 center =
 			Vector2Create(interpolated.x + offset, interpolated.y + (lumpSpacing * i));
@@ -336,24 +353,21 @@ void FogDraw(const Scene* scene, const usize entity)
 	}
 }
 
-void FogDebugDraw(const Scene* scene, const usize entity)
+void FogDebugDraw(const RenderSnapshot* snapshot)
 {
-	static const u64 dependencies = TAG_POSITION;
-
-	if (!SceneEntityIs(scene, entity, ENTITY_TYPE_FOG)
-		|| !SceneEntityHasDependencies(scene, entity, dependencies))
+	if (!snapshot->fogVisible)
 	{
 		return;
 	}
 
-	const CPosition* position = &scene->components.positions[entity];
+	const Vector2 position = snapshot->fogPosition;
 
 	static const i32 padding = 16;
 
 	// Draw the pseudo-bounds of the fog.
 	{
 		const Rectangle aabb = (Rectangle) {
-			.x = position->value.x - (CTX_VIEWPORT_WIDTH * 2),
+			.x = position.x - (CTX_VIEWPORT_WIDTH * 2),
 			.y = -padding,
 			.width = CTX_VIEWPORT_WIDTH * 2,
 			.height = padding + CTX_VIEWPORT_HEIGHT + padding,
@@ -369,7 +383,7 @@ void FogDebugDraw(const Scene* scene, const usize entity)
 	// Draw the line of lethalness.
 	{
 		const Rectangle aabb = (Rectangle) {
-			.x = position->value.x - FOG_LETHAL_DISTANCE,
+			.x = position.x - FOG_LETHAL_DISTANCE,
 			.y = -padding,
 			.width = 1,
 			.height = padding + CTX_VIEWPORT_HEIGHT + padding,
@@ -3,6 +3,8 @@
 #include "../../common.h"
 #include "../../level.h"
 
+typedef struct RenderSnapshot RenderSnapshot;
+
 #define FOG_LETHAL_DISTANCE (CTX_VIEWPORT_WIDTH * 0.75)
 
 typedef struct
@@ -14,5 +16,6 @@ void FogBuild(Scene* scene, const void* params);
 
 void FogUpdate(Scene* scene, usize entity);
 
-void FogDraw(const Scene* scene, usize entity);
-void FogDebugDraw(const Scene* scene, usize entity);
+void FogSnapshot(const Scene* scene, usize entity, RenderSnapshot* snapshot);
+void FogDraw(const RenderSnapshot* snapshot);
+void FogDebugDraw(const RenderSnapshot* snapshot);
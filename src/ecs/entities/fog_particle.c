@@ -5,6 +5,7 @@
 #include "../../scene.h"
 #include "../components.h"
 
+#include <assert.h>
 #include <raylib.h>
 #include <raymath.h>
 
@@ -54,7 +55,7 @@ void FogParticleBuild(Scene* scene, const void* params)
 	FogParticleBuildHelper(scene, params);
 }
 
-void FogParticleDraw(const Scene* scene, const usize entity)
+void FogParticleSnapshot(const Scene* scene, const usize entity, RenderSnapshot* snapshot)
 {
 	static const u64 dependencies = TAG_POSITION | TAG_DIMENSION | TAG_FLEETING | TAG_SMOOTH;
 
@@ -64,6 +65,8 @@ void FogParticleDraw(const Scene* scene, const usize entity)
 		return;
 	}
 
+	assert(snapshot->cloudParticlesLength + snapshot->fogParticlesLength < MAX_ENTITIES);
+
 	const CPosition* position = &scene->components.positions[entity];
 	const CFleeting* fleeting = &scene->components.fleetings[entity];
 	const CDimension* dimension = &scene->components.dimensions[entity];
@@ -72,11 +75,9 @@ void FogParticleDraw(const Scene* scene, const usize entity)
 	const f32 progress = fleeting->age / fleeting->lifetime;
 	const f32 scale = -4 * (progress * progress - progress);
 
-	const Vector2 interpolated = Vector2Lerp(smooth->previous, position->value, ContextGetAlpha());
-
-	const Vector2 center = (Vector2) {
-		.x = interpolated.x + (dimension->width * 0.5F),
-		.y = interpolated.y + (dimension->height * 0.5F),
+	const Vector2 offset = (Vector2) {
+		.x = dimension->width * 0.5F,
+		.y = dimension->height * 0.5F,
 	};
 
 	const u32 sidesCount = 4 + (entity % 3);
@@ -88,5 +89,13 @@ void FogParticleDraw(const Scene* scene, const usize entity)
 		rotation *= -1;
 	}
 
-	DrawPoly(center, sidesCount, dimension->width * scale * 0.5F, rotation, COLOR_BLACK);
+	snapshot->polygons[MAX_ENTITIES - 1 - snapshot->fogParticlesLength] = (RenderPolygon) {
+		.previous = Vector2Add(smooth->previous, offset),
+		.center = Vector2Add(position->value, offset),
+		.radius = dimension->width * scale * 0.5F,
+		.rotation = rotation,
+		.sides = sidesCount,
+		.color = COLOR_BLACK,
+	};
+	snapshot->fogParticlesLength += 1;
 }
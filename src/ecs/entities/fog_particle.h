@@ -5,6 +5,8 @@
 
 #include <raylib.h>
 
+typedef struct RenderSnapshot RenderSnapshot;
+
 typedef struct
 {
 	usize entity;
@@ -16,4 +18,4 @@ typedef struct
 
 void FogParticleBuild(Scene* scene, const void* params);
 
-void FogParticleDraw(const Scene* scene, usize entity);
+void FogParticleSnapshot(const Scene* scene, usize entity, RenderSnapshot* snapshot);
@@ -144,12 +144,19 @@ static void SpawnImpactParticles(Scene* scene, const usize entity, const f32 y)
 {
 	assert(SceneEntityHasDependencies(scene, entity, TAG_POSITION | TAG_DIMENSION | TAG_KINETIC));
 
+	if (!SceneSimulatesCosmetics(scene))
+	{
+		return;
+	}
+
+	Rng* rng = SceneGetCosmeticRng(scene);
+
 	const CPosition* position = &scene->components.positions[entity];
 	const CDimension* dimension = &scene->components.dimensions[entity];
 	const CKinetic* kinetic = &scene->components.kinetics[entity];
 
 	static const f32 gravity = 9.8F;
-	const usize spawnCount = RngNextRange(&scene->rng, 10, 20 + 1);
+	const usize spawnCount = RngNextRange(rng, 10, 20 + 1);
 	const f32 spread = dimension->width * 0.25;
 	const Vector2 leftAnchor = (Vector2) {
 		.x = position->value.x,
@@ -167,10 +174,10 @@ static void SpawnImpactParticles(Scene* scene, const usize entity, const f32 y)
 
 		for (usize i = 0; i < spawnCount; ++i)
 		{
-			const f32 radius = RngNextRange(&scene->rng, 1, 4 + 1);
-			const f32 offset = RngNextRange(&scene->rng, 0, spread + 1);
-			const f32 speed = RngNextRange(&scene->rng, 10, 30 + 1);
-			const f32 lifetime = 1 + (0.5 * RngNextRange(&scene->rng, 0, 4 + 1));
+			const f32 radius = RngNextRange(rng, 1, 4 + 1);
+			const f32 offset = RngNextRange(rng, 0, spread + 1);
+			const f32 speed = RngNextRange(rng, 10, 30 + 1);
+			const f32 lifetime = 1 + (0.5 * RngNextRange(rng, 0, 4 + 1));
 
 			// Left pocket.
 			{
@@ -231,10 +238,10 @@ static void SpawnImpactParticles(Scene* scene, const usize entity, const f32 y)
 
 		for (usize i = 0; i < total; ++i)
 		{
-			const f32 radius = RngNextRange(&scene->rng, 1, 3 + 1);
-			const f32 offset = RngNextRange(&scene->rng, 0, spread + 1);
-			const f32 speed = RngNextRange(&scene->rng, 20, 35 + 1);
-			const f32 lifetime = 0.5 + (0.5 * RngNextRange(&scene->rng, 0, 4 + 1));
+			const f32 radius = RngNextRange(rng, 1, 3 + 1);
+			const f32 offset = RngNextRange(rng, 0, spread + 1);
+			const f32 speed = RngNextRange(rng, 20, 35 + 1);
+			const f32 lifetime = 0.5 + (0.5 * RngNextRange(rng, 0, 4 + 1));
 
 			if (kinetic->velocity.x > 0)
 			{
@@ -286,12 +293,19 @@ static void SpawnJumpParticles(Scene* scene, const usize entity)
 {
 	assert(SceneEntityHasDependencies(scene, entity, TAG_POSITION | TAG_DIMENSION | TAG_KINETIC));
 
+	if (!SceneSimulatesCosmetics(scene))
+	{
+		return;
+	}
+
+	Rng* rng = SceneGetCosmeticRng(scene);
+
 	const CPosition* position = &scene->components.positions[entity];
 	const CDimension* dimension = &scene->components.dimensions[entity];
 	const CKinetic* kinetic = &scene->components.kinetics[entity];
 
 	static const f32 gravity = 9.8F;
-	const usize spawnCount = RngNextRange(&scene->rng, 10, 30 + 1);
+	const usize spawnCount = RngNextRange(rng, 10, 30 + 1);
 	const Vector2 anchor = (Vector2) {
 		.x = position->value.x + (dimension->width * 0.5),
 		.y = position->value.y + dimension->height,
@@ -304,9 +318,9 @@ static void SpawnJumpParticles(Scene* scene, const usize entity)
 
 		for (usize i = 0; i < spawnCount; ++i)
 		{
-			const f32 radius = RngNextRange(&scene->rng, 1, 3 + 1);
-			const f32 speed = RngNextRange(&scene->rng, 10, 15 + 1);
-			const f32 lifetime = 0.5 + (0.5 * RngNextRange(&scene->rng, 0, 3 + 1));
+			const f32 radius = RngNextRange(rng, 1, 3 + 1);
+			const f32 speed = RngNextRange(rng, 10, 15 + 1);
+			const f32 lifetime = 0.5 + (0.5 * RngNextRange(rng, 0, 3 + 1));
 
 			// Left pocket.
 			{
@@ -378,8 +392,8 @@ static void SpawnJumpParticles(Scene* scene, const usize entity)
 
 		for (usize i = 0; i < total; ++i)
 		{
-			const f32 radius = RngNextRange(&scene->rng, 2, 3 + 1);
-			const f32 lifetime = 0.5 + (0.5 * RngNextRange(&scene->rng, 0, 4 + 1));
+			const f32 radius = RngNextRange(rng, 2, 3 + 1);
+			const f32 lifetime = 0.5 + (0.5 * RngNextRange(rng, 0, 4 + 1));
 
 			const Vector2 cloudPosition = (Vector2) {
 				.x = anchor.x - radius,
@@ -391,7 +405,7 @@ static void SpawnJumpParticles(Scene* scene, const usize entity)
 				.y = sinf(rotation),
 			};
 
-			f32 speed = RngNextRange(&scene->rng, 10, 15 + 1);
+			f32 speed = RngNextRange(rng, 10, 15 + 1);
 
 			if (kinetic->velocity.x != 0)
 			{
@@ -1544,7 +1558,7 @@ void PlayerShadowUpdate(Scene* scene, const usize entity)
 	color->value = (Color) { r, g, b, a };
 }
 
-void PlayerDebugDraw(const Scene* scene, const usize entity)
+void PlayerDebugSnapshot(const Scene* scene, const usize entity, RenderSnapshot* snapshot)
 {
 	static const u64 dependencies = TAG_PLAYER | TAG_POSITION | TAG_DIMENSION;
 
@@ -1554,33 +1568,44 @@ void PlayerDebugDraw(const Scene* scene, const usize entity)
 		return;
 	}
 
+	assert(snapshot->playerBoundsLength < MAX_PLAYERS);
+
 	const CPosition* position = &scene->components.positions[entity];
 	const CDimension* dimension = &scene->components.dimensions[entity];
 
-	const Rectangle aabb = (Rectangle) {
+	snapshot->playerBounds[snapshot->playerBoundsLength] = (Rectangle) {
 		.x = position->value.x,
 		.y = position->value.y,
 		.width = dimension->width,
 		.height = dimension->height,
 	};
+	snapshot->playerBoundsLength += 1;
+}
 
-	// Draw general-purpose aabb.
+void PlayerDebugDraw(const RenderSnapshot* snapshot)
+{
+	for (usize i = 0; i < snapshot->playerBoundsLength; ++i)
 	{
-		const Color color = P8_RED;
-		const Color premultiplied = ColorMultiply(color, 0.4);
+		const Rectangle aabb = snapshot->playerBounds[i];
 
-		DrawRectangleRec(aabb, premultiplied);
-		DrawRectangleLinesEx(aabb, 2, color);
-	}
+		// Draw general-purpose aabb.
+		{
+			const Color color = P8_RED;
+			const Color premultiplied = ColorMultiply(color, 0.4);
 
-	// Draw smaller feet aabb.
-	{
-		const Rectangle collider = PlayerGetFeetCollider(aabb);
+			DrawRectangleRec(aabb, premultiplied);
+			DrawRectangleLinesEx(aabb, 2, color);
+		}
 
-		const Color color = P8_PINK;
-		const Color premultiplied = ColorMultiply(color, 0.8);
+		// Draw smaller feet aabb.
+		{
+			const Rectangle collider = PlayerGetFeetCollider(aabb);
 
-		DrawRectangleRec(collider, premultiplied);
-		DrawRectangleLinesEx(collider, 1, color);
+			const Color color = P8_PINK;
+			const Color premultiplied = ColorMultiply(color, 0.8);
+
+			DrawRectangleRec(collider, premultiplied);
+			DrawRectangleLinesEx(collider, 1, color);
+		}
 	}
 }
@@ -3,6 +3,8 @@
 #include "../../common.h"
 #include "../../level.h"
 
+typedef struct RenderSnapshot RenderSnapshot;
+
 #define PLAYER_MAX_HIT_POINTS (5)
 
 typedef struct
@@ -22,4 +24,5 @@ void PlayerAnimationUpdate(Scene* scene, usize entity);
 void PlayerTrailUpdate(Scene* scene, usize entity);
 void PlayerShadowUpdate(Scene* scene, usize entity);
 
-void PlayerDebugDraw(const Scene* scene, usize entity);
+void PlayerDebugSnapshot(const Scene* scene, usize entity, RenderSnapshot* snapshot);
+void PlayerDebugDraw(const RenderSnapshot* snapshot);
@@ -4,6 +4,8 @@
 #include "../atlas.h"
 #include "../common.h"
 #include "../context.h"
+#include "../counters.h"
+#include "../fixed.h"
 #include "../palette/p8.h"
 #include "../scene.h"
 #include "components.h"
@@ -70,6 +72,24 @@ void SKineticUpdate(Scene* scene, const usize entity)
 	CPosition* position = &scene->components.positions[entity];
 	CKinetic* kinetic = &scene->components.kinetics[entity];
 
+	if (SceneUsesFixedPoint(scene))
+	{
+		// Everything is snapped to the nearest Fixed before integrating, so whatever float math was
+		// used to come up with these values cannot accumulate.
+		const Fixed ax = FixedFromF32(kinetic->acceleration.x);
+		const Fixed ay = FixedFromF32(kinetic->acceleration.y);
+		const Fixed vx = FixedFromF32(kinetic->velocity.x) + FixedScale(ax, 1, CTX_FPS);
+		const Fixed vy = FixedFromF32(kinetic->velocity.y) + FixedScale(ay, 1, CTX_FPS);
+		const Fixed x = FixedFromF32(position->value.x) + FixedScale(vx, 1, CTX_FPS);
+		const Fixed y = FixedFromF32(position->value.y) + FixedScale(vy, 1, CTX_FPS);
+
+		kinetic->acceleration = Vector2Create(FixedToF32(ax), FixedToF32(ay));
+		kinetic->velocity = Vector2Create(FixedToF32(vx), FixedToF32(vy));
+		position->value = Vector2Create(FixedToF32(x), FixedToF32(y));
+
+		return;
+	}
+
 	kinetic->velocity.x += kinetic->acceleration.x * CTX_DT;
 	kinetic->velocity.y += kinetic->acceleration.y * CTX_DT;
 
@@ -120,6 +140,9 @@ static SimulateCollisionOnAxisResult SimulateCollisionOnAxis(
 	bool xModified = false;
 	bool yModified = false;
 
+	// Collision tests are tallied locally; counting each one as it happens is needlessly slow.
+	i64 tests = 0;
+
 	while (remainder.x > 0 || remainder.y > 0)
 	{
 		remainder.x -= params->step * fabsf(direction.x);
@@ -153,6 +176,8 @@ static SimulateCollisionOnAxisResult SimulateCollisionOnAxis(
 				.height = otherDimension->height,
 			};
 
+			tests += 1;
+
 			if (CheckCollisionRecs(simulatedAabb, otherAabb))
 			{
 				const Vector2 rawResolution = Vector2Create(-direction.x, -direction.y);
@@ -227,6 +252,7 @@ static SimulateCollisionOnAxisResult SimulateCollisionOnAxis(
 				};
 
 				const OnResolutionResult result = params->onResolution(&onResolutionParams);
+				CounterAdd(COUNTER_RESOLUTIONS, 1);
 
 				xModified |= result.aabb.x != simulatedAabb.x;
 				yModified |= result.aabb.y != simulatedAabb.y;
@@ -241,6 +267,8 @@ static SimulateCollisionOnAxisResult SimulateCollisionOnAxis(
 		}
 	}
 
+	CounterAdd(COUNTER_COLLISION_TESTS, tests);
+
 	return (SimulateCollisionOnAxisResult) {
 		.simulatedAabb = simulatedAabb,
 		.xModified = xModified,
@@ -428,6 +456,8 @@ void SPostCollisionUpdate(Scene* scene, const usize entity)
 		.height = dimension->height,
 	};
 
+	i64 tests = 0;
+
 	for (usize i = 0; i < SceneGetTotalAllocatedEntities(scene); ++i)
 	{
 		const u64 otherDependencies = TAG_POSITION | TAG_DIMENSION | TAG_COLLIDER;
@@ -453,6 +483,8 @@ void SPostCollisionUpdate(Scene* scene, const usize entity)
 			.height = otherDimension->height,
 		};
 
+		tests += 1;
+
 		if (CheckCollisionRecs(aabb, otherAabb))
 		{
 			const Rectangle overlap = GetCollisionRec(aabb, otherAabb);
@@ -469,6 +501,8 @@ void SPostCollisionUpdate(Scene* scene, const usize entity)
 			collider->onCollision(&onCollisionParams);
 		}
 	}
+
+	CounterAdd(COUNTER_COLLISION_TESTS, tests);
 }
 
 void SFleetingUpdate(Scene* scene, const usize entity)
@@ -510,78 +544,52 @@ void SAnimationUpdate(Scene* scene, const usize entity)
 	}
 }
 
-static void DrawCSprite(
-	const Atlas* atlas,
-	const CSprite* sprite,
-	const Vector2 position,
-	const Color tint
-)
+// Where a given entity was as of the previous frame; only entities that are TAG_SMOOTH keep track.
+static Vector2 GetPreviousPosition(const Scene* scene, const usize entity)
 {
-	const AtlasDrawParams params = (AtlasDrawParams) {
-		.sprite = sprite->type,
-		.position = position,
-		.scale = Vector2Create(1, 1),
-		.intramural = sprite->intramural,
-		.reflection = sprite->reflection,
-		.tint = tint,
-	};
-	AtlasDraw(atlas, &params);
+	if (SceneEntityHasDependencies(scene, entity, TAG_SMOOTH))
+	{
+		return scene->components.smooths[entity].previous;
+	}
+
+	return scene->components.positions[entity].value;
 }
 
-void SSpriteDraw(const Scene* scene, const usize entity)
+static Color GetTint(const Scene* scene, const usize entity)
 {
-	static const u64 dependencies = TAG_POSITION | TAG_SPRITE;
-
-	if (!SceneEntityHasDependencies(scene, entity, dependencies))
+	if (SceneEntityHasDependencies(scene, entity, TAG_COLOR))
 	{
-		return;
+		return scene->components.colors[entity].value;
 	}
 
-	const CPosition* position = &scene->components.positions[entity];
-	const CSprite* sprite = &scene->components.sprites[entity];
+	return COLOR_WHITE;
+}
 
-	Vector2 drawPosition = position->value;
+void SSpriteSnapshot(const Scene* scene, const usize entity, RenderSnapshot* snapshot)
+{
+	static const u64 dependencies = TAG_POSITION | TAG_SPRITE;
 
-	if (SceneEntityHasDependencies(scene, entity, TAG_SMOOTH))
+	if (!SceneEntityHasDependencies(scene, entity, dependencies))
 	{
-		const CSmooth* smooth = &scene->components.smooths[entity];
-
-		const Vector2 interpolated =
-			Vector2Lerp(smooth->previous, position->value, ContextGetAlpha());
-		drawPosition = interpolated;
+		return;
 	}
 
-	if (SceneEntityHasDependencies(scene, entity, TAG_COLOR))
-	{
-		const CColor* color = &scene->components.colors[entity];
+	assert(snapshot->spritesLength + snapshot->animationsLength < MAX_ENTITIES);
 
-		DrawCSprite(&scene->atlas, sprite, drawPosition, color->value);
-	}
-	else
-	{
-		DrawCSprite(&scene->atlas, sprite, drawPosition, COLOR_WHITE);
-	}
-}
+	const CSprite* sprite = &scene->components.sprites[entity];
 
-static void DrawCAnimation(
-	const Atlas* atlas,
-	const CAnimation* animation,
-	const Vector2 position,
-	const Color tint
-)
-{
-	const AtlasDrawParams params = (AtlasDrawParams) {
-		.sprite = ANIMATIONS[animation->type][animation->frame],
-		.position = position,
-		.scale = Vector2Create(1, 1),
-		.intramural = animation->intramural,
-		.reflection = animation->reflection,
-		.tint = tint,
+	snapshot->sprites[snapshot->spritesLength] = (RenderSprite) {
+		.previous = GetPreviousPosition(scene, entity),
+		.position = scene->components.positions[entity].value,
+		.sprite = sprite->type,
+		.intramural = sprite->intramural,
+		.reflection = sprite->reflection,
+		.tint = GetTint(scene, entity),
 	};
-	AtlasDraw(atlas, &params);
+	snapshot->spritesLength += 1;
 }
 
-void SAnimationDraw(const Scene* scene, const usize entity)
+void SAnimationSnapshot(const Scene* scene, const usize entity, RenderSnapshot* snapshot)
 {
 	static const u64 dependencies = TAG_POSITION | TAG_ANIMATION;
 
@@ -590,33 +598,22 @@ void SAnimationDraw(const Scene* scene, const usize entity)
 		return;
 	}
 
-	const CPosition* position = &scene->components.positions[entity];
-	const CAnimation* animation = &scene->components.animations[entity];
-
-	Vector2 drawPosition = position->value;
-
-	if (SceneEntityHasDependencies(scene, entity, TAG_SMOOTH))
-	{
-		const CSmooth* smooth = &scene->components.smooths[entity];
-
-		const Vector2 interpolated =
-			Vector2Lerp(smooth->previous, position->value, ContextGetAlpha());
-		drawPosition = interpolated;
-	}
+	assert(snapshot->spritesLength + snapshot->animationsLength < MAX_ENTITIES);
 
-	if (SceneEntityHasDependencies(scene, entity, TAG_COLOR))
-	{
-		const CColor* color = &scene->components.colors[entity];
+	const CAnimation* animation = &scene->components.animations[entity];
 
-		DrawCAnimation(&scene->atlas, animation, drawPosition, color->value);
-	}
-	else
-	{
-		DrawCAnimation(&scene->atlas, animation, drawPosition, COLOR_WHITE);
-	}
+	snapshot->sprites[MAX_ENTITIES - 1 - snapshot->animationsLength] = (RenderSprite) {
+		.previous = GetPreviousPosition(scene, entity),
+		.position = scene->components.positions[entity].value,
+		.sprite = ANIMATIONS[animation->type][animation->frame],
+		.intramural = animation->intramural,
+		.reflection = animation->reflection,
+		.tint = GetTint(scene, entity),
+	};
+	snapshot->animationsLength += 1;
 }
 
-static void ColliderDrawLayerBoundaries(const CCollider* self, const Rectangle aabb)
+static void ColliderDrawLayerBoundaries(const RenderCollider* self, const Rectangle aabb)
 {
 	static const f32 alpha = 0.4;
 
@@ -658,7 +655,7 @@ static void ColliderDrawLayerBoundaries(const CCollider* self, const Rectangle a
 }
 
 static void ColliderDrawResolutionSchema(
-	const CCollider* self,
+	const RenderCollider* self,
 	const Rectangle aabb,
 	const Color color
 )
@@ -717,7 +714,7 @@ static void ColliderDrawResolutionSchema(
 	}
 }
 
-void SDebugColliderDraw(const Scene* scene, const usize entity)
+void SDebugColliderSnapshot(const Scene* scene, const usize entity, RenderSnapshot* snapshot)
 {
 	static const u64 dependencies = TAG_POSITION | TAG_DIMENSION | TAG_COLLIDER;
 
@@ -730,17 +727,32 @@ void SDebugColliderDraw(const Scene* scene, const usize entity)
 	const CDimension* dimension = &scene->components.dimensions[entity];
 	const CCollider* collider = &scene->components.colliders[entity];
 
-	const Rectangle aabb = (Rectangle) {
-		.x = position->value.x,
-		.y = position->value.y,
-		.width = dimension->width,
-		.height = dimension->height,
+	assert(snapshot->collidersLength < MAX_ENTITIES);
+
+	snapshot->colliders[snapshot->collidersLength] = (RenderCollider) {
+		.aabb = (Rectangle) {
+			.x = position->value.x,
+			.y = position->value.y,
+			.width = dimension->width,
+			.height = dimension->height,
+		},
+		.layer = collider->layer,
+		.resolutionSchema = collider->resolutionSchema,
 	};
+	snapshot->collidersLength += 1;
+}
 
-	ColliderDrawLayerBoundaries(collider, aabb);
-
-	if ((collider->layer & LAYER_TERRAIN) == LAYER_TERRAIN)
+void SDebugColliderDraw(const RenderSnapshot* snapshot)
+{
+	for (usize i = 0; i < snapshot->collidersLength; ++i)
 	{
-		ColliderDrawResolutionSchema(collider, aabb, P8_GREEN);
+		const RenderCollider* collider = &snapshot->colliders[i];
+
+		ColliderDrawLayerBoundaries(collider, collider->aabb);
+
+		if ((collider->layer & LAYER_TERRAIN) == LAYER_TERRAIN)
+		{
+			ColliderDrawResolutionSchema(collider, collider->aabb, P8_GREEN);
+		}
 	}
 }
@@ -3,6 +3,8 @@
 #include "../common.h"
 #include "../level.h"
 
+typedef struct RenderSnapshot RenderSnapshot;
+
 void SSmoothUpdate(Scene* scene, usize entity);
 void SKineticUpdate(Scene* scene, usize entity);
 void SCollisionUpdate(Scene* scene, usize entity);
@@ -10,6 +12,9 @@ void SPostCollisionUpdate(Scene* scene, usize entity);
 void SFleetingUpdate(Scene* scene, usize entity);
 void SAnimationUpdate(Scene* scene, usize entity);
 
-void SSpriteDraw(const Scene* scene, usize entity);
-void SAnimationDraw(const Scene* scene, usize entity);
-void SDebugColliderDraw(const Scene* scene, usize entity);
+// Each of these copies whatever a given entity needs drawn into a snapshot (see SceneTakeSnapshot).
+void SSpriteSnapshot(const Scene* scene, usize entity, RenderSnapshot* snapshot);
+void SAnimationSnapshot(const Scene* scene, usize entity, RenderSnapshot* snapshot);
+void SDebugColliderSnapshot(const Scene* scene, usize entity, RenderSnapshot* snapshot);
+
+void SDebugColliderDraw(const RenderSnapshot* snapshot);
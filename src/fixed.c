@@ -0,0 +1,85 @@
+#include "fixed.h"
+
+#include <math.h>
+
+// Angles are reduced with 30 fractional bits of precision, which keeps every intermediate product
+// within an i64.
+#define ANGLE_ONE ((i64)1 << 30)
+// round(pi * ANGLE_ONE)
+#define ANGLE_PI ((i64)3373259426)
+#define ANGLE_HALF_PI (ANGLE_PI / 2)
+#define ANGLE_TWO_PI (ANGLE_PI * 2)
+
+Fixed FixedFromF32(const f32 value)
+{
+	// Scaling by a power of two and flooring are both exact.
+	return (Fixed)floorf(value * FIXED_ONE + 0.5F);
+}
+
+f32 FixedToF32(const Fixed value)
+{
+	return (f32)value / FIXED_ONE;
+}
+
+Fixed FixedScale(const Fixed value, const i32 numerator, const i32 denominator)
+{
+	const i64 product = (i64)value * numerator;
+	const i64 half = denominator / 2;
+
+	// Round half away from zero.
+	if ((product < 0) != (denominator < 0))
+	{
+		return (Fixed)((product - half) / denominator);
+	}
+
+	return (Fixed)((product + half) / denominator);
+}
+
+// Evaluates the Taylor series of sin up to x^9 for an angle within [0, pi / 2].
+static i64 SinQuadrant(const i64 angle)
+{
+	const i64 squared = (angle * angle) / ANGLE_ONE;
+
+	i64 result = ANGLE_ONE - (squared * ANGLE_ONE) / (72 * ANGLE_ONE);
+	result = ANGLE_ONE - (squared * result) / (42 * ANGLE_ONE);
+	result = ANGLE_ONE - (squared * result) / (20 * ANGLE_ONE);
+	result = ANGLE_ONE - (squared * result) / (6 * ANGLE_ONE);
+
+	return (angle * result) / ANGLE_ONE;
+}
+
+static f32 SinFromAngle(i64 angle)
+{
+	angle %= ANGLE_TWO_PI;
+
+	if (angle < 0)
+	{
+		angle += ANGLE_TWO_PI;
+	}
+
+	i64 sign = 1;
+
+	if (angle >= ANGLE_PI)
+	{
+		angle -= ANGLE_PI;
+		sign = -1;
+	}
+
+	if (angle > ANGLE_HALF_PI)
+	{
+		angle = ANGLE_PI - angle;
+	}
+
+	// Converting to an f32 is correctly rounded everywhere.
+	return (f32)(sign * SinQuadrant(angle)) / ANGLE_ONE;
+}
+
+f32 FixedSin(const f64 radians)
+{
+	return SinFromAngle((i64)floor(radians * ANGLE_ONE));
+}
+
+f32 FixedCos(const f64 radians)
+{
+	return SinFromAngle((i64)floor(radians * ANGLE_ONE) + ANGLE_HALF_PI);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef int32_t i32;
+typedef int64_t i64;
+typedef float f32;
+typedef double f64;
+
+// The amount of fractional bits of a Fixed.
+#define FIXED_FRACTION_BITS (8)
+#define FIXED_ONE (1 << FIXED_FRACTION_BITS)
+
+// A fixed-point number (with a resolution of 1/256). Any Fixed with a magnitude below 2^16 is
+// exactly representable as an f32, so components can keep storing f32s while the math behind them
+// is done with integers (which behave identically regardless of compiler or platform).
+typedef i32 Fixed;
+
+// Rounds the given f32 to the nearest Fixed.
+Fixed FixedFromF32(f32 value);
+f32 FixedToF32(Fixed value);
+
+// Returns `value * numerator / denominator` rounded to the nearest Fixed.
+Fixed FixedScale(Fixed value, i32 numerator, i32 denominator);
+
+// Approximations of sin and cos that only use integer math, so unlike libm's they are identical
+// everywhere (and accurate to within 1e-4).
+f32 FixedSin(f64 radians);
+f32 FixedCos(f64 radians);
@@ -0,0 +1,244 @@
+#include "footprint.h"
+
+#include "./collections/deque.h"
+#include "common.h"
+#include "context.h"
+#include "scene.h"
+
+#include <raylib.h>
+
+#define KIB ((usize)1024)
+#define MIB (KIB * 1024)
+
+static const char* names[FOOTPRINT_TOTAL] = {
+	[FOOTPRINT_SCENE] = "scene",
+	[FOOTPRINT_COMPONENTS] = "components",
+	[FOOTPRINT_SNAPSHOTS] = "snapshots",
+	[FOOTPRINT_INPUT_STREAMS] = "input streams",
+	[FOOTPRINT_DEQUES] = "deques",
+	[FOOTPRINT_ARENA] = "arena",
+	[FOOTPRINT_ATLAS] = "atlas",
+	[FOOTPRINT_LAYERS] = "layers",
+};
+
+// Every budget leaves roughly a quarter of headroom over what the subsystem needed when it was
+// last set; only raise a budget on purpose (never just to make a run pass).
+static const FootprintBudget budgets[FOOTPRINT_TOTAL] = {
+	[FOOTPRINT_SCENE] = { .memoryBytes = 14 * KIB },
+	[FOOTPRINT_COMPONENTS] = { .memoryBytes = 208 * KIB },
+	[FOOTPRINT_SNAPSHOTS] = { .memoryBytes = 416 * KIB },
+	[FOOTPRINT_INPUT_STREAMS] = { .memoryBytes = 264 * KIB },
+	[FOOTPRINT_DEQUES] = { .memoryBytes = 32 * KIB },
+	[FOOTPRINT_ARENA] = { .memoryBytes = 10 * KIB },
+	[FOOTPRINT_ATLAS] = { .memoryBytes = 8 * KIB, .vramBytes = 1280 * KIB },
+	// Layers are as large as the monitor allows (see SceneSetupLayers); this fits the reference
+	// monitor (see FOOTPRINT_REFERENCE_MONITOR_WIDTH).
+	[FOOTPRINT_LAYERS] = { .vramBytes = 480 * MIB },
+};
+
+const char* FootprintGetName(const FootprintSubsystem subsystem)
+{
+	return names[subsystem];
+}
+
+static usize GetBytesPerPixel(const i32 format)
+{
+	switch (format)
+	{
+		case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: {
+			return 1;
+		}
+		case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
+		case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
+		case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
+		case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4: {
+			return 2;
+		}
+		case PIXELFORMAT_UNCOMPRESSED_R8G8B8: {
+			return 3;
+		}
+		case PIXELFORMAT_UNCOMPRESSED_R32G32B32: {
+			return 12;
+		}
+		case PIXELFORMAT_UNCOMPRESSED_R32G32B32A32: {
+			return 16;
+		}
+		default: {
+			return 4;
+		}
+	}
+}
+
+static usize EstimateTextureBytes(const Texture2D texture)
+{
+	return (usize)texture.width * texture.height * GetBytesPerPixel(texture.format);
+}
+
+static usize EstimateRenderTextureBytes(const RenderTexture2D renderTexture)
+{
+	const Texture2D depth = renderTexture.depth;
+
+	return EstimateTextureBytes(renderTexture.texture) + (usize)depth.width * depth.height * 4;
+}
+
+// Estimates a layer that was never loaded as if it were loaded on the given monitor.
+static usize EstimateLayerBytes(const SceneLayer layer, const Rectangle monitor)
+{
+	const Rectangle region = SceneGetLayerRegion(layer, monitor);
+
+	// 32-bit color plus a 32-bit depth buffer.
+	return (usize)region.width * region.height * 8;
+}
+
+static usize GetDequeBytes(const Deque* deque)
+{
+	return deque->m_capacity * deque->m_dataSize;
+}
+
+Footprint FootprintMeasure(const Scene* scene)
+{
+	const Rectangle monitor = (Rectangle) {
+		.width = FOOTPRINT_REFERENCE_MONITOR_WIDTH,
+		.height = FOOTPRINT_REFERENCE_MONITOR_HEIGHT,
+	};
+
+	return FootprintMeasureOnMonitor(scene, monitor);
+}
+
+Footprint FootprintMeasureOnMonitor(const Scene* scene, const Rectangle monitor)
+{
+	Footprint footprint = { 0 };
+	FootprintEntry* entries = footprint.entries;
+
+	entries[FOOTPRINT_SCENE].staticBytes = sizeof(Scene) - sizeof(Components);
+	entries[FOOTPRINT_COMPONENTS].staticBytes = sizeof(Components);
+
+	// A snapshot's tree Deques are copies of the scene's (see SceneTakeSnapshot).
+	entries[FOOTPRINT_SNAPSHOTS].staticBytes = FOOTPRINT_SNAPSHOTS_LENGTH * sizeof(RenderSnapshot);
+	entries[FOOTPRINT_SNAPSHOTS].heapBytes = FOOTPRINT_SNAPSHOTS_LENGTH
+		* (GetDequeBytes(&scene->treePositionsBack) + GetDequeBytes(&scene->treePositionsFront));
+
+	for (usize i = 0; i < MAX_PLAYERS; ++i)
+	{
+		const InputStream* stream = &scene->inputStreams[i];
+
+		if (!stream->readOnly)
+		{
+			entries[FOOTPRINT_INPUT_STREAMS].heapBytes += stream->bits.size;
+		}
+	}
+
+	// Player one's own InputStream is still held on to while a Replay is played back instead.
+	if (scene->inputStreams[0].readOnly && !scene->m_ownInputStream.readOnly)
+	{
+		entries[FOOTPRINT_INPUT_STREAMS].heapBytes += scene->m_ownInputStream.bits.size;
+	}
+
+	entries[FOOTPRINT_DEQUES].heapBytes =
+		GetDequeBytes(&scene->m_entityManager.m_recycledEntityIndices)
+		+ GetDequeBytes(&scene->treePositionsBack) + GetDequeBytes(&scene->treePositionsFront)
+		+ GetDequeBytes(&scene->deferred);
+
+	entries[FOOTPRINT_ARENA].heapBytes = scene->arenaAllocator.size;
+
+	entries[FOOTPRINT_ATLAS].heapBytes = scene->atlas.entriesLength * sizeof(AtlasEntry);
+
+	// The atlas and the layers are only ever loaded together (see SceneSetupGraphics).
+	const bool loaded = scene->atlas.texture.id != 0;
+
+	entries[FOOTPRINT_ATLAS].vramBytes = loaded ? EstimateTextureBytes(scene->atlas.texture)
+												: (usize)ATLAS_WIDTH * ATLAS_HEIGHT * 4;
+
+	for (SceneLayer i = 0; i < SCENE_LAYER_TOTAL; ++i)
+	{
+		entries[FOOTPRINT_LAYERS].vramBytes += loaded
+			? EstimateRenderTextureBytes(SceneGetLayer(scene, i))
+			: EstimateLayerBytes(i, monitor);
+	}
+
+	return footprint;
+}
+
+void FootprintRaise(Footprint* peak, const Footprint* current)
+{
+	for (usize i = 0; i < FOOTPRINT_TOTAL; ++i)
+	{
+		FootprintEntry* entry = &peak->entries[i];
+		const FootprintEntry* other = &current->entries[i];
+
+		entry->staticBytes = MAX(entry->staticBytes, other->staticBytes);
+		entry->heapBytes = MAX(entry->heapBytes, other->heapBytes);
+		entry->vramBytes = MAX(entry->vramBytes, other->vramBytes);
+	}
+}
+
+FootprintBudget FootprintGetBudget(const FootprintSubsystem subsystem)
+{
+	return budgets[subsystem];
+}
+
+bool FootprintIsWithinBudget(const Footprint* self, const FootprintSubsystem subsystem)
+{
+	const FootprintEntry* entry = &self->entries[subsystem];
+	const FootprintBudget* budget = &budgets[subsystem];
+
+	return entry->staticBytes + entry->heapBytes <= budget->memoryBytes
+		   && entry->vramBytes <= budget->vramBytes;
+}
+
+void FootprintWriteReport(FILE* file, const Footprint* startup, const Footprint* peak)
+{
+	FootprintEntry startupTotal = { 0 };
+	FootprintEntry peakTotal = { 0 };
+
+	fprintf(
+		file,
+		"%-15s %10s %10s %10s %10s %10s %10s %10s\n",
+		"footprint (KiB)",
+		"static",
+		"heap",
+		"peak heap",
+		"budget",
+		"vram",
+		"peak vram",
+		"budget"
+	);
+
+	for (usize i = 0; i < FOOTPRINT_TOTAL; ++i)
+	{
+		const FootprintEntry* first = &startup->entries[i];
+		const FootprintEntry* most = &peak->entries[i];
+
+		fprintf(
+			file,
+			"%-15s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f%s\n",
+			names[i],
+			(f64)first->staticBytes / KIB,
+			(f64)first->heapBytes / KIB,
+			(f64)most->heapBytes / KIB,
+			(f64)budgets[i].memoryBytes / KIB,
+			(f64)first->vramBytes / KIB,
+			(f64)most->vramBytes / KIB,
+			(f64)budgets[i].vramBytes / KIB,
+			FootprintIsWithinBudget(peak, i) ? "" : " (over budget)"
+		);
+
+		startupTotal.staticBytes += first->staticBytes;
+		startupTotal.heapBytes += first->heapBytes;
+		startupTotal.vramBytes += first->vramBytes;
+		peakTotal.heapBytes += most->heapBytes;
+		peakTotal.vramBytes += most->vramBytes;
+	}
+
+	fprintf(
+		file,
+		"%-15s %10.1f %10.1f %10.1f %10s %10.1f %10.1f\n",
+		"total",
+		(f64)startupTotal.staticBytes / KIB,
+		(f64)startupTotal.heapBytes / KIB,
+		(f64)peakTotal.heapBytes / KIB,
+		"",
+		(f64)startupTotal.vramBytes / KIB,
+		(f64)peakTotal.vramBytes / KIB
+	);
+}
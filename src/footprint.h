@@ -0,0 +1,78 @@
+#pragma once
+
+#include "common.h"
+
+#include <raylib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+typedef struct Scene Scene;
+
+// Graphics that were never loaded (e.g. in a headless simulation) are measured as if they were
+// loaded on a monitor this large, so that their budgets can still be enforced.
+#define FOOTPRINT_REFERENCE_MONITOR_WIDTH (3840)
+#define FOOTPRINT_REFERENCE_MONITOR_HEIGHT (2160)
+
+// How many RenderSnapshots the game keeps around at most: one being drawn, one being taken, and the
+// latest one in between. They are counted whether or not they exist, just like graphics.
+#define FOOTPRINT_SNAPSHOTS_LENGTH (3)
+
+typedef enum
+{
+	// The Scene itself, not counting its Components.
+	FOOTPRINT_SCENE,
+	FOOTPRINT_COMPONENTS,
+	// The RenderSnapshots the scene is drawn from, including their Deques.
+	FOOTPRINT_SNAPSHOTS,
+	// Every InputStream the scene records into (read-only ones borrow a Replay's memory instead),
+	// including player one's own while a Replay is played back.
+	FOOTPRINT_INPUT_STREAMS,
+	// Every Deque the scene owns, at its current capacity.
+	FOOTPRINT_DEQUES,
+	FOOTPRINT_ARENA,
+	// The atlas' entries and its texture.
+	FOOTPRINT_ATLAS,
+	// Every render texture the scene loads (see SceneLayer).
+	FOOTPRINT_LAYERS,
+	FOOTPRINT_TOTAL,
+} FootprintSubsystem;
+
+typedef struct
+{
+	// Memory that is part of a struct, whether it ends up on the stack, heap, or in .bss.
+	usize staticBytes;
+	usize heapBytes;
+	// An estimate of the video memory that is held on to; textures are assumed to be stored
+	// uncompressed without mipmaps, and every render texture to have a 32-bit depth buffer (and
+	// 32-bit color, unless it is known otherwise).
+	usize vramBytes;
+} FootprintEntry;
+
+typedef struct
+{
+	FootprintEntry entries[FOOTPRINT_TOTAL];
+} Footprint;
+
+typedef struct
+{
+	// How much static and heap memory a subsystem may hold on to (combined).
+	usize memoryBytes;
+	usize vramBytes;
+} FootprintBudget;
+
+const char* FootprintGetName(FootprintSubsystem subsystem);
+
+// Adds up how much memory the scene holds on to right now, subsystem by subsystem.
+Footprint FootprintMeasure(const Scene* scene);
+// Like FootprintMeasure, but graphics that were never loaded are estimated for the given monitor
+// instead of the reference one.
+Footprint FootprintMeasureOnMonitor(const Scene* scene, Rectangle monitor);
+// Raises every entry of `peak` to the corresponding entry of `current` if the latter is larger.
+void FootprintRaise(Footprint* peak, const Footprint* current);
+
+FootprintBudget FootprintGetBudget(FootprintSubsystem subsystem);
+// Returns false if the given subsystem holds on to more memory (of either kind) than its budget.
+bool FootprintIsWithinBudget(const Footprint* self, FootprintSubsystem subsystem);
+
+// Writes a table of every subsystem's memory at startup and at its peak, next to its budget.
+void FootprintWriteReport(FILE* file, const Footprint* startup, const Footprint* peak);
@@ -1,66 +1,969 @@
 #include "game.h"
 
+#include "allocations.h"
 #include "common.h"
 #include "context.h"
+#include "counters.h"
+#include "footprint.h"
 #include "level.h"
+#include "./palette/p8.h"
+#include "profiler.h"
 #include "raylib.h"
+#include "replay_mapping.h"
 #include "scene.h"
+#include "sleeper.h"
+#include "startup.h"
 
 #include <math.h>
+#include <stdatomic.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-#if defined(BENCHMARKING)
-	#include "replay.h"
+#if defined(PLATFORM_WEB)
+	#include <emscripten/emscripten.h>
+#endif
 
-	#include <stdio.h>
-	#include <stdlib.h>
+// Define LOW_LATENCY to wait until the last moment before every vsync to sample input, simulate,
+// and draw (desktop only). Input is then only a fraction of a refresh old once it is presented,
+// rather than a whole one. This only works when all three happen back to back, hence the implied
+// SINGLE_THREADED.
+#if defined(PLATFORM_DESKTOP) && defined(LOW_LATENCY)
+	#define LATE_LATCH
+	#define SINGLE_THREADED
 #endif
 
-#if defined(PLATFORM_WEB)
-	#include <emscripten/emscripten.h>
+// Desktop builds simulate on a thread of their own, so that drawing and simulating cannot hold
+// each other up. Define SINGLE_THREADED to do everything on the main thread instead (like the web
+// build does), e.g. to compare frame times.
+#if defined(PLATFORM_DESKTOP) && !defined(SINGLE_THREADED)
+	#define SIMULATION_THREAD
+	#include <pthread.h>
+#endif
+
+// Desktop builds decode content and build the first stage on a thread of their own while the window
+// and graphics context come up (see StartLoading).
+#if defined(PLATFORM_DESKTOP)
+	#define LOADING_THREAD
+	#include <pthread.h>
+#endif
+
+// Desktop builds watch for simulated frames that take longer than SPIKE_BUDGET (in seconds; define
+// it to override the default), and save a Replay that leads right up to each one, along with how
+// long every section of that frame took (see CaptureSpike). Playing the Replay back with ltlr-sim
+// reproduces the spike. By default, only frames that take long enough to hold up the next one are
+// reported.
+#if defined(PLATFORM_DESKTOP)
+	#define SPIKE_WATCHDOG
+
+	#if !defined(SPIKE_BUDGET)
+		#define SPIKE_BUDGET (2 * CTX_DT)
+	#endif
+
+// How many seconds leading up to a spike are worth measuring again.
+	#define SPIKE_CONTEXT (3)
+// At most this many spikes are saved per session.
+	#define MAX_SPIKES (8)
 #endif
 
 #define FRAMERATE_SAMPLING_FREQUENCY (0.1F)
+#define FRAME_TIME_SAMPLING_FREQUENCY (1.0F)
+
+// How fast a Replay can be played back (relative to real time); zero means as fast as possible.
+#define TOTAL_PLAYBACK_SPEEDS (4)
+static const u8 playbackSpeeds[TOTAL_PLAYBACK_SPEEDS] = { 1, 2, 8, 0 };
+
+// The portion of a frame that unlimited playback spends simulating (the rest is left for drawing).
+#define UNLIMITED_PLAYBACK_BUDGET (0.75)
+
+// How many frames per second to draw while nobody is likely to be playing. The simulation keeps its
+// pace regardless, but catches up once per drawn frame instead of waking up for every frame.
+#define UNFOCUSED_FRAME_RATE (10)
+#define MENU_FRAME_RATE (30)
+
+// How often to find out whether vsync works again after it was found to be ineffective (in
+// seconds).
+#define VSYNC_CHECK_PERIOD (10)
 
 static const f32 targetFrameTime = CTX_DT;
 static const u8 maxFrameSkip = 25;
 static const f32 maxDeltaTime = maxFrameSkip * targetFrameTime;
-static f32 accumulator = 0.0F;
 static f64 previousTime = 0.0;
 
+#if !defined(SIMULATION_THREAD)
+static f32 accumulator = 0.0F;
+#endif
+
 static usize currentFrame;
 static f64 sampleTime;
 static usize sampleFrame;
 static f64 averageFps;
 
-static bool debugging;
+// The mean and standard deviation of how long drawn frames took (in seconds).
+static f64 frameTimeSampleTime;
+static usize frameTimeSamples;
+static f64 frameTimeSum;
+static f64 frameTimeSquaredSum;
+static f64 averageFrameTime;
+static f64 frameTimeDeviation;
+
+// How long it takes for sampled input to be presented (in seconds), averaged like frame times.
+static f64 latencySum;
+static usize latencySamples;
+static f64 averageLatency;
+
+// Frames simulated, as opposed to frames drawn (see currentFrame).
+static atomic_size_t simulatedFrames;
+static usize sampleSimulatedFrame;
+static f64 averageSimulatedFps;
+
+// Requests from whoever handles input, which the simulation applies before its next frame.
+static _Atomic(char*) requestedPlayback;
+static atomic_bool requestedSave;
+
+// A Replay (dropped onto the window) that is being played back.
+static ReplayMapping playback;
+static atomic_bool playingBack;
+static atomic_size_t playbackSpeedIndex;
+static f64 playbackStartTime;
+
+// Whether the debug overlay is showing; the simulation only snapshots what it needs while it is.
+static atomic_bool debugging;
+
+#if defined(PLATFORM_DESKTOP)
+static Image icon;
+#endif
+
+// The atlas is decoded while the window opens, and only uploaded once there is a graphics context.
+static Image atlasImage;
+
+static Scene scene;
+
+#if defined(LOADING_THREAD)
+static pthread_t loadingThread;
+static bool loading;
+#endif
+
+// How long the monitor takes to refresh (in seconds).
+static f64 refreshPeriod;
+
+// Whether presenting a frame does not actually wait for vsync (e.g. because it is unavailable or
+// ignored), in which case frames are limited to the refresh rate by sleeping instead.
+static bool vsyncIneffective;
+static f64 vsyncCheckTime;
+static f64 nextFrameTime;
+static Sleeper sleeper;
+
+#if defined(LATE_LATCH)
+
+// How many recent frames to consider when predicting how long the next one will take.
+	#define LATE_LATCH_HISTORY (32)
+// How much earlier than predicted to wake up, just in case (in seconds).
+	#define LATE_LATCH_MARGIN (0.002)
+
+static f64 frameCosts[LATE_LATCH_HISTORY];
+static usize frameCostsIndex;
+
+#endif
+
+// When the last frame was presented, and when the input it reflects was sampled.
+static f64 presentTime;
+static f64 latchTime;
+
+#if defined(SIMULATION_THREAD)
+
+// Indices into three buffers that hand something over from the simulation to drawing: one is being
+// read, one is being written, and the last one is whichever was published most recently. The
+// latter is marked TRIPLE_BUFFER_FRESH until it is picked up.
+typedef struct
+{
+	usize read;
+	usize written;
+	atomic_size_t latest;
+} TripleBuffer;
+
+	#define TRIPLE_BUFFER_FRESH ((usize)1 << 2)
+
+typedef struct
+{
+	RenderSnapshot render;
+	// When the snapshot's frame was simulated, and how long it lasts (both in seconds).
+	f64 time;
+	f64 duration;
+} Snapshot;
+
+	#define TOTAL_SNAPSHOTS (3)
+
+_Static_assert(TOTAL_SNAPSHOTS <= FOOTPRINT_SNAPSHOTS_LENGTH, "snapshots must fit the footprint");
+
+static Snapshot snapshots[TOTAL_SNAPSHOTS];
+static TripleBuffer snapshotBuffers;
+
+	#if defined(PROFILING)
+// The simulation's profiler is handed over separately, and only while the debug overlay shows it.
+static Profiler simulationProfilers[TOTAL_SNAPSHOTS];
+static TripleBuffer profilerBuffers;
+	#endif
+
+static pthread_t simulationThread;
+static atomic_bool simulating;
+
+// How many frames per second are drawn while idle (see GetIdleFrameRate), or zero if not idle.
+static atomic_uint idleFrameRate;
+
+static void TripleBufferInit(TripleBuffer* self)
+{
+	self->read = 0;
+	self->written = 1;
+	atomic_store(&self->latest, 2);
+}
+
+static bool TripleBufferIsFresh(const TripleBuffer* self)
+{
+	return (atomic_load(&self->latest) & TRIPLE_BUFFER_FRESH) != 0;
+}
+
+// Hands the buffer that was just written over to be read, and moves on to another one.
+static void TripleBufferPublish(TripleBuffer* self)
+{
+	self->written = atomic_exchange(&self->latest, self->written | TRIPLE_BUFFER_FRESH);
+	self->written &= ~TRIPLE_BUFFER_FRESH;
+}
+
+// Moves on to whichever buffer was published most recently, unless it has already been read.
+static void TripleBufferAcquire(TripleBuffer* self)
+{
+	if (TripleBufferIsFresh(self))
+	{
+		self->read = atomic_exchange(&self->latest, self->read) & ~TRIPLE_BUFFER_FRESH;
+	}
+}
+
+#else
+
+// The scene is drawn from a snapshot even when it is simulated on the same thread.
+static RenderSnapshot drawnSnapshot;
+
+#endif
+
+#if defined(PROFILING)
+// Each profiler belongs to the thread that respectively simulates or draws.
+static Profiler simulationProfiler;
+static Profiler drawingProfiler;
+
+// Written by the simulation thread; only read once it is done.
+static Footprint startupFootprint;
+static Footprint peakFootprint;
+
+	#define TRACE_PATH "trace.json"
+	#define FOOTPRINT_PATH "footprint.txt"
+#endif
+
+#if defined(SPIKE_WATCHDOG)
+
+// Everything needed to report a spike, copied out of the frame that spiked (see CaptureSpike).
+typedef struct
+{
+	u32 frame;
+	f64 duration;
+	u32 seed;
+	u8 replayFlags;
+	// Player one's input so far; unused if a Replay was being played back (it reproduces the spike
+	// on its own).
+	InputStream input;
+	bool playingBack;
+	#if defined(PROFILING)
+	const char* sectionNames[PROFILER_MAX_SECTIONS];
+	u8 sectionDepths[PROFILER_MAX_SECTIONS];
+	f32 sectionTimes[PROFILER_MAX_SECTIONS];
+	usize sectionsLength;
+	#endif
+} Spike;
+
+static usize spikes;
+// Filled in by the simulation while `spikePending` is false, and saved by the main thread once it
+// is true.
+static Spike spike;
+static atomic_bool spikePending;
+
+#endif
+
+// Everything that can be done before the window opens (and on any thread).
+static void LoadContent(void)
+{
+	usize phase = StartupBegin("LoadImage (atlas)");
+	atlasImage = LoadImage(DATADIR "content/atlas.png");
+	StartupEnd(phase);
+
+#if defined(PLATFORM_DESKTOP)
+	phase = StartupBegin("LoadImage (icon)");
+	icon = LoadImage(DATADIR "content/icon.png");
+	StartupEnd(phase);
+#endif
+
+	phase = StartupBegin("SceneInit");
+	SceneInit(&scene);
+	StartupEnd(phase);
+}
+
+#if defined(LOADING_THREAD)
+
+static void* RunLoading(UNUSED void* arg)
+{
+	StartupNameThread("Loader");
+
+	LoadContent();
+
+	return NULL;
+}
+
+#endif
+
+// Starts loading content in the background, if the platform allows for it.
+static void StartLoading(void)
+{
+#if defined(LOADING_THREAD)
+	loading = pthread_create(&loadingThread, NULL, RunLoading, NULL) == 0;
+
+	if (!loading)
+	{
+		TraceLog(LOG_WARNING, "Could not start the loading thread; loading on the main thread.");
+	}
+#endif
+}
+
+// Waits for StartLoading to finish, or loads everything right away if it never started.
+static void FinishLoading(void)
+{
+#if defined(LOADING_THREAD)
+	if (loading)
+	{
+		const usize phase = StartupBegin("wait for loading");
+		pthread_join(loadingThread, NULL);
+		StartupEnd(phase);
+
+		loading = false;
+
+		return;
+	}
+#endif
+
+	LoadContent();
+}
+
+void GameInitialize(void)
+{
+	ContextInit();
+
+#if defined(PROFILING)
+	ProfilerInit(&simulationProfiler);
+	ProfilerInit(&drawingProfiler);
+
+	TracingEnable();
+	TracingNameThread("Main");
+#endif
+
+	FinishLoading();
+
+	SceneSetupGraphics(&scene, &atlasImage);
+	UnloadImage(atlasImage);
+
+#if defined(SPIKE_WATCHDOG)
+	// Sized up front, so that capturing a spike never has to allocate.
+	spike.input = InputStreamCreate(
+		scene.inputStreams[0].totalBindings,
+		scene.inputStreams[0].capacity
+	);
+#endif
+
+#if defined(PROFILING)
+	startupFootprint = FootprintMeasure(&scene);
+	peakFootprint = startupFootprint;
+#endif
+
+#if defined(SIMULATION_THREAD)
+	for (usize i = 0; i < TOTAL_SNAPSHOTS; ++i)
+	{
+		SceneInitSnapshot(&snapshots[i].render);
+		SceneTakeSnapshot(&snapshots[i].render, &scene);
+	}
+
+	TripleBufferInit(&snapshotBuffers);
+
+	#if defined(PROFILING)
+	for (usize i = 0; i < TOTAL_SNAPSHOTS; ++i)
+	{
+		ProfilerInit(&simulationProfilers[i]);
+	}
+
+	TripleBufferInit(&profilerBuffers);
+	#endif
+#else
+	SceneInitSnapshot(&drawnSnapshot);
+#endif
+}
+
+static void SetPlaybackSpeed(const usize index)
+{
+	atomic_store(&playbackSpeedIndex, index);
+
+#if !defined(SIMULATION_THREAD)
+	// Presenting a frame should not block the simulation when it is running as fast as possible.
+	if (playbackSpeeds[index] == 0)
+	{
+		ClearWindowState(FLAG_VSYNC_HINT);
+	}
+	else
+	{
+		SetWindowState(FLAG_VSYNC_HINT);
+	}
+#endif
+}
+
+// Returns how many times faster than real time the scene should be simulated (see playbackSpeeds).
+static u8 GetSimulationSpeed(void)
+{
+	if (!atomic_load(&playingBack))
+	{
+		return 1;
+	}
+
+	return playbackSpeeds[atomic_load(&playbackSpeedIndex)];
+}
+
+static void StartPlayback(const char* path)
+{
+	const ReplayMappingResult result = ReplayMappingTryOpen(path);
+
+	if (result.type == REPLAY_RESULT_TYPE_ERR)
+	{
+		const char* error = StringFromReplayError(result.contents.err);
+
+		TraceLog(LOG_WARNING, "Could not play %s: %s", path, error);
+		return;
+	}
+
+	// The scene's InputStream borrows the Replay, so the previous one has to outlive the swap.
+	SceneStartPlayback(&scene, &result.contents.ok.replay);
+
+	if (atomic_load(&playingBack))
+	{
+		ReplayMappingDestroy(&playback);
+	}
+
+	playback = result.contents.ok;
+	playbackStartTime = GetTime();
+	atomic_store(&playingBack, true);
+
+	SceneReseed(&scene, playback.replay.seed, playback.replay.flags);
+
+	TraceLog(LOG_INFO, "Playing %s (%zu frames).", path, playback.replay.length);
+}
+
+// Hands player one back to whoever is at the keyboard, right where the Replay left off. Recording
+// carries on too, since SceneReseed restarted it with the Replay's seed and flags.
+static void StopPlayback(void)
+{
+	SceneStopPlayback(&scene);
+	ReplayMappingDestroy(&playback);
+	atomic_store(&playingBack, false);
+
+	TraceLog(LOG_INFO, "Replay over; player one is live again.");
+}
+
+#if defined(PROFILING)
+
+static void SaveTrace(void)
+{
+	if (!TracingSave(TRACE_PATH))
+	{
+		TraceLog(LOG_WARNING, "Could not save %s.", TRACE_PATH);
+		return;
+	}
+
+	TraceLog(LOG_INFO, "Saved %s.", TRACE_PATH);
+
+	#if defined(PLATFORM_WEB)
+	EM_ASM({ saveFileFromMEMFSToDisk(UTF8ToString($0), "trace.json"); }, TRACE_PATH);
+	#endif
+}
+
+static void SaveFootprint(void)
+{
+	FILE* file = fopen(FOOTPRINT_PATH, "w");
+
+	if (file == NULL)
+	{
+		TraceLog(LOG_WARNING, "Could not save %s.", FOOTPRINT_PATH);
+		return;
+	}
+
+	FootprintWriteReport(file, &startupFootprint, &peakFootprint);
+	fclose(file);
+
+	TraceLog(LOG_INFO, "Saved %s.", FOOTPRINT_PATH);
+
+	for (FootprintSubsystem i = 0; i < FOOTPRINT_TOTAL; ++i)
+	{
+		if (!FootprintIsWithinBudget(&peakFootprint, i))
+		{
+			const char* name = FootprintGetName(i);
+			TraceLog(LOG_WARNING, "The %s subsystem went over its memory budget.", name);
+		}
+	}
+}
+
+#endif
+
+// Handles keys that control the game itself rather than what happens in it. This must run on the
+// main thread, right after input is polled.
+static void UpdateHotkeys(void)
+{
+#if defined(PLATFORM_DESKTOP)
+	if (IsKeyPressed(KEY_F11))
+	{
+		ToggleFullscreenShim();
+	}
+#endif
+
+	if (IsKeyPressed(KEY_EQUAL))
+	{
+		atomic_store(&debugging, !atomic_load(&debugging));
+	}
+
+	if (IsKeyPressed(KEY_MINUS))
+	{
+		atomic_store(&requestedSave, true);
+	}
+
+#if defined(PROFILING)
+	if (IsKeyPressed(KEY_F9))
+	{
+		SaveTrace();
+	}
+#endif
+
+	if (IsFileDropped())
+	{
+		FilePathList files = LoadDroppedFiles();
+
+		if (files.count > 0)
+		{
+			const usize size = strlen(files.paths[0]) + 1;
+
+			char* path = malloc(size);
+			memcpy(path, files.paths[0], size);
+
+			// Only the most recently dropped file matters.
+			free(atomic_exchange(&requestedPlayback, path));
+		}
+
+		UnloadDroppedFiles(files);
+	}
+
+	if (atomic_load(&playingBack) && IsKeyPressed(KEY_TAB))
+	{
+		SetPlaybackSpeed((atomic_load(&playbackSpeedIndex) + 1) % TOTAL_PLAYBACK_SPEEDS);
+	}
+}
+
+// Applies any request made by UpdateHotkeys; this must run wherever the scene is simulated.
+static void ApplyRequests(void)
+{
+	scene.debugging = atomic_load(&debugging);
+
+	char* path = atomic_exchange(&requestedPlayback, NULL);
+
+	if (path != NULL)
+	{
+		StartPlayback(path);
+		free(path);
+	}
+
+	if (atomic_exchange(&requestedSave, false))
+	{
+		SceneSaveRecording(&scene);
+	}
+
+	if (!atomic_load(&playingBack) || scene.frame < playback.replay.length)
+	{
+		return;
+	}
+
+	if (atomic_load(&playbackSpeedIndex) != 0)
+	{
+		const f64 elapsed = GetTime() - playbackStartTime;
+
+		TraceLog(
+			LOG_INFO,
+			"Replay finished: %zu frames in %.2fs (%.f frames/s).",
+			playback.replay.length,
+			elapsed,
+			playback.replay.length / elapsed
+		);
+
+		SetPlaybackSpeed(0);
+	}
+
+	StopPlayback();
+}
+
+#if defined(SPIKE_WATCHDOG)
+
+// Copies what is needed to reproduce the frame that was just simulated (which took the given amount
+// of time), without allocating or touching the disk; SaveSpike does the rest later on. If the
+// previous spike has not been saved yet, this one is dropped.
+static void CaptureSpike(const f64 duration)
+{
+	if (spikes >= MAX_SPIKES || atomic_load_explicit(&spikePending, memory_order_acquire))
+	{
+		return;
+	}
+
+	spikes += 1;
+
+	spike.frame = scene.frame - 1;
+	spike.duration = duration;
+	spike.seed = scene.seed;
+	spike.replayFlags = scene.replayFlags;
+	spike.playingBack = scene.inputStreams[0].readOnly;
+
+	if (!spike.playingBack)
+	{
+		InputStreamCopy(&spike.input, &scene.inputStreams[0]);
+	}
+
+	#if defined(PROFILING)
+	const usize latest = (simulationProfiler.frames - 1) % PROFILER_HISTORY;
+
+	spike.sectionsLength = simulationProfiler.sectionsLength;
+
+	for (usize i = 0; i < simulationProfiler.sectionsLength; ++i)
+	{
+		const ProfilerSection* section = &simulationProfiler.sections[i];
+
+		spike.sectionNames[i] = section->name;
+		spike.sectionDepths[i] = section->depth;
+		spike.sectionTimes[i] = section->history[latest];
+	}
+	#endif
+
+	atomic_store_explicit(&spikePending, true, memory_order_release);
+}
+
+// Writes out the spike captured by CaptureSpike, if any, along with a Replay that leads right up to
+// it. The simulation can only be reproduced from its very first frame, so the Replay starts there;
+// the report says which frames actually led up to the spike. This runs on the main thread.
+static void SaveSpike(void)
+{
+	if (!atomic_load_explicit(&spikePending, memory_order_acquire))
+	{
+		return;
+	}
+
+	const u32 frame = spike.frame;
+
+	char replayPath[32];
+	char reportPath[32];
+	snprintf(replayPath, sizeof(replayPath), "spike_%u.ltlrr", frame);
+	snprintf(reportPath, sizeof(reportPath), "spike_%u.txt", frame);
+
+	if (!spike.playingBack)
+	{
+		ReplayResult result = ReplayTryFromInputStreamUntil(spike.seed, &spike.input, frame + 1);
+
+		if (result.type == REPLAY_RESULT_TYPE_OK)
+		{
+			Replay* replay = &result.contents.ok;
+			replay->flags = spike.replayFlags;
+
+			ReplayBytes bytes = ReplayBytesFromReplay(replay);
+			FILE* file = fopen(replayPath, "wb");
+
+			if (file != NULL)
+			{
+				fwrite(bytes.data, 1, bytes.size, file);
+				fclose(file);
+			}
+
+			ReplayBytesDestroy(&bytes);
+			ReplayDestroy(replay);
+		}
+		else
+		{
+			const char* error = StringFromReplayError(result.contents.err);
+
+			TraceLog(LOG_WARNING, "Could not save the spike at frame %u: %s", frame, error);
+		}
+	}
+
+	FILE* file = fopen(reportPath, "w");
+
+	if (file == NULL)
+	{
+		TraceLog(LOG_WARNING, "Could not save the spike at frame %u.", frame);
+		atomic_store_explicit(&spikePending, false, memory_order_release);
+		return;
+	}
+
+	const u32 context = MIN(frame, SPIKE_CONTEXT * CTX_FPS);
+
+	fprintf(file, "frame: %u\n", frame);
+	fprintf(file, "time: %.3f ms (budget %.3f ms)\n", spike.duration * 1000, SPIKE_BUDGET * 1000);
+
+	if (spike.playingBack)
+	{
+		fprintf(file, "replay: the one that was being played back\n");
+	}
+	else
+	{
+		fprintf(file, "replay: %s (ltlr-sim --replay %s --profile)\n", replayPath, replayPath);
+	}
+
+	fprintf(file, "leading up to it: frames %u through %u\n", frame - context, frame);
+
+	#if defined(PROFILING)
+	// Break the frame down by section (nested sections are indented).
+	for (usize i = 0; i < spike.sectionsLength; ++i)
+	{
+		fprintf(
+			file,
+			"%*s%s: %.3f ms\n",
+			spike.sectionDepths[i] * 2,
+			"",
+			spike.sectionNames[i],
+			spike.sectionTimes[i] * 1000
+		);
+	}
+	#else
+	fprintf(file, "(build with PROFILING defined for a breakdown of the frame)\n");
+	#endif
+
+	fclose(file);
+
+	TraceLog(
+		LOG_WARNING,
+		"Frame %u took %.3f ms; saved %s.",
+		frame,
+		spike.duration * 1000,
+		reportPath
+	);
+
+	atomic_store_explicit(&spikePending, false, memory_order_release);
+}
+
+#endif
+
+#if defined(PROFILING)
+// Only building a stage should ever need the heap; point out anything else that does.
+static void WarnAboutAllocations(const CounterSample* counters)
+{
+	AllocationSite sites[ALLOCATIONS_MAX_SITES];
+	const usize sitesLength = AllocationsTakeSites(sites);
+
+	if (counters->values[COUNTER_STAGE_BUILDS] != 0)
+	{
+		return;
+	}
+
+	for (usize i = 0; i < sitesLength; ++i)
+	{
+		char buffer[64];
+
+		TraceLog(
+			LOG_WARNING,
+			"Frame %zu allocated %lld time(s) at %s.",
+			scene.frame - 1,
+			(long long)sites[i].count,
+			AllocationsDescribeSite(&sites[i], buffer, sizeof(buffer))
+		);
+	}
+}
+#endif
+
+void GameUpdate(void)
+{
+#if defined(SPIKE_WATCHDOG)
+	const f64 start = GetTime();
+#endif
+
+#if defined(PROFILING)
+	ProfilerBeginFrame(&simulationProfiler);
+#endif
+
+	SceneUpdate(&scene);
+
+#if defined(PROFILING)
+	ProfilerEndFrame(&simulationProfiler);
+
+	// Counters are traced by name alone, so drawing (see GameDraw) traces its own separately.
+	const CounterSample counters = CountersSample();
+
+	for (Counter i = 0; i < COUNTER_TOTAL; ++i)
+	{
+		if (i != COUNTER_ATLAS_DRAWS)
+		{
+			PROFILE_COUNTER(CounterGetName(i), counters.values[i]);
+		}
+	}
+
+	WarnAboutAllocations(&counters);
+
+	const Footprint footprint = FootprintMeasure(&scene);
+	FootprintRaise(&peakFootprint, &footprint);
+#endif
+
+	atomic_fetch_add(&simulatedFrames, 1);
+
+#if defined(SPIKE_WATCHDOG)
+	const f64 duration = GetTime() - start;
+
+	if (duration > SPIKE_BUDGET)
+	{
+		CaptureSpike(duration);
+	}
+#endif
+}
+
+// Returns the snapshot of the scene that is being drawn.
+static const RenderSnapshot* GetDrawnSnapshot(void)
+{
+#if defined(SIMULATION_THREAD)
+	return &snapshots[snapshotBuffers.read].render;
+#else
+	return &drawnSnapshot;
+#endif
+}
+
+#if defined(PROFILING)
+
+// Draws a graph of how long each of the most recent frames took, stacked by top-level section,
+// followed by a table of every section's min, average, p99, and max (in milliseconds).
+static void DrawProfiler(const Profiler* profiler, const char* title, const Vector2 position)
+{
+	static const usize fontSize = 10;
+	static const f32 width = 300;
+	static const f32 padding = 4;
+	static const f32 graphHeight = 60;
+	// The graph fits frames that take up to twice as long as they should.
+	static const f32 graphRange = CTX_DT * 2;
+
+	const f32 rowHeight = fontSize + 2;
+	const f32 height = padding * 3 + graphHeight + rowHeight * (profiler->sectionsLength + 2);
+
+	const Color backgroundColor = (Color) {
+		.r = 0,
+		.g = 0,
+		.b = 0,
+		.a = 150,
+	};
+	DrawRectangle(position.x, position.y, width, height, backgroundColor);
+
+	// Graph the most recent frames from left to right.
+	{
+		const f32 bottom = position.y + padding + graphHeight;
+		const f32 columnWidth = (width - padding * 2) / PROFILER_HISTORY;
+		const usize frames = MIN(profiler->frames, PROFILER_HISTORY);
+
+		for (usize i = 0; i < frames; ++i)
+		{
+			const usize index = (profiler->frames - frames + i) % PROFILER_HISTORY;
+			const f32 x = position.x + padding + (PROFILER_HISTORY - frames + i) * columnWidth;
+
+			f32 y = bottom;
+
+			for (usize j = 0; j < profiler->sectionsLength; ++j)
+			{
+				const ProfilerSection* section = &profiler->sections[j];
+
+				// Nested sections are already part of whichever section they ran inside of.
+				if (section->depth != 0)
+				{
+					continue;
+				}
+
+				const f32 sectionHeight = section->history[index] / graphRange * graphHeight;
+				const Color color = P8PaletteGet(1 + j % (P8_PALETTE_LENGTH - 1));
+
+				y -= sectionHeight;
+				DrawRectangleRec((Rectangle) { x, y, columnWidth, sectionHeight }, color);
+			}
+
+			// Whatever is left of the frame was spent outside of any section.
+			const f32 frameHeight = profiler->frameTimes[index] / graphRange * graphHeight;
+			const f32 top = MAX(bottom - frameHeight, position.y + padding);
+
+			if (top < y)
+			{
+				DrawRectangleRec((Rectangle) { x, top, columnWidth, y - top }, P8_DARK_GRAY);
+			}
+		}
+
+		// Mark how long a frame should take.
+		const f32 budget = bottom - CTX_DT / graphRange * graphHeight;
+		DrawRectangle(position.x + padding, budget, width - padding * 2, 1, COLOR_WHITE);
+	}
+
+	// Tabulate every section.
+	{
+		const f32 columns[4] = { 150, 185, 220, 255 };
+
+		f32 y = position.y + padding * 2 + graphHeight;
+
+		DrawText(title, position.x + padding, y, fontSize, COLOR_WHITE);
+		DrawText("min", position.x + columns[0], y, fontSize, COLOR_WHITE);
+		DrawText("avg", position.x + columns[1], y, fontSize, COLOR_WHITE);
+		DrawText("p99", position.x + columns[2], y, fontSize, COLOR_WHITE);
+		DrawText("max", position.x + columns[3], y, fontSize, COLOR_WHITE);
+
+		for (usize i = 0; i <= profiler->sectionsLength; ++i)
+		{
+			y += rowHeight;
 
-#if defined(PLATFORM_DESKTOP)
-static Image icon;
-#endif
+			// The first row covers whole frames.
+			const bool whole = i == 0;
+			const ProfilerSection* section = whole ? NULL : &profiler->sections[i - 1];
 
-static Scene scene;
+			const ProfilerStats stats = whole ? ProfilerGetFrameStats(profiler)
+											  : ProfilerGetSectionStats(profiler, i - 1);
 
-void GameInitialize(void)
-{
-	ContextInit();
+			const char* name = whole ? "Frame" : section->name;
+			const f32 indent = whole ? 0 : section->depth * 6;
+			const Color color = whole || section->depth != 0
+				? P8_LIGHT_GRAY
+				: P8PaletteGet(1 + (i - 1) % (P8_PALETTE_LENGTH - 1));
 
-	SceneInit(&scene);
+			DrawText(name, position.x + padding + indent, y, fontSize, color);
+
+			const f32 values[4] = { stats.min, stats.average, stats.p99, stats.max };
+
+			for (usize j = 0; j < 4; ++j)
+			{
+				const char* text = TextFormat("%.2f", values[j] * 1000);
+				DrawText(text, position.x + columns[j], y, fontSize, COLOR_WHITE);
+			}
+		}
+	}
 }
 
-void GameUpdate(void)
+// Returns the simulation's profiler as of the most recent frame.
+static const Profiler* GetSimulationProfiler(void)
 {
-	if (IsKeyPressed(KEY_EQUAL))
-	{
-		debugging = !debugging;
-	}
+	#if defined(SIMULATION_THREAD)
+	TripleBufferAcquire(&profilerBuffers);
 
-	SceneUpdate(&scene);
+	return &simulationProfilers[profilerBuffers.read];
+	#else
+	return &simulationProfiler;
+	#endif
 }
 
+#endif
+
 static void DrawDebugInformation(void)
 {
-	if (!debugging)
+	if (!atomic_load(&debugging))
 	{
 		return;
 	}
@@ -94,7 +997,23 @@ static void DrawDebugInformation(void)
 		static const usize xPadding = 8;
 		static const usize yPadding = 8;
 
-		const char* text = TextFormat("%.f FPS", averageFps);
+		const char* text = TextFormat(
+			"%.f FPS (%.2f ms, sd %.2f ms, %.1f ms latency)",
+			averageFps,
+			averageFrameTime * 1000,
+			frameTimeDeviation * 1000,
+			averageLatency * 1000
+		);
+
+		// Also show how many frames are simulated per second.
+		if (atomic_load(&playingBack))
+		{
+			const u8 speed = playbackSpeeds[atomic_load(&playbackSpeedIndex)];
+
+			text = speed == 0 ? TextFormat("%s %.f SPS (MAX)", text, averageSimulatedFps)
+							  : TextFormat("%s %.f SPS (%ux)", text, averageSimulatedFps, speed);
+		}
+
 		const usize textWidth = MeasureText(text, fontSize);
 
 		const Color backgroundColor = (Color) {
@@ -113,100 +1032,501 @@ static void DrawDebugInformation(void)
 
 		DrawText(text, x + xPadding + 2, y + yPadding + 2, fontSize, COLOR_BLACK);
 		DrawText(text, x + xPadding, y + yPadding, fontSize, COLOR_WHITE);
+
+#if defined(PROFILING)
+		const f32 profilerY = y + fontSize + yPadding * 3;
+
+		DrawProfiler(GetSimulationProfiler(), "Simulation", (Vector2) { x, profilerY });
+		DrawProfiler(&drawingProfiler, "Drawing", (Vector2) { x + 310, profilerY });
+#endif
 	}
 	EndMode2D();
 }
 
 void GameDraw(void)
 {
-	SceneDraw(&scene);
+#if !defined(SIMULATION_THREAD)
+	SceneTakeSnapshot(&drawnSnapshot, &scene);
+#endif
+
+#if defined(PROFILING)
+	ProfilerBeginFrame(&drawingProfiler);
+#endif
+
+	SceneDraw(&scene, GetDrawnSnapshot());
+
+#if defined(PROFILING)
+	ProfilerEndFrame(&drawingProfiler);
+
+	const CounterSample counters = CountersSample();
+	const Counter draws = COUNTER_ATLAS_DRAWS;
+
+	PROFILE_COUNTER(CounterGetName(draws), counters.values[draws]);
+#endif
 
 	DrawDebugInformation();
 }
 
-static void Timestep(void)
+static void UpdateRefreshPeriod(void)
 {
-	const f64 currentTime = GetTime();
+	const i32 refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
 
-	f32 deltaTime = currentTime - previousTime;
+	refreshPeriod = refreshRate > 0 ? 1.0 / refreshRate : targetFrameTime;
+}
 
-	// Calculate the average frames per second.
+static void MeasureFrame(const f64 currentTime, const f64 frameTime)
+{
+	// Calculate the average frames per second (both drawn and simulated).
 	{
 		currentFrame += 1;
 
 		if ((currentTime - sampleTime) >= FRAMERATE_SAMPLING_FREQUENCY)
 		{
+			const usize frames = atomic_load(&simulatedFrames);
+
 			averageFps = (currentFrame - sampleFrame) / (currentTime - sampleTime);
+			averageSimulatedFps = (frames - sampleSimulatedFrame) / (currentTime - sampleTime);
+
+#if defined(PLATFORM_DESKTOP)
+			// Frames should never be presented faster than the display refreshes; if they are,
+			// vsync is not doing its job. Note that unlimited playback turns vsync off on purpose.
+			if (averageFps * refreshPeriod > 1.25 && GetSimulationSpeed() != 0)
+			{
+				vsyncIneffective = true;
+				vsyncCheckTime = currentTime;
+			}
+			// Sleeping in its place hides whether vsync works again (e.g. after the window moved
+			// to another monitor), so every so often, stop sleeping and see.
+			else if (vsyncIneffective && currentTime - vsyncCheckTime >= VSYNC_CHECK_PERIOD)
+			{
+				vsyncIneffective = false;
+				UpdateRefreshPeriod();
+			}
+#endif
 
 			sampleFrame = currentFrame;
+			sampleSimulatedFrame = frames;
 			sampleTime = currentTime;
 		}
 	}
 
-	// Set a maximum delta time in order to avoid a "spiral of death."
-	if (deltaTime > maxDeltaTime)
+	// Calculate how much frame times vary.
+	{
+		frameTimeSamples += 1;
+		frameTimeSum += frameTime;
+		frameTimeSquaredSum += frameTime * frameTime;
+
+		if ((currentTime - frameTimeSampleTime) >= FRAME_TIME_SAMPLING_FREQUENCY)
+		{
+			averageFrameTime = frameTimeSum / frameTimeSamples;
+
+			const f64 variance =
+				(frameTimeSquaredSum / frameTimeSamples) - (averageFrameTime * averageFrameTime);
+			frameTimeDeviation = sqrt(MAX(variance, 0));
+
+			averageLatency = latencySamples == 0 ? 0 : latencySum / latencySamples;
+
+			frameTimeSamples = 0;
+			frameTimeSum = 0;
+			frameTimeSquaredSum = 0;
+			latencySamples = 0;
+			latencySum = 0;
+			frameTimeSampleTime = currentTime;
+		}
+	}
+}
+
+// Returns how many frames per second to draw while nobody is likely to be watching closely, or zero
+// if somebody might be.
+static u32 GetIdleFrameRate(void)
+{
+	if (atomic_load(&playingBack))
+	{
+		return 0;
+	}
+
+	if (!IsWindowFocused())
 	{
-		deltaTime = maxDeltaTime;
+		return UNFOCUSED_FRAME_RATE;
 	}
 
-	previousTime = currentTime;
+	if (GetDrawnSnapshot()->state == SCENE_STATE_MENU)
+	{
+		return MENU_FRAME_RATE;
+	}
+
+	return 0;
+}
+
+// Returns the least amount of time between the start of two frames (in seconds), or zero if frames
+// are only paced by vsync.
+static f64 GetFramePeriod(const u32 idleFrameRate)
+{
+	if (idleFrameRate != 0)
+	{
+		return 1.0 / idleFrameRate;
+	}
+
+	return vsyncIneffective ? refreshPeriod : 0;
+}
+
+#if defined(SIMULATION_THREAD)
+
+// Input is sampled and timestamped here, but only applied once the simulation gets to it.
+static void SampleInput(void)
+{
+	PollInputEvents();
+	UpdateHotkeys();
+	SceneSampleInput(&scene, GetTime());
+}
+
+#endif
+
+// Waits until the next frame is due (see GetFramePeriod) without hogging the CPU.
+static void LimitFrameRate(void)
+{
+	const u32 idle = GetIdleFrameRate();
+	const f64 period = GetFramePeriod(idle);
+
+#if defined(SIMULATION_THREAD)
+	atomic_store(&idleFrameRate, idle);
+#endif
+
+#if defined(PLATFORM_WEB)
+	// Browsers decide when to run the next frame; ask for fewer of them rather than blocking.
+	static f64 requestedPeriod = 0;
+
+	if (period != requestedPeriod)
+	{
+		if (period == 0)
+		{
+			emscripten_set_main_loop_timing(EM_TIMING_RAF, 1);
+		}
+		else
+		{
+			emscripten_set_main_loop_timing(EM_TIMING_SETTIMEOUT, period * 1000);
+		}
+
+		requestedPeriod = period;
+	}
+#else
+	if (period == 0)
+	{
+		return;
+	}
+
+	if (idle != 0)
+	{
+		// Nobody minds a frame being a millisecond late now, so do not spin to be on time; input
+		// is only sampled once per frame as well.
+		SleeperSleepUntil(nextFrameTime);
+	}
+	else
+	{
+#if defined(SIMULATION_THREAD)
+		// The simulation does not wait on frames to be drawn, so neither should its input; keep
+		// sampling at least once per simulated frame if the display refreshes slower than that.
+		while (GetTime() + targetFrameTime < nextFrameTime)
+		{
+			SleeperSleepUntil(GetTime() + targetFrameTime);
+			SampleInput();
+		}
+#endif
+
+		SleeperWaitUntil(&sleeper, nextFrameTime);
+	}
+
+	// If a frame ran late, start the next one right away rather than trying to catch up.
+	nextFrameTime = MAX(nextFrameTime + period, GetTime());
+#endif
+}
+
+// Presents the frame that was just drawn and measures how old the input it reflects is by now.
+// Note that this assumes that presenting waits for vsync; the actual latency is even higher, as it
+// also takes time for the display to show the frame.
+static void Present(void)
+{
+	SwapScreenBuffer();
+
+	presentTime = GetTime();
+
+	if (!StartupIsFinished())
+	{
+		StartupFinish();
+
+		TraceLog(
+			LOG_INFO,
+			"STARTUP: Presented the first frame after %.2f ms.",
+			StartupGetTimeToFirstFrame() * 1e3
+		);
+
+#if defined(PROFILING)
+		StartupWriteReport(stdout);
+#endif
+	}
+
+	latencySum += presentTime - latchTime;
+	latencySamples += 1;
+}
+
+#if defined(SIMULATION_THREAD)
+
+// Copies what is drawn of the scene into a snapshot and hands it over to be drawn.
+static void PublishSnapshot(const f64 time, const f64 duration)
+{
+	Snapshot* snapshot = &snapshots[snapshotBuffers.written];
+
+	SceneTakeSnapshot(&snapshot->render, &scene);
+	snapshot->time = time;
+	snapshot->duration = duration;
+
+	TripleBufferPublish(&snapshotBuffers);
+
+#if defined(PROFILING)
+	if (scene.debugging)
+	{
+		simulationProfilers[profilerBuffers.written] = simulationProfiler;
+		TripleBufferPublish(&profilerBuffers);
+	}
+#endif
+}
+
+static void* RunSimulation(UNUSED void* arg)
+{
+#if defined(PROFILING)
+	TracingNameThread("Simulation");
+#endif
+
+	Sleeper simulationSleeper = SleeperCreate();
 
-	accumulator += deltaTime;
+	f64 next = GetTime();
 
-	while (accumulator >= targetFrameTime)
+	while (atomic_load(&simulating))
 	{
+		const u8 speed = GetSimulationSpeed();
+		const f64 duration = speed == 0 ? 0 : targetFrameTime / speed;
+
+		const f64 currentTime = GetTime();
+
+		if (currentTime < next)
+		{
+			const u32 idle = atomic_load(&idleFrameRate);
+
+			if (idle != 0 && duration != 0)
+			{
+				// While idle, catch up on a drawn frame's worth of frames at once rather than
+				// waking up for each of them.
+				SleeperSleepUntil(next + 1.0 / idle - duration);
+			}
+			else
+			{
+				SleeperWaitUntil(&simulationSleeper, next);
+			}
+
+			continue;
+		}
+
+		// Just like Timestep, never try to catch up on more than a handful of frames at once in
+		// order to avoid a "spiral of death."
+		next = MAX(next, currentTime - maxDeltaTime * MAX(speed, 1));
+
+		ApplyRequests();
+
+		// Only apply input that was sampled before this frame was due.
+		scene.inputDeadline = next;
+
 		GameUpdate();
 
-		accumulator -= targetFrameTime;
 		ContextSetTotalTime(ContextGetTotalTime() + targetFrameTime);
 
-		PollInputEvents();
+		const bool drawnSinceLastPublish = !TripleBufferIsFresh(&snapshotBuffers);
+
+		// When simulating as fast as possible, only bother with a snapshot if it will be drawn.
+		if (duration != 0 || drawnSinceLastPublish)
+		{
+			PublishSnapshot(next, duration);
+		}
+
+		next = duration == 0 ? currentTime : next + duration;
 	}
 
-	ContextSetAlpha(accumulator / targetFrameTime);
+	return NULL;
+}
+
+static void Timestep(void)
+{
+	LimitFrameRate();
+
+	const f64 currentTime = GetTime();
+
+	MeasureFrame(currentTime, currentTime - previousTime);
+
+	previousTime = currentTime;
+
+	SampleInput();
+
+	TripleBufferAcquire(&snapshotBuffers);
+
+	// Interpolate between the snapshot's previous and current frame based on how long ago it was
+	// simulated.
+	{
+		const Snapshot* snapshot = &snapshots[snapshotBuffers.read];
+
+		f32 alpha = 1;
+
+		if (snapshot->duration != 0)
+		{
+			const f64 elapsed = GetTime() - snapshot->time;
+
+			alpha = MIN(MAX(elapsed / snapshot->duration, 0), 1);
+		}
+
+		ContextSetAlpha(alpha);
+
+		latchTime = snapshot->time;
+	}
 
 	GameDraw();
 
-	SwapScreenBuffer();
+	Present();
+
+#if defined(SPIKE_WATCHDOG)
+	SaveSpike();
+#endif
 }
 
-void GameRun(void)
+#else
+
+static void SimulateFrame(void)
 {
-#if defined(BENCHMARKING)
-	SetTraceLogLevel(LOG_NONE);
-	SceneInit(&scene);
+	// Sample input right before simulating; anything that happened while the previous frame was
+	// being presented is used now rather than a frame later (see benches/input_latency.c). Since
+	// sampling and simulating happen back to back, the frame simply consumes everything sampled so
+	// far; the InputQueue's timestamps only matter when the simulation has a thread of its own.
+	PollInputEvents();
 
-	u32 size;
-	const u8* data = LoadFileData("baseline.ltlrr", &size);
+	UpdateHotkeys();
+	ApplyRequests();
 
-	ReplayResult result = ReplayTryFromBytes(data, size);
+	const f64 sampleTime = GetTime();
 
-	if (result.type == REPLAY_RESULT_TYPE_ERR)
+	SceneSampleInput(&scene, sampleTime);
+	scene.inputDeadline = sampleTime;
+	latchTime = sampleTime;
+
+	GameUpdate();
+
+	ContextSetTotalTime(ContextGetTotalTime() + targetFrameTime);
+}
+
+#if defined(LATE_LATCH)
+
+// Sleeps until the last moment a frame can be started and still be ready in time for the next
+// vsync, judging by how long recent frames took.
+static void WaitForLatch(void)
+{
+	f64 predictedCost = 0;
+
+	for (usize i = 0; i < LATE_LATCH_HISTORY; ++i)
+	{
+		predictedCost = MAX(predictedCost, frameCosts[i]);
+	}
+
+	const f64 wakeTime = presentTime + refreshPeriod - predictedCost - LATE_LATCH_MARGIN;
+	const f64 currentTime = GetTime();
+
+	if (wakeTime > currentTime)
 	{
-		fprintf(stderr, "%s\n", StringFromReplayError(result.contents.err));
-		exit(EXIT_FAILURE);
+		SleeperWaitUntil(&sleeper, wakeTime);
 	}
+}
 
-	bool loaded = InputStreamLoadReplay(&scene.inputStreams[0], &result.contents.ok);
+#endif
 
-	if (!loaded)
+static void Timestep(void)
+{
+	// Unlimited playback spends any spare time simulating instead.
+	if (GetSimulationSpeed() != 0)
 	{
-		fprintf(stderr, "Replay is too long to fit inside InputStream.\n");
-		exit(EXIT_FAILURE);
+		LimitFrameRate();
 	}
 
-	scene.seed = result.contents.ok.seed;
+#if defined(LATE_LATCH)
+	WaitForLatch();
+#endif
+
+	const f64 currentTime = GetTime();
+
+	f32 deltaTime = currentTime - previousTime;
+
+	MeasureFrame(currentTime, deltaTime);
+
+	previousTime = currentTime;
 
-	for (usize i = 0; i < result.contents.ok.length; ++i)
+	const u8 speed = GetSimulationSpeed();
+
+	if (speed == 0)
+	{
+		// Simulate as many frames as possible until it is time to draw again, and only draw the
+		// latest one.
+		const f64 deadline = currentTime + targetFrameTime * UNLIMITED_PLAYBACK_BUDGET;
+
+		do
+		{
+			SimulateFrame();
+		} while (GetTime() < deadline && GetSimulationSpeed() == 0);
+
+		accumulator = 0.0F;
+	}
+	else
 	{
-		SceneUpdate(&scene);
+		// Set a maximum delta time in order to avoid a "spiral of death." Note that playing back
+		// faster than real time is allowed to skip proportionally more frames.
+		if (deltaTime > maxDeltaTime)
+		{
+			deltaTime = maxDeltaTime;
+		}
+
+		accumulator += deltaTime * speed;
+
+		while (accumulator >= targetFrameTime)
+		{
+			SimulateFrame();
+
+			accumulator -= targetFrameTime;
+		}
 	}
 
-	return;
+	ContextSetAlpha(accumulator / targetFrameTime);
+
+	GameDraw();
+
+#if defined(LATE_LATCH)
+	// Only the time spent on the CPU is measured; the margin has to cover whatever the GPU adds.
+	frameCosts[frameCostsIndex] = GetTime() - currentTime;
+	frameCostsIndex = (frameCostsIndex + 1) % LATE_LATCH_HISTORY;
+#endif
+
+	Present();
+
+#if defined(SPIKE_WATCHDOG)
+	SaveSpike();
 #endif
+}
+
+#endif
+
+void GameRun(void)
+{
+	StartupInit();
+	StartupNameThread("Main");
+
+	StartLoading();
 
 	// TODO(thismarvin): Incorporate a config file or cli options for window resolution.
 
+	usize phase = StartupBegin("InitWindow");
+
 #if defined(PLATFORM_WEB)
 	{
 		const i32 screenWidth = EM_ASM_INT(return window.screen.width * window.devicePixelRatio);
@@ -230,23 +1550,52 @@ void GameRun(void)
 	InitWindow(DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, "Larry the Light-bulb Redux");
 #endif
 
+	StartupEnd(phase);
+
+	phase = StartupBegin("InitAudioDevice");
 	InitAudioDevice();
+	StartupEnd(phase);
 
 	SetWindowState(FLAG_VSYNC_HINT | FLAG_WINDOW_RESIZABLE);
 	SetWindowMinSize(CTX_VIEWPORT_WIDTH, CTX_VIEWPORT_HEIGHT);
 
-#if defined(PLATFORM_DESKTOP)
-	icon = LoadImage(DATADIR "content/icon.png");
+	GameInitialize();
 
+#if defined(PLATFORM_DESKTOP)
 	SetWindowIcon(icon);
 #endif
 
-	GameInitialize();
+	UpdateRefreshPeriod();
+
+	sleeper = SleeperCreate();
 
 	previousTime = GetTime();
+	presentTime = previousTime;
+	nextFrameTime = previousTime;
 
 #if defined(PLATFORM_WEB)
 	emscripten_set_main_loop(Timestep, 0, 1);
+#elif defined(SIMULATION_THREAD)
+	atomic_store(&simulating, true);
+
+	if (pthread_create(&simulationThread, NULL, RunSimulation, NULL) != 0)
+	{
+		TraceLog(LOG_FATAL, "Could not start the simulation thread.");
+	}
+
+	// Detect window close button or ESC key.
+	while (!WindowShouldClose())
+	{
+		Timestep();
+	}
+
+	atomic_store(&simulating, false);
+	pthread_join(simulationThread, NULL);
+
+	for (usize i = 0; i < TOTAL_SNAPSHOTS; ++i)
+	{
+		SceneDestroySnapshot(&snapshots[i].render);
+	}
 #else
 
 	// Detect window close button or ESC key.
@@ -255,10 +1604,28 @@ void GameRun(void)
 		Timestep();
 	}
 
+	SceneDestroySnapshot(&drawnSnapshot);
+#endif
+
+#if defined(PROFILING)
+	SaveTrace();
+	SaveFootprint();
+#endif
+
+#if defined(SPIKE_WATCHDOG)
+	SaveSpike();
+	InputStreamDestroy(&spike.input);
 #endif
 
 	SceneDestroy(&scene);
 
+	if (atomic_load(&playingBack))
+	{
+		ReplayMappingDestroy(&playback);
+	}
+
+	free(atomic_exchange(&requestedPlayback, NULL));
+
 	CloseAudioDevice();
 	CloseWindow();
 
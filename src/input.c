@@ -13,13 +13,8 @@ static void KeyboardBindingConsume(KeyboardBinding* binding)
 	binding->m_bufferTimer = binding->m_bufferDuration;
 }
 
-static void GamepadBindingConsume(GamepadBinding* binding, const usize gamepad)
+static void GamepadBindingConsume(GamepadBinding* binding)
 {
-	if (!IsGamepadAvailable(gamepad))
-	{
-		return;
-	}
-
 	binding->m_bufferTimer = binding->m_bufferDuration;
 }
 
@@ -32,6 +27,7 @@ KeyboardBinding KeyboardBindingCreate(const char* name, const usize keysCapacity
 {
 	return (KeyboardBinding) {
 		.m_name = (char*)name,
+		.m_action = INPUT_ACTION_NONE,
 		.m_keys = calloc(keysCapacity, sizeof(KeyboardKey)),
 		.m_keysCapacity = keysCapacity,
 		.m_keysLength = 0,
@@ -67,6 +63,7 @@ GamepadBinding GamepadBindingCreate(const char* name, const usize buttonsCapacit
 {
 	return (GamepadBinding) {
 		.m_name = (char*)name,
+		.m_action = INPUT_ACTION_NONE,
 		.m_buttons = calloc(buttonsCapacity, sizeof(GamepadButton)),
 		.m_buttonsCapacity = buttonsCapacity,
 		.m_buttonsLength = 0,
@@ -102,6 +99,7 @@ MouseBinding MouseBindingCreate(const char* name, const usize buttonsCapacity)
 {
 	return (MouseBinding) {
 		.m_name = (char*)name,
+		.m_action = INPUT_ACTION_NONE,
 		.m_buttons = calloc(buttonsCapacity, sizeof(MouseButton)),
 		.m_buttonsCapacity = buttonsCapacity,
 		.m_buttonsLength = 0,
@@ -142,6 +140,7 @@ AxisBinding AxisBindingCreate(
 {
 	return (AxisBinding) {
 		.m_name = (char*)name,
+		.m_action = INPUT_ACTION_NONE,
 		.m_axes = calloc(axesCapacity, sizeof(GamepadAxis)),
 		.m_axesCapacity = axesCapacity,
 		.m_axesLength = 0,
@@ -167,211 +166,83 @@ void AxisBindingDestroy(AxisBinding* self)
 	free(self->m_axes);
 }
 
-static void KeyboardBindingUpdate(KeyboardBinding* binding)
+typedef struct
 {
-	binding->m_bufferTimer += CTX_DT;
-
-	bool inactive = true;
-
-	for (usize i = 0; i < binding->m_keysLength; ++i)
-	{
-		if (IsKeyPressed(binding->m_keys[i]))
-		{
-			binding->m_bufferTimer = 0;
-		}
-
-		if (IsKeyReleased(binding->m_keys[i]))
-		{
-			binding->m_bufferTimer = 0;
-		}
-
-		if (!IsKeyUp(binding->m_keys[i]))
-		{
-			inactive = false;
-		}
-	}
+	bool pressed;
+	bool pressing;
+	bool released;
+} BindingState;
 
-	if (inactive)
-	{
-		KeyboardBindingConsume(binding);
-	}
-}
-
-static void GamepadBindingUpdate(GamepadBinding* binding, const usize gamepad)
+static bool IsBuffered(const f32 bufferDuration, const f32 bufferTimer)
 {
-	if (!IsGamepadAvailable(gamepad))
-	{
-		return;
-	}
-
-	binding->m_bufferTimer += CTX_DT;
-
-	bool inactive = true;
-
-	for (usize i = 0; i < binding->m_buttonsLength; ++i)
-	{
-		if (IsGamepadButtonPressed(gamepad, binding->m_buttons[i]))
-		{
-			binding->m_bufferTimer = 0;
-		}
-
-		if (IsGamepadButtonReleased(gamepad, binding->m_buttons[i]))
-		{
-			binding->m_bufferTimer = 0;
-		}
-
-		if (!IsGamepadButtonUp(gamepad, binding->m_buttons[i]))
-		{
-			inactive = false;
-		}
-	}
-
-	if (inactive)
-	{
-		GamepadBindingConsume(binding, gamepad);
-	}
+	return bufferDuration != 0 && bufferTimer < bufferDuration;
 }
 
-static void MouseBindingUpdate(MouseBinding* binding)
+static void UpdateBufferTimer(f32* bufferTimer, const f32 bufferDuration, const BindingState state)
 {
-	binding->m_bufferTimer += CTX_DT;
+	*bufferTimer += CTX_DT;
 
-	bool inactive = true;
-
-	for (usize i = 0; i < binding->m_buttonsLength; ++i)
+	if (state.pressed || state.released)
 	{
-		if (IsMouseButtonPressed(binding->m_buttons[i]))
-		{
-			binding->m_bufferTimer = 0;
-		}
-
-		if (IsMouseButtonReleased(binding->m_buttons[i]))
-		{
-			binding->m_bufferTimer = 0;
-		}
-
-		if (!IsMouseButtonUp(binding->m_buttons[i]))
-		{
-			inactive = false;
-		}
+		*bufferTimer = 0;
 	}
 
-	if (inactive)
+	if (!state.pressing)
 	{
-		MouseBindingConsume(binding);
+		*bufferTimer = bufferDuration;
 	}
 }
 
-static bool KeyboardBindingPressed(const KeyboardBinding* binding)
+static BindingState KeyboardBindingUpdate(KeyboardBinding* binding)
 {
-	if (binding->m_bufferDuration != 0 && binding->m_bufferTimer < binding->m_bufferDuration)
-	{
-		return true;
-	}
+	BindingState state = { false, false, false };
 
 	for (usize i = 0; i < binding->m_keysLength; ++i)
 	{
-		if (IsKeyPressed(binding->m_keys[i]))
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
-
-static bool GamepadBindingPressed(const GamepadBinding* binding, const usize gamepad)
-{
-	if (!IsGamepadAvailable(gamepad))
-	{
-		return false;
+		state.pressed |= IsKeyPressed(binding->m_keys[i]);
+		state.pressing |= IsKeyDown(binding->m_keys[i]);
+		state.released |= IsKeyReleased(binding->m_keys[i]);
 	}
 
-	if (binding->m_bufferDuration != 0 && binding->m_bufferTimer < binding->m_bufferDuration)
-	{
-		return true;
-	}
+	UpdateBufferTimer(&binding->m_bufferTimer, binding->m_bufferDuration, state);
 
-	for (usize i = 0; i < binding->m_buttonsLength; ++i)
-	{
-		if (IsGamepadButtonPressed(gamepad, binding->m_buttons[i]))
-		{
-			return true;
-		}
-	}
-
-	return false;
+	return state;
 }
 
-static bool MouseBindingPressed(const MouseBinding* binding)
+static BindingState GamepadBindingUpdate(GamepadBinding* binding, const usize gamepad)
 {
-	if (binding->m_bufferDuration != 0 && binding->m_bufferTimer < binding->m_bufferDuration)
-	{
-		return true;
-	}
+	BindingState state = { false, false, false };
 
 	for (usize i = 0; i < binding->m_buttonsLength; ++i)
 	{
-		if (IsMouseButtonPressed(binding->m_buttons[i]))
-		{
-			return true;
-		}
+		state.pressed |= IsGamepadButtonPressed(gamepad, binding->m_buttons[i]);
+		state.pressing |= IsGamepadButtonDown(gamepad, binding->m_buttons[i]);
+		state.released |= IsGamepadButtonReleased(gamepad, binding->m_buttons[i]);
 	}
 
-	return false;
-}
+	UpdateBufferTimer(&binding->m_bufferTimer, binding->m_bufferDuration, state);
 
-static bool KeyboardBindingPressing(const KeyboardBinding* binding)
-{
-	for (usize i = 0; i < binding->m_keysLength; ++i)
-	{
-		if (IsKeyDown(binding->m_keys[i]))
-		{
-			return true;
-		}
-	}
-
-	return false;
+	return state;
 }
 
-static bool GamepadBindingPressing(const GamepadBinding* binding, const usize gamepad)
+static BindingState MouseBindingUpdate(MouseBinding* binding)
 {
-	if (!IsGamepadAvailable(gamepad))
-	{
-		return false;
-	}
+	BindingState state = { false, false, false };
 
 	for (usize i = 0; i < binding->m_buttonsLength; ++i)
 	{
-		if (IsGamepadButtonDown(gamepad, binding->m_buttons[i]))
-		{
-			return true;
-		}
+		state.pressed |= IsMouseButtonPressed(binding->m_buttons[i]);
+		state.pressing |= IsMouseButtonDown(binding->m_buttons[i]);
+		state.released |= IsMouseButtonReleased(binding->m_buttons[i]);
 	}
 
-	return false;
-}
-
-static bool MouseBindingPressing(const MouseBinding* binding)
-{
-	for (usize i = 0; i < binding->m_buttonsLength; ++i)
-	{
-		if (IsMouseButtonDown(binding->m_buttons[i]))
-		{
-			return true;
-		}
-	}
+	UpdateBufferTimer(&binding->m_bufferTimer, binding->m_bufferDuration, state);
 
-	return false;
+	return state;
 }
 
 static bool AxisBindingPressing(const AxisBinding* binding, const usize gamepad)
 {
-	if (!IsGamepadAvailable(gamepad))
-	{
-		return false;
-	}
-
 	for (usize i = 0; i < binding->m_axesLength; ++i)
 	{
 		const f32 value = GetGamepadAxisMovement(gamepad, binding->m_axes[i]);
@@ -390,78 +261,50 @@ static bool AxisBindingPressing(const AxisBinding* binding, const usize gamepad)
 	return false;
 }
 
-static bool KeyboardBindingReleased(const KeyboardBinding* binding)
+InputProfile InputProfileCreate(const usize bindingsCapacity)
 {
-	if (binding->m_bufferDuration != 0 && binding->m_bufferTimer < binding->m_bufferDuration)
-	{
-		return true;
-	}
-
-	for (usize i = 0; i < binding->m_keysLength; ++i)
-	{
-		if (IsKeyReleased(binding->m_keys[i]))
-		{
-			return true;
-		}
-	}
-
-	return false;
+	return (InputProfile) {
+		.m_bindingsCapacity = bindingsCapacity,
+		.m_keyboardBindings = calloc(bindingsCapacity, sizeof(KeyboardBinding)),
+		.m_keyboardBindingsLength = 0,
+		.m_gamepadBindings = calloc(bindingsCapacity, sizeof(GamepadBinding)),
+		.m_gamepadBindingsLength = 0,
+		.m_mouseBindings = calloc(bindingsCapacity, sizeof(MouseBinding)),
+		.m_mouseBindingsLength = 0,
+		.m_axisBindings = calloc(bindingsCapacity, sizeof(AxisBinding)),
+		.m_axisBindingsLength = 0,
+		.m_actions = { NULL },
+		.m_actionsLength = 0,
+	};
 }
 
-static bool GamepadBindingReleased(const GamepadBinding* binding, const usize gamepad)
+InputAction InputProfileGetAction(const InputProfile* self, const char* name)
 {
-	if (!IsGamepadAvailable(gamepad))
+	for (usize i = 0; i < self->m_actionsLength; ++i)
 	{
-		return false;
-	}
-
-	if (binding->m_bufferDuration != 0 && binding->m_bufferTimer < binding->m_bufferDuration)
-	{
-		return true;
-	}
-
-	for (usize i = 0; i < binding->m_buttonsLength; ++i)
-	{
-		if (IsGamepadButtonReleased(gamepad, binding->m_buttons[i]))
+		if (strcmp(self->m_actions[i], name) == 0)
 		{
-			return true;
+			return i;
 		}
 	}
 
-	return false;
+	return INPUT_ACTION_NONE;
 }
 
-static bool MouseBindingReleased(const MouseBinding* binding)
+InputAction InputProfileAddAction(InputProfile* self, const char* name)
 {
-	if (binding->m_bufferDuration != 0 && binding->m_bufferTimer < binding->m_bufferDuration)
-	{
-		return true;
-	}
+	const InputAction existing = InputProfileGetAction(self, name);
 
-	for (usize i = 0; i < binding->m_buttonsLength; ++i)
+	if (existing != INPUT_ACTION_NONE || self->m_actionsLength >= MAX_INPUT_ACTIONS)
 	{
-		if (IsMouseButtonReleased(binding->m_buttons[i]))
-		{
-			return true;
-		}
+		return existing;
 	}
 
-	return false;
-}
+	self->m_actions[self->m_actionsLength] = name;
 
-InputProfile InputProfileCreate(const usize bindingsCapacity)
-{
-	return (InputProfile) {
-		.m_bindingsCapacity = bindingsCapacity,
-		.m_keyboardBindings = calloc(bindingsCapacity, sizeof(KeyboardBinding)),
-		.m_keyboardBindingsLength = 0,
-		.m_gamepadBindings = calloc(bindingsCapacity, sizeof(GamepadBinding)),
-		.m_gamepadBindingsLength = 0,
-		.m_mouseBindings = calloc(bindingsCapacity, sizeof(MouseBinding)),
-		.m_mouseBindingsLength = 0,
-		.m_axisBindings = calloc(bindingsCapacity, sizeof(AxisBinding)),
-		.m_axisBindingsLength = 0,
-	};
+	self->m_actionsLength += 1;
+
+	return self->m_actionsLength - 1;
 }
 
 void InputProfileAddKeyboardBinding(InputProfile* self, const KeyboardBinding binding)
@@ -471,7 +314,10 @@ void InputProfileAddKeyboardBinding(InputProfile* self, const KeyboardBinding bi
 		return;
 	}
 
-	self->m_keyboardBindings[self->m_keyboardBindingsLength] = binding;
+	KeyboardBinding* entry = &self->m_keyboardBindings[self->m_keyboardBindingsLength];
+
+	*entry = binding;
+	entry->m_action = InputProfileAddAction(self, binding.m_name);
 
 	self->m_keyboardBindingsLength += 1;
 }
@@ -483,7 +329,10 @@ void InputProfileAddGamepadBinding(InputProfile* self, const GamepadBinding bind
 		return;
 	}
 
-	self->m_gamepadBindings[self->m_gamepadBindingsLength] = binding;
+	GamepadBinding* entry = &self->m_gamepadBindings[self->m_gamepadBindingsLength];
+
+	*entry = binding;
+	entry->m_action = InputProfileAddAction(self, binding.m_name);
 
 	self->m_gamepadBindingsLength += 1;
 }
@@ -495,7 +344,10 @@ void InputProfileAddMouseBinding(InputProfile* self, const MouseBinding binding)
 		return;
 	}
 
-	self->m_mouseBindings[self->m_mouseBindingsLength] = binding;
+	MouseBinding* entry = &self->m_mouseBindings[self->m_mouseBindingsLength];
+
+	*entry = binding;
+	entry->m_action = InputProfileAddAction(self, binding.m_name);
 
 	self->m_mouseBindingsLength += 1;
 }
@@ -507,7 +359,10 @@ void InputProfileAddAxisBinding(InputProfile* self, const AxisBinding binding)
 		return;
 	}
 
-	self->m_axisBindings[self->m_axisBindingsLength] = binding;
+	AxisBinding* entry = &self->m_axisBindings[self->m_axisBindingsLength];
+
+	*entry = binding;
+	entry->m_action = InputProfileAddAction(self, binding.m_name);
 
 	self->m_axisBindingsLength += 1;
 }
@@ -545,6 +400,11 @@ InputHandler InputHandlerCreate(const usize gamepad)
 	return (InputHandler) {
 		.m_gamepad = gamepad,
 		.m_profile = NULL,
+		.m_gamepadAvailable = false,
+		.m_pressed = 0,
+		.m_pressing = 0,
+		.m_released = 0,
+		.m_buffered = 0,
 	};
 }
 
@@ -558,210 +418,198 @@ static bool InputHandlerEnabled(const InputHandler* self)
 	return self->m_profile != NULL;
 }
 
-void InputHandlerUpdate(InputHandler* self)
+static InputActions GetActionMask(const InputAction action)
 {
-	if (!InputHandlerEnabled(self))
+	if (action >= MAX_INPUT_ACTIONS)
 	{
-		return;
+		return 0;
 	}
 
-	if (self->m_gamepad == 0)
-	{
-		for (usize i = 0; i < self->m_profile->m_keyboardBindingsLength; ++i)
-		{
-			KeyboardBindingUpdate(&self->m_profile->m_keyboardBindings[i]);
-		}
-	}
+	return (InputActions)1 << action;
+}
 
-	for (usize i = 0; i < self->m_profile->m_gamepadBindingsLength; ++i)
-	{
-		GamepadBindingUpdate(&self->m_profile->m_gamepadBindings[i], self->m_gamepad);
-	}
+static void InputHandlerRecord(
+	InputHandler* self,
+	const InputAction action,
+	const BindingState state,
+	const bool buffered
+)
+{
+	const InputActions mask = GetActionMask(action);
 
-	for (usize i = 0; i < self->m_profile->m_mouseBindingsLength; ++i)
-	{
-		MouseBindingUpdate(&self->m_profile->m_mouseBindings[i]);
-	}
+	self->m_pressed |= state.pressed ? mask : 0;
+	self->m_pressing |= state.pressing ? mask : 0;
+	self->m_released |= state.released ? mask : 0;
+	self->m_buffered |= buffered ? mask : 0;
 }
 
-bool InputHandlerPressed(const InputHandler* self, const char* binding)
+void InputHandlerUpdate(InputHandler* self)
 {
+	self->m_pressed = 0;
+	self->m_pressing = 0;
+	self->m_released = 0;
+	self->m_buffered = 0;
+
 	if (!InputHandlerEnabled(self))
 	{
-		return false;
+		return;
 	}
 
+	InputProfile* profile = self->m_profile;
+
+	self->m_gamepadAvailable = IsGamepadAvailable(self->m_gamepad);
+
 	if (self->m_gamepad == 0)
 	{
-		for (usize i = 0; i < self->m_profile->m_keyboardBindingsLength; ++i)
+		for (usize i = 0; i < profile->m_keyboardBindingsLength; ++i)
 		{
-			if (strcmp(self->m_profile->m_keyboardBindings[i].m_name, binding) == 0)
-			{
-				if (KeyboardBindingPressed(&self->m_profile->m_keyboardBindings[i]))
-				{
-					return true;
-				}
-			}
+			KeyboardBinding* binding = &profile->m_keyboardBindings[i];
+			const BindingState state = KeyboardBindingUpdate(binding);
+			const bool buffered = IsBuffered(binding->m_bufferDuration, binding->m_bufferTimer);
+
+			InputHandlerRecord(self, binding->m_action, state, buffered);
 		}
 	}
 
-	for (usize i = 0; i < self->m_profile->m_gamepadBindingsLength; ++i)
+	if (self->m_gamepadAvailable)
 	{
-		if (strcmp(self->m_profile->m_gamepadBindings[i].m_name, binding) == 0)
+		for (usize i = 0; i < profile->m_gamepadBindingsLength; ++i)
 		{
-			if (GamepadBindingPressed(&self->m_profile->m_gamepadBindings[i], self->m_gamepad))
-			{
-				return true;
-			}
+			GamepadBinding* binding = &profile->m_gamepadBindings[i];
+			const BindingState state = GamepadBindingUpdate(binding, self->m_gamepad);
+			const bool buffered = IsBuffered(binding->m_bufferDuration, binding->m_bufferTimer);
+
+			InputHandlerRecord(self, binding->m_action, state, buffered);
 		}
-	}
 
-	for (usize i = 0; i < self->m_profile->m_mouseBindingsLength; ++i)
-	{
-		if (strcmp(self->m_profile->m_mouseBindings[i].m_name, binding) == 0)
+		for (usize i = 0; i < profile->m_axisBindingsLength; ++i)
 		{
-			if (MouseBindingPressed(&self->m_profile->m_mouseBindings[i]))
-			{
-				return true;
-			}
+			const AxisBinding* binding = &profile->m_axisBindings[i];
+			const bool pressing = AxisBindingPressing(binding, self->m_gamepad);
+
+			self->m_pressing |= pressing ? GetActionMask(binding->m_action) : 0;
 		}
 	}
 
-	return false;
+	for (usize i = 0; i < profile->m_mouseBindingsLength; ++i)
+	{
+		MouseBinding* binding = &profile->m_mouseBindings[i];
+		const BindingState state = MouseBindingUpdate(binding);
+		const bool buffered = IsBuffered(binding->m_bufferDuration, binding->m_bufferTimer);
+
+		InputHandlerRecord(self, binding->m_action, state, buffered);
+	}
 }
 
-bool InputHandlerPressing(const InputHandler* self, const char* binding)
+bool InputHandlerPressedAction(const InputHandler* self, const InputAction action)
+{
+	return ((self->m_pressed | self->m_buffered) & GetActionMask(action)) != 0;
+}
+
+bool InputHandlerPressingAction(const InputHandler* self, const InputAction action)
+{
+	return (self->m_pressing & GetActionMask(action)) != 0;
+}
+
+bool InputHandlerReleasedAction(const InputHandler* self, const InputAction action)
+{
+	return ((self->m_released | self->m_buffered) & GetActionMask(action)) != 0;
+}
+
+void InputHandlerConsumeAction(InputHandler* self, const InputAction action)
 {
 	if (!InputHandlerEnabled(self))
 	{
-		return false;
+		return;
 	}
 
-	if (self->m_gamepad == 0)
-	{
-		for (usize i = 0; i < self->m_profile->m_keyboardBindingsLength; ++i)
-		{
-			if (strcmp(self->m_profile->m_keyboardBindings[i].m_name, binding) == 0
-				&& KeyboardBindingPressing(&self->m_profile->m_keyboardBindings[i]))
-			{
-				return true;
-			}
-		}
-	}
+	InputProfile* profile = self->m_profile;
 
-	for (usize i = 0; i < self->m_profile->m_gamepadBindingsLength; ++i)
+	// Only the first binding of each kind is consumed.
+	bool keyboardConsumed = self->m_gamepad != 0;
+	bool gamepadConsumed = !self->m_gamepadAvailable;
+	bool mouseConsumed = false;
+
+	// Consuming an action may not necessarily clear its buffer, so it has to be recalculated.
+	InputActions buffered = 0;
+
+	for (usize i = 0; i < profile->m_keyboardBindingsLength && self->m_gamepad == 0; ++i)
 	{
-		if (strcmp(self->m_profile->m_gamepadBindings[i].m_name, binding) == 0
-			&& GamepadBindingPressing(&self->m_profile->m_gamepadBindings[i], self->m_gamepad))
+		KeyboardBinding* binding = &profile->m_keyboardBindings[i];
+
+		if (!keyboardConsumed && binding->m_action == action)
 		{
-			return true;
+			KeyboardBindingConsume(binding);
+			keyboardConsumed = true;
 		}
-	}
 
-	for (usize i = 0; i < self->m_profile->m_mouseBindingsLength; ++i)
-	{
-		if (strcmp(self->m_profile->m_mouseBindings[i].m_name, binding) == 0
-			&& MouseBindingPressing(&self->m_profile->m_mouseBindings[i]))
+		if (IsBuffered(binding->m_bufferDuration, binding->m_bufferTimer))
 		{
-			return true;
+			buffered |= GetActionMask(binding->m_action);
 		}
 	}
 
-	for (usize i = 0; i < self->m_profile->m_axisBindingsLength; ++i)
+	for (usize i = 0; i < profile->m_gamepadBindingsLength && self->m_gamepadAvailable; ++i)
 	{
-		if (strcmp(self->m_profile->m_axisBindings[i].m_name, binding) == 0
-			&& AxisBindingPressing(&self->m_profile->m_axisBindings[i], self->m_gamepad))
+		GamepadBinding* binding = &profile->m_gamepadBindings[i];
+
+		if (!gamepadConsumed && binding->m_action == action)
 		{
-			return true;
+			GamepadBindingConsume(binding);
+			gamepadConsumed = true;
 		}
-	}
-
-	return false;
-}
-
-bool InputHandlerReleased(const InputHandler* self, const char* binding)
-{
-	if (!InputHandlerEnabled(self))
-	{
-		return false;
-	}
 
-	if (self->m_gamepad == 0)
-	{
-		for (usize i = 0; i < self->m_profile->m_keyboardBindingsLength; ++i)
+		if (IsBuffered(binding->m_bufferDuration, binding->m_bufferTimer))
 		{
-			if (strcmp(self->m_profile->m_keyboardBindings[i].m_name, binding) == 0)
-			{
-				if (KeyboardBindingReleased(&self->m_profile->m_keyboardBindings[i]))
-				{
-					return true;
-				}
-			}
+			buffered |= GetActionMask(binding->m_action);
 		}
 	}
 
-	for (usize i = 0; i < self->m_profile->m_gamepadBindingsLength; ++i)
+	for (usize i = 0; i < profile->m_mouseBindingsLength; ++i)
 	{
-		if (strcmp(self->m_profile->m_gamepadBindings[i].m_name, binding) == 0)
+		MouseBinding* binding = &profile->m_mouseBindings[i];
+
+		if (!mouseConsumed && binding->m_action == action)
 		{
-			if (GamepadBindingReleased(&self->m_profile->m_gamepadBindings[i], self->m_gamepad))
-			{
-				return true;
-			}
+			MouseBindingConsume(binding);
+			mouseConsumed = true;
 		}
-	}
 
-	for (usize i = 0; i < self->m_profile->m_mouseBindingsLength; ++i)
-	{
-		if (strcmp(self->m_profile->m_mouseBindings[i].m_name, binding) == 0)
+		if (IsBuffered(binding->m_bufferDuration, binding->m_bufferTimer))
 		{
-			if (MouseBindingReleased(&self->m_profile->m_mouseBindings[i]))
-			{
-				return true;
-			}
+			buffered |= GetActionMask(binding->m_action);
 		}
 	}
 
-	return false;
+	self->m_buffered = buffered;
 }
 
-void InputHandlerConsume(InputHandler* self, const char* binding)
+static InputAction InputHandlerGetAction(const InputHandler* self, const char* binding)
 {
 	if (!InputHandlerEnabled(self))
 	{
-		return;
+		return INPUT_ACTION_NONE;
 	}
 
-	if (self->m_gamepad == 0)
-	{
-		for (usize i = 0; i < self->m_profile->m_keyboardBindingsLength; ++i)
-		{
-			if (strcmp(self->m_profile->m_keyboardBindings[i].m_name, binding) == 0)
-			{
-				KeyboardBindingConsume(&self->m_profile->m_keyboardBindings[i]);
-
-				break;
-			}
-		}
-	}
+	return InputProfileGetAction(self->m_profile, binding);
+}
 
-	for (usize i = 0; i < self->m_profile->m_gamepadBindingsLength; ++i)
-	{
-		if (strcmp(self->m_profile->m_gamepadBindings[i].m_name, binding) == 0)
-		{
-			GamepadBindingConsume(&self->m_profile->m_gamepadBindings[i], self->m_gamepad);
+bool InputHandlerPressed(const InputHandler* self, const char* binding)
+{
+	return InputHandlerPressedAction(self, InputHandlerGetAction(self, binding));
+}
 
-			break;
-		}
-	}
+bool InputHandlerPressing(const InputHandler* self, const char* binding)
+{
+	return InputHandlerPressingAction(self, InputHandlerGetAction(self, binding));
+}
 
-	for (usize i = 0; i < self->m_profile->m_mouseBindingsLength; ++i)
-	{
-		if (strcmp(self->m_profile->m_mouseBindings[i].m_name, binding) == 0)
-		{
-			MouseBindingConsume(&self->m_profile->m_mouseBindings[i]);
+bool InputHandlerReleased(const InputHandler* self, const char* binding)
+{
+	return InputHandlerReleasedAction(self, InputHandlerGetAction(self, binding));
+}
 
-			break;
-		}
-	}
+void InputHandlerConsume(InputHandler* self, const char* binding)
+{
+	InputHandlerConsumeAction(self, InputHandlerGetAction(self, binding));
 }
@@ -5,9 +5,19 @@
 #include <raylib.h>
 #include <stdbool.h>
 
+// The most distinctly named bindings (i.e. actions) an InputProfile can have.
+#define MAX_INPUT_ACTIONS (32)
+#define INPUT_ACTION_NONE (UINT8_MAX)
+
+// Every binding's name is resolved to a small integer once it is added to an InputProfile.
+typedef u8 InputAction;
+// A bitset where bit `i` represents InputAction `i`.
+typedef u32 InputActions;
+
 typedef struct
 {
 	char* m_name;
+	InputAction m_action;
 	KeyboardKey* m_keys;
 	usize m_keysCapacity;
 	usize m_keysLength;
@@ -18,6 +28,7 @@ typedef struct
 typedef struct
 {
 	char* m_name;
+	InputAction m_action;
 	GamepadButton* m_buttons;
 	usize m_buttonsCapacity;
 	usize m_buttonsLength;
@@ -28,6 +39,7 @@ typedef struct
 typedef struct
 {
 	char* m_name;
+	InputAction m_action;
 	MouseButton* m_buttons;
 	usize m_buttonsCapacity;
 	usize m_buttonsLength;
@@ -38,6 +50,7 @@ typedef struct
 typedef struct
 {
 	char* m_name;
+	InputAction m_action;
 	GamepadAxis* m_axes;
 	usize m_axesCapacity;
 	usize m_axesLength;
@@ -56,12 +69,20 @@ typedef struct
 	usize m_mouseBindingsLength;
 	AxisBinding* m_axisBindings;
 	usize m_axisBindingsLength;
+	const char* m_actions[MAX_INPUT_ACTIONS];
+	usize m_actionsLength;
 } InputProfile;
 
 typedef struct
 {
 	usize m_gamepad;
 	InputProfile* m_profile;
+	// The state of every action as of the last InputHandlerUpdate.
+	bool m_gamepadAvailable;
+	InputActions m_pressed;
+	InputActions m_pressing;
+	InputActions m_released;
+	InputActions m_buffered;
 } InputHandler;
 
 KeyboardBinding KeyboardBindingCreate(const char* name, usize keysCapacity);
@@ -88,12 +109,22 @@ void InputProfileAddKeyboardBinding(InputProfile* self, KeyboardBinding binding)
 void InputProfileAddGamepadBinding(InputProfile* self, GamepadBinding binding);
 void InputProfileAddMouseBinding(InputProfile* self, MouseBinding binding);
 void InputProfileAddAxisBinding(InputProfile* self, AxisBinding binding);
+// Returns the InputAction associated with the given name (creating one if it does not exist yet),
+// or INPUT_ACTION_NONE if the profile has no room for another action.
+InputAction InputProfileAddAction(InputProfile* self, const char* name);
+// Returns INPUT_ACTION_NONE if no binding with the given name was ever added.
+InputAction InputProfileGetAction(const InputProfile* self, const char* name);
 void InputProfileDestroy(InputProfile* self);
 
 InputHandler InputHandlerCreate(usize gamepad);
 void InputHandlerSetProfile(InputHandler* self, const InputProfile* profile);
+// Polls every device once and records the state of every action for the rest of the frame.
 void InputHandlerUpdate(InputHandler* self);
-// TODO(thismarvin): Return the active bindings somehow...
+bool InputHandlerPressedAction(const InputHandler* self, InputAction action);
+bool InputHandlerPressingAction(const InputHandler* self, InputAction action);
+bool InputHandlerReleasedAction(const InputHandler* self, InputAction action);
+void InputHandlerConsumeAction(InputHandler* self, InputAction action);
+// The following look up the binding's InputAction by name first.
 bool InputHandlerPressed(const InputHandler* self, const char* binding);
 bool InputHandlerPressing(const InputHandler* self, const char* binding);
 bool InputHandlerReleased(const InputHandler* self, const char* binding);
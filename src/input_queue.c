@@ -0,0 +1,62 @@
+#include "input_queue.h"
+
+#define INPUT_QUEUE_MASK (INPUT_QUEUE_CAPACITY - 1)
+
+_Static_assert((INPUT_QUEUE_CAPACITY & INPUT_QUEUE_MASK) == 0, "capacity must be a power of two");
+
+void InputQueueInit(InputQueue* self)
+{
+	atomic_init(&self->m_head, 0);
+	atomic_init(&self->m_tail, 0);
+}
+
+bool InputQueuePush(InputQueue* self, const InputEvent event)
+{
+	const usize tail = atomic_load_explicit(&self->m_tail, memory_order_relaxed);
+	const usize head = atomic_load_explicit(&self->m_head, memory_order_acquire);
+
+	if (tail - head >= INPUT_QUEUE_CAPACITY)
+	{
+		return false;
+	}
+
+	self->m_events[tail & INPUT_QUEUE_MASK] = event;
+
+	// Publish the event only once it has been written.
+	atomic_store_explicit(&self->m_tail, tail + 1, memory_order_release);
+
+	return true;
+}
+
+bool InputQueueTryPopUntil(InputQueue* self, const f64 deadline, InputEvent* out)
+{
+	const usize head = atomic_load_explicit(&self->m_head, memory_order_relaxed);
+	const usize tail = atomic_load_explicit(&self->m_tail, memory_order_acquire);
+
+	if (head == tail)
+	{
+		return false;
+	}
+
+	const InputEvent event = self->m_events[head & INPUT_QUEUE_MASK];
+
+	if (event.timestamp > deadline)
+	{
+		return false;
+	}
+
+	*out = event;
+
+	// Hand the slot back to the producer only once it has been read.
+	atomic_store_explicit(&self->m_head, head + 1, memory_order_release);
+
+	return true;
+}
+
+usize InputQueueGetSize(InputQueue* self)
+{
+	const usize head = atomic_load_explicit(&self->m_head, memory_order_acquire);
+	const usize tail = atomic_load_explicit(&self->m_tail, memory_order_acquire);
+
+	return tail - head;
+}
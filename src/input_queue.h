@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint8_t u8;
+typedef uint32_t u32;
+typedef size_t usize;
+typedef double f64;
+
+// Must be a power of two.
+#define INPUT_QUEUE_CAPACITY (256)
+
+// A snapshot of every InputAction a player is pressing, taken at a given time (in seconds).
+typedef struct
+{
+	f64 timestamp;
+	u32 pressing;
+	u8 player;
+} InputEvent;
+
+// A lock-free, single-producer single-consumer ring of InputEvents. Events are pushed by whoever
+// samples input and popped in order by the simulation, so the two may live on separate threads.
+typedef struct
+{
+	InputEvent m_events[INPUT_QUEUE_CAPACITY];
+	// Only ever written by the consumer.
+	_Atomic usize m_head;
+	// Only ever written by the producer.
+	_Atomic usize m_tail;
+} InputQueue;
+
+void InputQueueInit(InputQueue* self);
+// Returns false (and drops the event) if the queue is full.
+bool InputQueuePush(InputQueue* self, InputEvent event);
+// Pops the oldest event if it happened at or before the given time.
+bool InputQueueTryPopUntil(InputQueue* self, f64 deadline, InputEvent* out);
+usize InputQueueGetSize(InputQueue* self);
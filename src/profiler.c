@@ -0,0 +1,138 @@
+#include "profiler.h"
+
+#include <math.h>
+#include <raylib.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The Profiler whose frame is in progress on this thread (if any).
+static _Thread_local Profiler* current;
+
+void ProfilerInit(Profiler* self)
+{
+	memset(self, 0, sizeof(Profiler));
+}
+
+void ProfilerBeginFrame(Profiler* self)
+{
+	self->m_frameStart = GetTime();
+	self->m_depth = 0;
+
+	current = self;
+}
+
+void ProfilerEndFrame(Profiler* self)
+{
+	const usize index = self->frames % PROFILER_HISTORY;
+
+	for (usize i = 0; i < self->sectionsLength; ++i)
+	{
+		self->sections[i].history[index] = self->sections[i].m_elapsed;
+		self->sections[i].m_elapsed = 0;
+	}
+
+	self->frameTimes[index] = GetTime() - self->m_frameStart;
+	self->frames += 1;
+
+	current = NULL;
+}
+
+static usize ProfilerFindSection(Profiler* self, const char* name)
+{
+	for (usize i = 0; i < self->sectionsLength; ++i)
+	{
+		// Names are almost always string literals, so comparing pointers is usually enough.
+		if (self->sections[i].name == name || strcmp(self->sections[i].name, name) == 0)
+		{
+			return i;
+		}
+	}
+
+	if (self->sectionsLength >= PROFILER_MAX_SECTIONS)
+	{
+		return PROFILER_MAX_SECTIONS;
+	}
+
+	ProfilerSection* section = &self->sections[self->sectionsLength];
+	section->name = name;
+	section->depth = self->m_depth;
+
+	return self->sectionsLength++;
+}
+
+void ProfilerBegin(const char* name)
+{
+	if (current == NULL || current->m_depth >= PROFILER_MAX_DEPTH)
+	{
+		return;
+	}
+
+	current->m_open[current->m_depth] = ProfilerFindSection(current, name);
+	current->m_openTimes[current->m_depth] = GetTime();
+	current->m_depth += 1;
+}
+
+void ProfilerEnd(void)
+{
+	if (current == NULL || current->m_depth == 0)
+	{
+		return;
+	}
+
+	current->m_depth -= 1;
+
+	const usize section = current->m_open[current->m_depth];
+
+	if (section < current->sectionsLength)
+	{
+		current->sections[section].m_elapsed += GetTime() - current->m_openTimes[current->m_depth];
+	}
+}
+
+static int CompareF32(const void* a, const void* b)
+{
+	const f32 lhs = *(const f32*)a;
+	const f32 rhs = *(const f32*)b;
+
+	return (lhs > rhs) - (lhs < rhs);
+}
+
+static ProfilerStats CalculateStats(const Profiler* self, const f32* history)
+{
+	const usize length = MIN(self->frames, PROFILER_HISTORY);
+
+	if (length == 0)
+	{
+		return (ProfilerStats) { 0 };
+	}
+
+	f32 sorted[PROFILER_HISTORY];
+	memcpy(sorted, history, sizeof(f32) * length);
+	qsort(sorted, length, sizeof(f32), CompareF32);
+
+	f64 sum = 0;
+
+	for (usize i = 0; i < length; ++i)
+	{
+		sum += sorted[i];
+	}
+
+	const usize p99 = (usize)ceil(length * 0.99) - 1;
+
+	return (ProfilerStats) {
+		.min = sorted[0],
+		.average = sum / length,
+		.p99 = sorted[p99],
+		.max = sorted[length - 1],
+	};
+}
+
+ProfilerStats ProfilerGetSectionStats(const Profiler* self, const usize section)
+{
+	return CalculateStats(self, self->sections[section].history);
+}
+
+ProfilerStats ProfilerGetFrameStats(const Profiler* self)
+{
+	return CalculateStats(self, self->frameTimes);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "common.h"
+#include "tracing.h"
+
+// Profiling is compiled out of release builds unless PROFILING is defined explicitly.
+#if !defined(NDEBUG) && !defined(PROFILING)
+	#define PROFILING
+#endif
+
+// How many of the most recent frames a Profiler remembers.
+#define PROFILER_HISTORY (240)
+#define PROFILER_MAX_SECTIONS (48)
+#define PROFILER_MAX_DEPTH (8)
+
+typedef struct
+{
+	const char* name;
+	// How many other sections this one runs inside of.
+	u8 depth;
+	// How long the section took during each of the most recent frames (in seconds).
+	f32 history[PROFILER_HISTORY];
+	f64 m_elapsed;
+} ProfilerSection;
+
+// Records how long named sections of code take, frame by frame. A Profiler only belongs to the
+// thread that is in the middle of one of its frames (see ProfilerBeginFrame).
+typedef struct
+{
+	ProfilerSection sections[PROFILER_MAX_SECTIONS];
+	usize sectionsLength;
+	// How long each of the most recent frames took as a whole (in seconds).
+	f32 frameTimes[PROFILER_HISTORY];
+	// How many frames have ended so far; the latest is at `(frames - 1) % PROFILER_HISTORY`.
+	usize frames;
+	f64 m_frameStart;
+	// The sections that have begun but not ended yet, and when they began.
+	usize m_open[PROFILER_MAX_DEPTH];
+	f64 m_openTimes[PROFILER_MAX_DEPTH];
+	u8 m_depth;
+} Profiler;
+
+typedef struct
+{
+	f32 min;
+	f32 average;
+	f32 p99;
+	f32 max;
+} ProfilerStats;
+
+void ProfilerInit(Profiler* self);
+// Starts recording sections into the given Profiler on the calling thread.
+void ProfilerBeginFrame(Profiler* self);
+void ProfilerEndFrame(Profiler* self);
+ProfilerStats ProfilerGetSectionStats(const Profiler* self, usize section);
+ProfilerStats ProfilerGetFrameStats(const Profiler* self);
+
+// Prefer PROFILE_BEGIN and PROFILE_END over calling these directly.
+void ProfilerBegin(const char* name);
+void ProfilerEnd(void);
+
+#if defined(PROFILING)
+	// Times everything until the matching PROFILE_END as a section called `mName` (which is traced
+	// as well).
+	#define PROFILE_BEGIN(mName) \
+		do \
+		{ \
+			ProfilerBegin(mName); \
+			TracingBegin(mName); \
+		} while (false)
+	#define PROFILE_END() \
+		do \
+		{ \
+			TracingEnd(); \
+			ProfilerEnd(); \
+		} while (false)
+	#define PROFILE_COUNTER(mName, mValue) TracingCounter(mName, mValue)
+#else
+	#define PROFILE_BEGIN(mName) ((void)0)
+	#define PROFILE_END() ((void)0)
+	#define PROFILE_COUNTER(mName, mValue) ((void)0)
+#endif
@@ -5,12 +5,24 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #define SIGNATURE_LENGTH (5)
 #define SIGNATURE_SIZE (5)
 
+// Starting with version 2, the last character of the signature is replaced with a version number.
+#define VERSIONED_SIGNATURE_SIZE (4)
+#define REPLAY_VERSION (3)
+// Version 2 Replays are identical to version 3 ones, except that they do not have any flags.
+#define MIN_REPLAY_VERSION (2)
+
+// signature + seed + totalBindings + length
+#define V1_HEADER_SIZE (SIGNATURE_SIZE + 4 + 1 + 4)
+
+#define NOT_PRESSED (UINT32_MAX)
+
 static const char signature[SIGNATURE_LENGTH] = "ltlrr";
 
 const char* StringFromReplayError(const ReplayError error)
@@ -27,48 +39,235 @@ const char* StringFromReplayError(const ReplayError error)
 		case REPLAY_ERROR_SIGNATURE_MISMATCH: {
 			return "The first few bytes do no match the signature of a valid Replay file.";
 		};
+		case REPLAY_ERROR_UNSUPPORTED_VERSION: {
+			return "The Replay was created by a newer version of the game.";
+		};
+		case REPLAY_ERROR_UNSUPPORTED_ENCODING: {
+			return "The Replay's input is stored using an unknown encoding.";
+		};
+		case REPLAY_ERROR_MALFORMED_BODY: {
+			return "The Replay's input is either truncated or corrupt.";
+		};
+		case REPLAY_ERROR_UNVIEWABLE_BODY: {
+			return "The Replay's input is not stored planar, so it cannot be used without being "
+				   "decoded.";
+		};
+		case REPLAY_ERROR_UNREADABLE_FILE: {
+			return "The Replay file could not be opened.";
+		};
 		default: {
 			return "Unknown error type.";
 		}
 	}
 }
 
+// Rounds the given amount of frames up to a whole number of BitMask entries.
+static usize RoundUpToEntry(const usize frames)
+{
+	return (frames + BIT_MASK_ENTRY_TOTAL_BITS - 1) / BIT_MASK_ENTRY_TOTAL_BITS
+		   * BIT_MASK_ENTRY_TOTAL_BITS;
+}
+
+// Both InputStreams and Replays store their bits binding-major: every binding's history is
+// contiguous (and padded to a whole number of entries), and bit (x, y) is frame x of binding y.
+static BitMask CreateHistories(const u8 totalBindings, const usize frames)
+{
+	return BitMaskCreate(RoundUpToEntry(frames), totalBindings);
+}
+
+static usize GetEntriesPerHistory(const BitMask* bits)
+{
+	return bits->width / BIT_MASK_ENTRY_TOTAL_BITS;
+}
+
+static BIT_MASK_ENTRY_TYPE* GetHistory(const BitMask* bits, const u8 binding)
+{
+	return bits->contents + (binding * GetEntriesPerHistory(bits));
+}
+
+// Returns a mask of the entry that contains the last frame of a history, or zero if the history
+// fills the entry entirely.
+static BIT_MASK_ENTRY_TYPE GetTrailingMask(const usize frames)
+{
+	const usize remaining = frames % BIT_MASK_ENTRY_TOTAL_BITS;
+
+	return remaining == 0 ? 0 : ((BIT_MASK_ENTRY_TYPE)1 << remaining) - 1;
+}
+
 InputStream InputStreamCreate(const u8 totalBindings, const u32 capacity)
 {
 	assert(capacity <= MAX_REPLAY_LENGTH);
 
+	// Rounding the capacity up to a whole entry keeps every entry of the ring intact when it wraps
+	// around.
+	const u32 rounded = RoundUpToEntry(capacity);
+
 	return (InputStream) {
-		.bits = BitMaskCreate(totalBindings, capacity),
+		.bits = CreateHistories(totalBindings, rounded),
 		.totalBindings = totalBindings,
-		.capacity = capacity,
+		.capacity = rounded,
 		.length = 0,
-		.barriers = calloc(totalBindings, sizeof(usize)),
+		.barriers = { 0 },
+		.readOnly = false,
+	};
+}
+
+InputStream InputStreamCreateView(const Replay* replay)
+{
+	assert(replay->length < MAX_REPLAY_LENGTH);
+
+	// The capacity is as large as possible so that frames never wrap around; reading past the end
+	// of the bits is always false.
+	return (InputStream) {
+		.bits = replay->bits,
+		.totalBindings = replay->totalBindings,
+		.capacity = MAX_REPLAY_LENGTH,
+		.length = replay->length,
+		.barriers = { 0 },
+		.readOnly = true,
 	};
 }
 
 bool InputStreamLoadReplay(InputStream* self, const Replay* replay)
 {
-	if (replay->totalBindings > self->totalBindings || replay->length >= self->capacity)
+	if (self->readOnly || replay->totalBindings > self->totalBindings
+		|| replay->length >= self->capacity)
 	{
 		return false;
 	}
 
-	memcpy(self->bits.contents, replay->bits.contents, replay->bits.size);
+	const usize historySize = GetEntriesPerHistory(&replay->bits) * BIT_MASK_ENTRY_SIZE;
+
+	memset(self->bits.contents, 0, self->bits.size);
+
+	for (u8 binding = 0; binding < replay->totalBindings; ++binding)
+	{
+		memcpy(GetHistory(&self->bits, binding), GetHistory(&replay->bits, binding), historySize);
+	}
 
 	self->length = replay->length;
-	memset(self->barriers, 0, self->totalBindings);
+	memset(self->barriers, 0, sizeof(self->barriers));
 
 	return true;
 }
 
+void InputStreamClear(InputStream* self)
+{
+	memset(self->barriers, 0, sizeof(self->barriers));
+
+	// A read-only InputStream keeps playing back the same Replay.
+	if (self->readOnly)
+	{
+		return;
+	}
+
+	memset(self->bits.contents, 0, self->bits.size);
+	self->length = 0;
+}
+
+void InputStreamContinue(InputStream* self, const InputStream* source, const u32 frame)
+{
+	assert(!self->readOnly && self->totalBindings >= source->totalBindings);
+
+	InputStreamClear(self);
+
+	// InputStreamPressed and InputStreamReleased never look back further than this.
+	const u32 start = frame > BIT_MASK_ENTRY_TOTAL_BITS ? frame - BIT_MASK_ENTRY_TOTAL_BITS : 0;
+
+	self->length = start;
+
+	for (u32 i = start; i < frame; ++i)
+	{
+		bool payload[UINT8_MAX + 1] = { false };
+
+		for (u8 binding = 0; binding < source->totalBindings; ++binding)
+		{
+			payload[binding] = InputStreamPressing(source, binding, i);
+		}
+
+		InputStreamPush(self, payload);
+	}
+
+	memcpy(self->barriers, source->barriers, sizeof(self->barriers));
+}
+
+void InputStreamCopy(InputStream* self, const InputStream* source)
+{
+	assert(!self->readOnly && !source->readOnly);
+	assert(self->capacity == source->capacity && self->bits.size == source->bits.size);
+
+	memcpy(self->bits.contents, source->bits.contents, source->bits.size);
+	memcpy(self->barriers, source->barriers, sizeof(self->barriers));
+	self->length = source->length;
+}
+
 static usize WrapFrame(const InputStream* self, const u32 frame, const i32 offset)
 {
 	// Note that casting offset to an u32 only works because we also add capacity.
 	return (frame + (u32)offset + self->capacity) % self->capacity;
 }
 
+// Returns the given entry of a binding's history, or zero if the entry is out of bounds (which
+// can only happen to a read-only InputStream).
+static BIT_MASK_ENTRY_TYPE GetEntry(const InputStream* self, const u8 binding, const usize entry)
+{
+	if (binding >= self->totalBindings || entry >= GetEntriesPerHistory(&self->bits))
+	{
+		return 0;
+	}
+
+	return GetHistory(&self->bits, binding)[entry];
+}
+
+// Returns the state of a binding over the `buffer + 1` frames leading up to (and including) the
+// given frame; bit `buffer - i` represents `frame - i`.
+static BIT_MASK_ENTRY_TYPE GetRecentHistory(
+	const InputStream* self,
+	const u8 binding,
+	const usize buffer,
+	const u32 frame
+)
+{
+	assert(buffer < BIT_MASK_ENTRY_TOTAL_BITS);
+
+	const usize start = WrapFrame(self, WrapFrame(self, frame, 0), -(i32)buffer);
+	const usize entry = start / BIT_MASK_ENTRY_TOTAL_BITS;
+	const usize offset = start % BIT_MASK_ENTRY_TOTAL_BITS;
+
+	BIT_MASK_ENTRY_TYPE history = GetEntry(self, binding, entry) >> offset;
+
+	// The frames may straddle two entries (or wrap around to the start of the ring).
+	if (offset + buffer >= BIT_MASK_ENTRY_TOTAL_BITS)
+	{
+		const usize next = (entry + 1) % (self->capacity / BIT_MASK_ENTRY_TOTAL_BITS);
+
+		history |= GetEntry(self, binding, next) << (BIT_MASK_ENTRY_TOTAL_BITS - offset);
+	}
+
+	return history;
+}
+
+// Returns true if a barrier was placed within the given amount of frames before `frame`.
+static bool IsConsumed(
+	const InputStream* self,
+	const u8 binding,
+	const usize frames,
+	const u32 frame
+)
+{
+	// Frames before the very first frame are never considered consumed.
+	const u32 earliest = frames < frame ? frame - frames : 0;
+
+	return frame > 0 && earliest < self->barriers[binding];
+}
+
 void InputStreamPush(InputStream* self, const bool* payload)
 {
+	if (self->readOnly)
+	{
+		return;
+	}
+
 	const usize wrapped = WrapFrame(self, self->length, 0);
 
 	for (usize i = 0; i < self->totalBindings; ++i)
@@ -76,7 +275,7 @@ void InputStreamPush(InputStream* self, const bool* payload)
 		const usize binding = i;
 		const bool isBindingPressed = payload[binding];
 
-		BitMaskSet(&self->bits, binding, wrapped, isBindingPressed);
+		BitMaskSet(&self->bits, wrapped, binding, isBindingPressed);
 	}
 
 	self->length += 1;
@@ -85,8 +284,9 @@ void InputStreamPush(InputStream* self, const bool* payload)
 bool InputStreamPressing(const InputStream* self, const u8 binding, const u32 frame)
 {
 	const usize wrapped = WrapFrame(self, frame, 0);
+	const BIT_MASK_ENTRY_TYPE entry = GetEntry(self, binding, wrapped / BIT_MASK_ENTRY_TOTAL_BITS);
 
-	return BitMaskGet(&self->bits, binding, wrapped);
+	return ((entry >> (wrapped % BIT_MASK_ENTRY_TOTAL_BITS)) & 1) == 1;
 }
 
 bool InputStreamPressed(
@@ -96,34 +296,29 @@ bool InputStreamPressed(
 	const u32 frame
 )
 {
-	const usize wrapped = WrapFrame(self, frame, 0);
+	const BIT_MASK_ENTRY_TYPE history = GetRecentHistory(self, binding, buffer, frame);
 
 	// Make sure the player is currently holding down the button.
-	if (!InputStreamPressing(self, binding, wrapped))
+	if (((history >> buffer) & 1) == 0)
 	{
 		return false;
 	}
 
 	// If the player was not holding down the button at any time in the range
 	// [frame - buffer, frame) then the button can be considered just pressed.
-	for (usize i = 1; i <= buffer; ++i)
-	{
-		const usize offsetFrame = WrapFrame(self, wrapped, -i);
+	const BIT_MASK_ENTRY_TYPE released = ~history & (((BIT_MASK_ENTRY_TYPE)1 << buffer) - 1);
 
-		// Make sure the pressed event has not already been consumed.
-		if (frame - i < self->barriers[binding])
-		{
-			return false;
-		}
-
-		if (!InputStreamPressing(self, binding, offsetFrame))
-		{
-			return true;
-		}
+	// The player has held the button down for too long to be considered just pressed.
+	if (released == 0)
+	{
+		return false;
 	}
 
-	// The player has held the button down for too long to be considered just pressed.
-	return false;
+	// The amount of frames since the player last released the button.
+	const usize elapsed = buffer - (BIT_MASK_ENTRY_TOTAL_BITS - 1 - __builtin_clzll(released));
+
+	// Make sure the pressed event has not already been consumed.
+	return !IsConsumed(self, binding, elapsed, frame);
 }
 
 bool InputStreamReleased(
@@ -133,34 +328,29 @@ bool InputStreamReleased(
 	const u32 frame
 )
 {
-	const usize wrapped = WrapFrame(self, frame, 0);
+	const BIT_MASK_ENTRY_TYPE history = GetRecentHistory(self, binding, buffer, frame);
 
 	// Make sure the player is not currently holding down the button.
-	if (InputStreamPressing(self, binding, wrapped))
+	if (((history >> buffer) & 1) == 1)
 	{
 		return false;
 	}
 
 	// If the player was holding down the button at any time in the range [frame - buffer, frame)
 	// then the button can be considered just released.
-	for (usize i = 1; i <= buffer; ++i)
-	{
-		const usize offsetFrame = WrapFrame(self, wrapped, -i);
+	const BIT_MASK_ENTRY_TYPE pressed = history & (((BIT_MASK_ENTRY_TYPE)1 << buffer) - 1);
 
-		// Make sure the released event has not already been consumed.
-		if (frame - i < self->barriers[binding])
-		{
-			return false;
-		}
-
-		if (InputStreamPressing(self, binding, offsetFrame))
-		{
-			return true;
-		}
+	// The player has not pressed the button recently enough to be considered just released.
+	if (pressed == 0)
+	{
+		return false;
 	}
 
-	// The player has not pressed the button recently enough to be considered just released.
-	return false;
+	// The amount of frames since the player last held down the button.
+	const usize elapsed = buffer - (BIT_MASK_ENTRY_TOTAL_BITS - 1 - __builtin_clzll(pressed));
+
+	// Make sure the released event has not already been consumed.
+	return !IsConsumed(self, binding, elapsed, frame);
 }
 
 void InputStreamConsume(InputStream* self, const u8 binding, const u32 frame)
@@ -170,12 +360,25 @@ void InputStreamConsume(InputStream* self, const u8 binding, const u32 frame)
 
 void InputStreamDestroy(InputStream* self)
 {
-	BitMaskDestroy(&self->bits);
+	// A read-only InputStream does not own its bits.
+	if (self->readOnly)
+	{
+		return;
+	}
 
-	free(self->barriers);
+	BitMaskDestroy(&self->bits);
 }
 
 ReplayResult ReplayTryFromInputStream(const u32 seed, const InputStream* stream)
+{
+	return ReplayTryFromInputStreamUntil(seed, stream, stream->length);
+}
+
+ReplayResult ReplayTryFromInputStreamUntil(
+	const u32 seed,
+	const InputStream* stream,
+	const u32 frames
+)
 {
 	if (stream->length >= stream->capacity)
 	{
@@ -186,16 +389,31 @@ ReplayResult ReplayTryFromInputStream(const u32 seed, const InputStream* stream)
 	}
 
 	const u8 totalBindings = stream->totalBindings;
-	const u32 length = stream->length;
-	const BitMask bits = BitMaskCreate(totalBindings, stream->length);
+	const u32 length = frames < stream->length ? frames : stream->length;
+	const BitMask bits = CreateHistories(totalBindings, length);
+
+	const usize entries = GetEntriesPerHistory(&bits);
+	const BIT_MASK_ENTRY_TYPE trailingMask = GetTrailingMask(length);
+
+	for (u8 binding = 0; binding < totalBindings; ++binding)
+	{
+		BIT_MASK_ENTRY_TYPE* history = GetHistory(&bits, binding);
 
-	memcpy(bits.contents, stream->bits.contents, bits.size);
+		memcpy(history, GetHistory(&stream->bits, binding), entries * BIT_MASK_ENTRY_SIZE);
+
+		// Make sure the padding at the end of the history is zeroed out.
+		if (trailingMask != 0)
+		{
+			history[entries - 1] &= trailingMask;
+		}
+	}
 
 	return (ReplayResult) {
 		.type = REPLAY_RESULT_TYPE_OK,
 		.contents.ok =
 			(Replay) {
 				.seed = seed,
+				.flags = REPLAY_FLAGS_CURRENT,
 				.totalBindings = totalBindings,
 				.length = length,
 				.bits = bits,
@@ -203,67 +421,446 @@ ReplayResult ReplayTryFromInputStream(const u32 seed, const InputStream* stream)
 	};
 }
 
-ReplayResult ReplayTryFromBytes(const u8* data, const usize size)
+static ReplayResult ReplayResultErr(const ReplayError error)
 {
-	if (size < SIGNATURE_SIZE)
+	return (ReplayResult) {
+		.type = REPLAY_RESULT_TYPE_ERR,
+		.contents.err = error,
+	};
+}
+
+static void FillPressed(BitMask* bits, const u8 binding, const u32 start, const u32 end)
+{
+	for (u32 frame = start; frame < end; ++frame)
 	{
-		return (ReplayResult) {
-			.type = REPLAY_RESULT_TYPE_ERR,
-			.contents.err = REPLAY_ERROR_TOO_FEW_BYTES,
-		};
+		BitMaskSet(bits, frame, binding, true);
+	}
+}
+
+static bool DecodeToggles(
+	BitMask* bits,
+	const u8* body,
+	const usize bodySize,
+	const u8 totalBindings,
+	const u32 length
+)
+{
+	if (totalBindings == 0)
+	{
+		return bodySize == 0;
 	}
 
-	u8* head = (u8*)data;
+	// The frame each binding started being pressed, or NOT_PRESSED if the binding is released.
+	u32 pressedSince[UINT8_MAX + 1];
 
-	if (memcmp(head, signature, SIGNATURE_SIZE) != 0)
+	for (usize i = 0; i < totalBindings; ++i)
 	{
-		return (ReplayResult) {
-			.type = REPLAY_RESULT_TYPE_ERR,
-			.contents.err = REPLAY_ERROR_SIGNATURE_MISMATCH,
-		};
+		pressedSince[i] = NOT_PRESSED;
+	}
+
+	u64 frame = 0;
+	usize offset = 0;
+
+	while (offset < bodySize)
+	{
+		u64 value;
+		const usize read = U64FromVarint(body + offset, bodySize - offset, &value);
+
+		if (read == 0)
+		{
+			return false;
+		}
+
+		offset += read;
+
+		const u64 delta = value / totalBindings;
+		const u8 binding = value % totalBindings;
+
+		if (delta >= length - frame)
+		{
+			return false;
+		}
+
+		frame += delta;
+
+		if (pressedSince[binding] == NOT_PRESSED)
+		{
+			pressedSince[binding] = frame;
+		}
+		else
+		{
+			FillPressed(bits, binding, pressedSince[binding], frame);
+			pressedSince[binding] = NOT_PRESSED;
+		}
+	}
+
+	for (usize i = 0; i < totalBindings; ++i)
+	{
+		if (pressedSince[i] != NOT_PRESSED)
+		{
+			FillPressed(bits, i, pressedSince[i], length);
+		}
+	}
+
+	return true;
+}
+
+ReplayToggleEncoder ReplayToggleEncoderCreate(const u8 totalBindings)
+{
+	return (ReplayToggleEncoder) {
+		.totalBindings = totalBindings,
+		.length = 0,
+		.previousToggle = 0,
+		.previous = { false },
+	};
+}
+
+usize ReplayToggleEncoderPush(ReplayToggleEncoder* self, const bool* payload, u8* out)
+{
+	u8 scratch[VARINT_MAX_SIZE];
+
+	const u32 frame = self->length;
+	usize size = 0;
+
+	for (u8 binding = 0; binding < self->totalBindings; ++binding)
+	{
+		if (payload[binding] == self->previous[binding])
+		{
+			continue;
+		}
+
+		self->previous[binding] = payload[binding];
+
+		const u64 value = ((u64)(frame - self->previousToggle) * self->totalBindings) + binding;
+		size += U64ToVarint(value, out == NULL ? scratch : out + size);
+
+		self->previousToggle = frame;
+	}
+
+	self->length += 1;
+
+	return size;
+}
+
+// Writes every toggle in a given Replay as a varint (if `out` is not NULL), and returns the
+// amount of bytes required to do so. Encoding stops early once `limit` bytes have been reached, in
+// which case `out` must have room for `limit + totalBindings * VARINT_MAX_SIZE` bytes.
+static usize EncodeToggles(const Replay* replay, u8* out, const usize limit)
+{
+	ReplayToggleEncoder encoder = ReplayToggleEncoderCreate(replay->totalBindings);
+
+	bool payload[UINT8_MAX + 1];
+	usize size = 0;
+
+	for (u32 frame = 0; frame < replay->length; ++frame)
+	{
+		for (u8 binding = 0; binding < replay->totalBindings; ++binding)
+		{
+			payload[binding] = BitMaskGet(&replay->bits, frame, binding);
+		}
+
+		size += ReplayToggleEncoderPush(&encoder, payload, out == NULL ? NULL : out + size);
+
+		if (size >= limit)
+		{
+			break;
+		}
 	}
-	head += SIGNATURE_SIZE;
 
+	return size;
+}
+
+typedef struct
+{
 	u32 seed;
+	u8 flags;
+	u8 totalBindings;
+	u32 length;
+	ReplayEncoding encoding;
+	usize headerSize;
+} ReplayHeader;
+
+static bool ReplayHeaderTryRead(
+	const u8* data,
+	const usize size,
+	ReplayHeader* header,
+	ReplayError* error
+)
+{
+	if (size < SIGNATURE_SIZE)
+	{
+		*error = REPLAY_ERROR_TOO_FEW_BYTES;
+		return false;
+	}
+
+	u8* head = NULL;
+
+	if (memcmp(data, signature, SIGNATURE_SIZE) == 0)
+	{
+		if (size < V1_HEADER_SIZE)
+		{
+			*error = REPLAY_ERROR_TOO_FEW_BYTES;
+			return false;
+		}
+
+		// Version 1 Replays always store their input raw.
+		header->flags = 0;
+		header->encoding = REPLAY_ENCODING_RAW;
+		header->headerSize = V1_HEADER_SIZE;
+		head = (u8*)data + SIGNATURE_SIZE;
+	}
+	else
+	{
+		if (memcmp(data, signature, VERSIONED_SIGNATURE_SIZE) != 0)
+		{
+			*error = REPLAY_ERROR_SIGNATURE_MISMATCH;
+			return false;
+		}
+
+		const u8 version = data[VERSIONED_SIGNATURE_SIZE];
+
+		if (version < MIN_REPLAY_VERSION || version > REPLAY_VERSION)
+		{
+			*error = REPLAY_ERROR_UNSUPPORTED_VERSION;
+			return false;
+		}
+
+		if (size < REPLAY_HEADER_SIZE)
+		{
+			*error = REPLAY_ERROR_TOO_FEW_BYTES;
+			return false;
+		}
+
+		// The encoding and the flags are the last two fields; version 2 only had padding after the
+		// encoding.
+		header->encoding = data[REPLAY_HEADER_LENGTH_OFFSET + sizeof(u32)];
+		header->flags = version >= 3 ? data[REPLAY_HEADER_LENGTH_OFFSET + sizeof(u32) + 1] : 0;
+		header->headerSize = REPLAY_HEADER_SIZE;
+		head = (u8*)data + VERSIONED_SIGNATURE_SIZE + sizeof(u8);
+	}
+
 	{
-		const usize tmp = sizeof(seed);
-		memcpy(&seed, head, tmp);
+		const usize tmp = sizeof(header->seed);
+		memcpy(&header->seed, head, tmp);
 		head += tmp;
 
 		// Note that the replay stores seed using big-endian byte ordering.
-		seed = U32FromBigEndian(seed);
+		header->seed = U32FromBigEndian(header->seed);
 	}
 
-	u8 totalBindings;
 	{
-		const usize tmp = sizeof(totalBindings);
-		memcpy(&totalBindings, head, tmp);
+		const usize tmp = sizeof(header->totalBindings);
+		memcpy(&header->totalBindings, head, tmp);
 		head += tmp;
 	}
 
-	u32 length;
 	{
-		const usize tmp = sizeof(length);
-		memcpy(&length, head, tmp);
+		const usize tmp = sizeof(header->length);
+		memcpy(&header->length, head, tmp);
 		head += tmp;
 
 		// Note that the replay stores length using big-endian byte ordering.
-		length = U32FromBigEndian(length);
+		header->length = U32FromBigEndian(header->length);
+	}
+
+	return true;
+}
+
+// Converts the frame-major bits of REPLAY_ENCODING_RAW into (zeroed out) binding-major histories.
+static void TransposeFromRaw(BitMask* histories, const BitMask* raw)
+{
+	const usize entries = raw->size / BIT_MASK_ENTRY_SIZE;
+
+	// Only the bits that are set need to be visited.
+	for (usize i = 0; i < entries; ++i)
+	{
+		for (BIT_MASK_ENTRY_TYPE entry = raw->contents[i]; entry != 0; entry &= entry - 1)
+		{
+			const usize index = (i * BIT_MASK_ENTRY_TOTAL_BITS) + __builtin_ctzll(entry);
+
+			// Ignore any bits in the padding at the very end.
+			if (index >= raw->width * raw->height)
+			{
+				break;
+			}
+
+			BitMaskSet(histories, index / raw->width, index % raw->width, true);
+		}
+	}
+}
+
+// Converts binding-major histories into the (zeroed out) frame-major bits of REPLAY_ENCODING_RAW.
+static void TransposeToRaw(BitMask* raw, const BitMask* histories)
+{
+	const usize entries = histories->size / BIT_MASK_ENTRY_SIZE;
+
+	for (usize i = 0; i < entries; ++i)
+	{
+		for (BIT_MASK_ENTRY_TYPE entry = histories->contents[i]; entry != 0; entry &= entry - 1)
+		{
+			const usize index = (i * BIT_MASK_ENTRY_TOTAL_BITS) + __builtin_ctzll(entry);
+
+			BitMaskSet(raw, index / histories->width, index % histories->width, true);
+		}
+	}
+}
+
+// Returns true if every frame past the end of each history is zeroed out.
+static bool IsPaddingZeroed(const BitMask* histories, const u8 totalBindings, const u32 length)
+{
+	const BIT_MASK_ENTRY_TYPE trailingMask = GetTrailingMask(length);
+
+	if (trailingMask == 0)
+	{
+		return true;
 	}
 
-	const BitMask bits = BitMaskCreate(totalBindings, length);
+	const usize last = GetEntriesPerHistory(histories) - 1;
+
+	for (u8 binding = 0; binding < totalBindings; ++binding)
 	{
-		memcpy(bits.contents, head, bits.size);
-		head += bits.size;
+		if ((GetHistory(histories, binding)[last] & ~trailingMask) != 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+ReplayResult ReplayTryFromBytes(const u8* data, const usize size)
+{
+	ReplayHeader header;
+	ReplayError error;
+
+	if (!ReplayHeaderTryRead(data, size, &header, &error))
+	{
+		return ReplayResultErr(error);
+	}
+
+	const u8* body = data + header.headerSize;
+	const usize bodySize = size - header.headerSize;
+
+	BitMask bits = CreateHistories(header.totalBindings, header.length);
+
+	switch (header.encoding)
+	{
+		case REPLAY_ENCODING_RAW: {
+			BitMask raw = BitMaskCreate(header.totalBindings, header.length);
+
+			if (bodySize < raw.size)
+			{
+				BitMaskDestroy(&raw);
+				BitMaskDestroy(&bits);
+
+				return ReplayResultErr(REPLAY_ERROR_TOO_FEW_BYTES);
+			}
+
+			memcpy(raw.contents, body, raw.size);
+			TransposeFromRaw(&bits, &raw);
+
+			BitMaskDestroy(&raw);
+
+			break;
+		}
+		case REPLAY_ENCODING_PLANAR: {
+			if (bodySize < bits.size)
+			{
+				BitMaskDestroy(&bits);
+
+				return ReplayResultErr(REPLAY_ERROR_TOO_FEW_BYTES);
+			}
+
+			memcpy(bits.contents, body, bits.size);
+
+			if (!IsPaddingZeroed(&bits, header.totalBindings, header.length))
+			{
+				BitMaskDestroy(&bits);
+
+				return ReplayResultErr(REPLAY_ERROR_MALFORMED_BODY);
+			}
+
+			break;
+		}
+		case REPLAY_ENCODING_TOGGLES: {
+			if (!DecodeToggles(&bits, body, bodySize, header.totalBindings, header.length))
+			{
+				BitMaskDestroy(&bits);
+
+				return ReplayResultErr(REPLAY_ERROR_MALFORMED_BODY);
+			}
+
+			break;
+		}
+		default: {
+			BitMaskDestroy(&bits);
+
+			return ReplayResultErr(REPLAY_ERROR_UNSUPPORTED_ENCODING);
+		}
 	}
 
 	return (ReplayResult) {
 		.type = REPLAY_RESULT_TYPE_OK,
 		.contents.ok =
 			(Replay) {
-				.seed = seed,
-				.totalBindings = totalBindings,
-				.length = length,
+				.seed = header.seed,
+				.flags = header.flags,
+				.totalBindings = header.totalBindings,
+				.length = header.length,
+				.bits = bits,
+			},
+	};
+}
+
+ReplayResult ReplayTryViewBytes(const u8* data, const usize size)
+{
+	ReplayHeader header;
+	ReplayError error;
+
+	if (!ReplayHeaderTryRead(data, size, &header, &error))
+	{
+		return ReplayResultErr(error);
+	}
+
+	const u8* body = data + header.headerSize;
+	const usize bodySize = size - header.headerSize;
+
+	// The bits can only be used in place if they are stored exactly like they are in memory (and
+	// are properly aligned).
+	if (header.encoding != REPLAY_ENCODING_PLANAR || (uintptr_t)body % BIT_MASK_ENTRY_SIZE != 0
+		|| header.length >= MAX_REPLAY_LENGTH)
+	{
+		return ReplayResultErr(REPLAY_ERROR_UNVIEWABLE_BODY);
+	}
+
+	const usize width = RoundUpToEntry(header.length);
+	const usize entries = width / BIT_MASK_ENTRY_TOTAL_BITS * header.totalBindings;
+
+	const BitMask bits = (BitMask) {
+		.width = width,
+		.height = header.totalBindings,
+		.contents = (BIT_MASK_ENTRY_TYPE*)body,
+		.size = entries * BIT_MASK_ENTRY_SIZE,
+	};
+
+	if (bodySize < bits.size)
+	{
+		return ReplayResultErr(REPLAY_ERROR_TOO_FEW_BYTES);
+	}
+
+	if (!IsPaddingZeroed(&bits, header.totalBindings, header.length))
+	{
+		return ReplayResultErr(REPLAY_ERROR_MALFORMED_BODY);
+	}
+
+	return (ReplayResult) {
+		.type = REPLAY_RESULT_TYPE_OK,
+		.contents.ok =
+			(Replay) {
+				.seed = header.seed,
+				.flags = header.flags,
+				.totalBindings = header.totalBindings,
+				.length = header.length,
 				.bits = bits,
 			},
 	};
@@ -274,29 +871,33 @@ void ReplayDestroy(Replay* self)
 	BitMaskDestroy(&self->bits);
 }
 
-ReplayBytes ReplayBytesFromReplay(const Replay* replay)
+void ReplayHeaderWrite(
+	u8* out,
+	const u32 seed,
+	const u8 flags,
+	const u8 totalBindings,
+	const u32 length,
+	const ReplayEncoding encoding
+)
 {
-	const u32 seed = replay->seed;
-	const u8 totalBindings = replay->totalBindings;
-	const u32 length = replay->length;
+	const u8 version = REPLAY_VERSION;
+	const u8 encodingByte = encoding;
 
-	// clang-format off
-	const usize size = 0
-		+ sizeof(signature)
-		+ sizeof(seed)
-		+ sizeof(totalBindings)
-		+ sizeof(length)
-		+ replay->bits.size;
-	// clang-format on
+	// Make sure the header's padding is zeroed out.
+	memset(out, 0, REPLAY_HEADER_SIZE);
 
-	u8* data = malloc(size);
-	u8* head = data;
+	u8* head = out;
 
 	{
-		const usize tmp = sizeof(signature);
+		const usize tmp = VERSIONED_SIGNATURE_SIZE;
 		memcpy(head, signature, tmp);
 		head += tmp;
 	}
+	{
+		const usize tmp = sizeof(version);
+		memcpy(head, &version, tmp);
+		head += tmp;
+	}
 	{
 		const u32 seedButInBigEndian = U32ToBigEndian(seed);
 
@@ -310,6 +911,8 @@ ReplayBytes ReplayBytesFromReplay(const Replay* replay)
 		head += tmp;
 	}
 	{
+		assert(head == out + REPLAY_HEADER_LENGTH_OFFSET);
+
 		const u32 lengthButInBigEndian = U32ToBigEndian(length);
 
 		const usize tmp = sizeof(lengthButInBigEndian);
@@ -317,10 +920,117 @@ ReplayBytes ReplayBytesFromReplay(const Replay* replay)
 		head += tmp;
 	}
 	{
-		const usize tmp = replay->bits.size;
-		memcpy(head, replay->bits.contents, tmp);
+		const usize tmp = sizeof(encodingByte);
+		memcpy(head, &encodingByte, tmp);
 		head += tmp;
 	}
+	{
+		const usize tmp = sizeof(flags);
+		memcpy(head, &flags, tmp);
+		head += tmp;
+	}
+
+	assert(head == out + REPLAY_HEADER_SIZE);
+}
+
+ReplayBytes ReplayBytesFromReplay(const Replay* replay)
+{
+	// Toggles are only worth it while they are smaller than the planar body, so they are encoded
+	// once, straight into a buffer that fits either, and abandoned as soon as they stop being so.
+	const usize planarSize = replay->bits.size;
+	const usize capacity
+		= REPLAY_HEADER_SIZE + planarSize + (usize)replay->totalBindings * VARINT_MAX_SIZE;
+
+	u8* data = malloc(capacity);
+	u8* body = data + REPLAY_HEADER_SIZE;
+
+	ReplayEncoding encoding = REPLAY_ENCODING_TOGGLES;
+	usize bodySize = EncodeToggles(replay, body, planarSize);
+
+	if (bodySize >= planarSize)
+	{
+		encoding = REPLAY_ENCODING_PLANAR;
+		bodySize = planarSize;
+
+		memcpy(body, replay->bits.contents, planarSize);
+	}
+
+	ReplayHeaderWrite(
+		data,
+		replay->seed,
+		replay->flags,
+		replay->totalBindings,
+		replay->length,
+		encoding
+	);
+
+	return (ReplayBytes) {
+		.data = data,
+		.size = REPLAY_HEADER_SIZE + bodySize,
+	};
+}
+
+static usize GetBodySize(const Replay* replay, const ReplayEncoding encoding)
+{
+	switch (encoding)
+	{
+		case REPLAY_ENCODING_RAW: {
+			const usize area = (usize)replay->totalBindings * replay->length;
+
+			return (area + BIT_MASK_ENTRY_TOTAL_BITS - 1) / BIT_MASK_ENTRY_TOTAL_BITS
+				   * BIT_MASK_ENTRY_SIZE;
+		}
+		case REPLAY_ENCODING_TOGGLES: {
+			return EncodeToggles(replay, NULL, SIZE_MAX);
+		}
+		case REPLAY_ENCODING_PLANAR: {
+			return replay->bits.size;
+		}
+		default: {
+			return 0;
+		}
+	}
+}
+
+ReplayBytes ReplayBytesFromReplayWithEncoding(const Replay* replay, const ReplayEncoding encoding)
+{
+	const usize bodySize = GetBodySize(replay, encoding);
+	const usize size = REPLAY_HEADER_SIZE + bodySize;
+
+	u8* data = malloc(size);
+
+	ReplayHeaderWrite(
+		data,
+		replay->seed,
+		replay->flags,
+		replay->totalBindings,
+		replay->length,
+		encoding
+	);
+
+	u8* head = data + REPLAY_HEADER_SIZE;
+
+	switch (encoding)
+	{
+		case REPLAY_ENCODING_RAW: {
+			BitMask raw = BitMaskCreate(replay->totalBindings, replay->length);
+
+			TransposeToRaw(&raw, &replay->bits);
+			memcpy(head, raw.contents, bodySize);
+
+			BitMaskDestroy(&raw);
+
+			break;
+		}
+		case REPLAY_ENCODING_TOGGLES: {
+			EncodeToggles(replay, head, SIZE_MAX);
+			break;
+		}
+		case REPLAY_ENCODING_PLANAR: {
+			memcpy(head, replay->bits.contents, bodySize);
+			break;
+		}
+	}
 
 	return (ReplayBytes) {
 		.data = data,
@@ -12,6 +12,19 @@
 // Derived by solving for x in the given equation: ((2^8 - 1) * x) / 64 = 2^32 - 1
 #define MAX_REPLAY_LENGTH (1077952576)
 
+// The size of a (version 2+) Replay's header; the Replay's input immediately follows it.
+#define REPLAY_HEADER_SIZE (16)
+// The offset of a (version 2+) Replay's length, which is stored as a big-endian u32.
+#define REPLAY_HEADER_LENGTH_OFFSET (10)
+
+// The flags of every Replay recorded by this build of the game (see ReplayFlag). Building with
+// FIXED_POINT_PHYSICS defined records Replays that integrate kinematics with fixed-point numbers.
+#if defined(FIXED_POINT_PHYSICS)
+	#define REPLAY_FLAGS_CURRENT (REPLAY_FLAG_COUNTER_RNG | REPLAY_FLAG_FIXED_POINT)
+#else
+	#define REPLAY_FLAGS_CURRENT (REPLAY_FLAG_COUNTER_RNG)
+#endif
+
 typedef uint32_t u32;
 
 typedef enum
@@ -25,20 +38,55 @@ typedef enum
 	REPLAY_ERROR_INVALIDATED_INPUT_STREAM,
 	REPLAY_ERROR_TOO_FEW_BYTES,
 	REPLAY_ERROR_SIGNATURE_MISMATCH,
+	REPLAY_ERROR_UNSUPPORTED_VERSION,
+	REPLAY_ERROR_UNSUPPORTED_ENCODING,
+	REPLAY_ERROR_MALFORMED_BODY,
+	REPLAY_ERROR_UNVIEWABLE_BODY,
+	REPLAY_ERROR_UNREADABLE_FILE,
 } ReplayError;
 
+// Describes how the input of a (version 2) Replay is laid out on disk.
+typedef enum
+{
+	// Every frame's bits one after another; this is how version 1 Replays are stored.
+	REPLAY_ENCODING_RAW = 0,
+	// A log of every frame a binding was either pressed or released, stored as varints.
+	REPLAY_ENCODING_TOGGLES = 1,
+	// Every binding's history one after another (each padded to a whole number of 64-bit words).
+	// This is exactly how a Replay is laid out in memory, so it can be viewed in place.
+	REPLAY_ENCODING_PLANAR = 2,
+} ReplayEncoding;
+
 typedef struct
 {
 	u8 totalBindings;
 	u32 capacity;
 	u32 length;
-	u32* barriers;
+	u32 barriers[UINT8_MAX + 1];
+	// Stored binding-major; every binding's history is contiguous (see REPLAY_ENCODING_PLANAR).
 	BitMask bits;
+	// A read-only InputStream borrows its bits (see InputStreamCreateView) and ignores pushes.
+	bool readOnly;
 } InputStream;
 
+// Describes how the simulation that recorded a Replay behaved; a Replay only plays back correctly
+// if it is simulated the same way. Anything before version 3 has no flags.
+typedef enum
+{
+	// Levels were generated by a counter-based Rng rather than a sequential one (see RngCreate).
+	REPLAY_FLAG_COUNTER_RNG = 1 << 0,
+	// Kinematics were integrated with fixed-point numbers (see SKineticUpdate), and gameplay's
+	// oscillations were evaluated without libm (see FixedSin). Collisions and the player's velocity
+	// are still resolved with floats; those only use basic arithmetic, which plays back the same
+	// as long as builds never fuse it (see cflags.src.determinism).
+	REPLAY_FLAG_FIXED_POINT = 1 << 1,
+} ReplayFlag;
+
 typedef struct
 {
 	u32 seed;
+	// Any combination of ReplayFlag.
+	u8 flags;
 	u8 totalBindings;
 	u32 length;
 	BitMask bits;
@@ -60,10 +108,30 @@ typedef struct
 	usize size;
 } ReplayBytes;
 
+// Incrementally encodes frames of input using REPLAY_ENCODING_TOGGLES.
+typedef struct
+{
+	u8 totalBindings;
+	u32 length;
+	u32 previousToggle;
+	bool previous[UINT8_MAX + 1];
+} ReplayToggleEncoder;
+
 const char* StringFromReplayError(ReplayError error);
 
 InputStream InputStreamCreate(u8 totalBindings, u32 capacity);
+// Creates a read-only InputStream that plays back the given Replay without copying its bits.
+// Every frame past the end of the Replay is treated as if nothing was pressed.
+InputStream InputStreamCreateView(const Replay* replay);
 bool InputStreamLoadReplay(InputStream* self, const Replay* replay) MUST_USE;
+// Forgets every frame pushed so far (and every consumed input), as if the InputStream was new.
+void InputStreamClear(InputStream* self);
+// Forgets everything, then picks up where `source` left off right before the given frame: the most
+// recent history (and every consumed input) is copied over, and the next push lands on `frame`.
+void InputStreamContinue(InputStream* self, const InputStream* source, u32 frame);
+// Copies every frame (and every consumed input) of an InputStream with the same bindings and
+// capacity, without allocating.
+void InputStreamCopy(InputStream* self, const InputStream* source);
 void InputStreamPush(InputStream* self, const bool* payload);
 bool InputStreamPressing(const InputStream* self, u8 binding, u32 frame);
 bool InputStreamPressed(const InputStream* self, u8 binding, usize buffer, u32 frame);
@@ -71,9 +139,33 @@ bool InputStreamReleased(const InputStream* self, u8 binding, usize buffer, u32
 void InputStreamConsume(InputStream* self, u8 binding, u32 frame);
 void InputStreamDestroy(InputStream* self);
 
+// The resulting Replay is assumed to have been recorded by this version of the game (i.e. it has
+// REPLAY_FLAGS_CURRENT).
 ReplayResult ReplayTryFromInputStream(u32 seed, const InputStream* stream);
+// Like ReplayTryFromInputStream, except only the first `frames` frames of input are kept (e.g. to
+// cut a Replay off right where something happened).
+ReplayResult ReplayTryFromInputStreamUntil(u32 seed, const InputStream* stream, u32 frames);
 ReplayResult ReplayTryFromBytes(const u8* data, usize size);
+// Like ReplayTryFromBytes, except the Replay's bits point directly into the given data rather
+// than a copy of it; this only works for REPLAY_ENCODING_PLANAR. Do not ReplayDestroy the result.
+ReplayResult ReplayTryViewBytes(const u8* data, usize size);
 void ReplayDestroy(Replay* self);
 
+// Serializes a Replay using whichever encoding results in the fewest bytes.
 ReplayBytes ReplayBytesFromReplay(const Replay* replay);
+ReplayBytes ReplayBytesFromReplayWithEncoding(const Replay* replay, ReplayEncoding encoding);
 void ReplayBytesDestroy(ReplayBytes* self);
+
+void ReplayHeaderWrite(
+	u8* out,
+	u32 seed,
+	u8 flags,
+	u8 totalBindings,
+	u32 length,
+	ReplayEncoding encoding
+);
+
+ReplayToggleEncoder ReplayToggleEncoderCreate(u8 totalBindings);
+// Encodes a single frame of input into `out` (if it is not NULL), and returns the amount of bytes
+// required to do so. Note that at most `totalBindings * VARINT_MAX_SIZE` bytes are ever written.
+usize ReplayToggleEncoderPush(ReplayToggleEncoder* self, const bool* payload, u8* out);
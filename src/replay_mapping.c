@@ -0,0 +1,174 @@
+#include "replay_mapping.h"
+
+#include "replay.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Browsers (and Windows, for now) do not get mmap; the file is read into memory instead.
+#if !defined(PLATFORM_WEB) && !defined(_WIN32)
+	#define REPLAY_MAPPING_MMAP
+
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+static ReplayMappingResult ReplayMappingResultErr(const ReplayError error)
+{
+	return (ReplayMappingResult) {
+		.type = REPLAY_RESULT_TYPE_ERR,
+		.contents.err = error,
+	};
+}
+
+#if defined(REPLAY_MAPPING_MMAP)
+static bool Map(const char* path, void** data, usize* size)
+{
+	const int descriptor = open(path, O_RDONLY);
+
+	if (descriptor == -1)
+	{
+		return false;
+	}
+
+	struct stat status;
+
+	if (fstat(descriptor, &status) == -1 || status.st_size == 0)
+	{
+		close(descriptor);
+
+		return false;
+	}
+
+	void* mapped = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+	// The mapping remains valid after the file is closed.
+	close(descriptor);
+
+	if (mapped == MAP_FAILED)
+	{
+		return false;
+	}
+
+	// Playback reads the input from front to back.
+	madvise(mapped, status.st_size, MADV_SEQUENTIAL);
+
+	*data = mapped;
+	*size = status.st_size;
+
+	return true;
+}
+
+static void Unmap(void* data, const usize size)
+{
+	munmap(data, size);
+}
+#else
+static bool Map(const char* path, void** data, usize* size)
+{
+	FILE* file = fopen(path, "rb");
+
+	if (file == NULL)
+	{
+		return false;
+	}
+
+	fseek(file, 0, SEEK_END);
+	const long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	if (length <= 0)
+	{
+		fclose(file);
+
+		return false;
+	}
+
+	// Note that malloc's alignment is sufficient for ReplayTryViewBytes.
+	void* contents = malloc(length);
+
+	if (fread(contents, sizeof(u8), length, file) != (usize)length)
+	{
+		free(contents);
+		fclose(file);
+
+		return false;
+	}
+
+	fclose(file);
+
+	*data = contents;
+	*size = length;
+
+	return true;
+}
+
+static void Unmap(void* data, __attribute__((unused)) const usize size)
+{
+	free(data);
+}
+#endif
+
+ReplayMappingResult ReplayMappingTryOpen(const char* path)
+{
+	void* data;
+	usize size;
+
+	if (!Map(path, &data, &size))
+	{
+		return ReplayMappingResultErr(REPLAY_ERROR_UNREADABLE_FILE);
+	}
+
+	ReplayResult result = ReplayTryViewBytes(data, size);
+	bool borrowed = true;
+
+	// Fallback to decoding the input if it cannot be used in place.
+	if (result.type == REPLAY_RESULT_TYPE_ERR
+		&& result.contents.err == REPLAY_ERROR_UNVIEWABLE_BODY)
+	{
+		result = ReplayTryFromBytes(data, size);
+		borrowed = false;
+	}
+
+	if (result.type == REPLAY_RESULT_TYPE_ERR)
+	{
+		Unmap(data, size);
+
+		return ReplayMappingResultErr(result.contents.err);
+	}
+
+	// The mapping is no longer needed once the input has been decoded.
+	if (!borrowed)
+	{
+		Unmap(data, size);
+
+		data = NULL;
+		size = 0;
+	}
+
+	return (ReplayMappingResult) {
+		.type = REPLAY_RESULT_TYPE_OK,
+		.contents.ok =
+			(ReplayMapping) {
+				.replay = result.contents.ok,
+				.m_data = data,
+				.m_size = size,
+				.m_borrowed = borrowed,
+			},
+	};
+}
+
+void ReplayMappingDestroy(ReplayMapping* self)
+{
+	if (self->m_borrowed)
+	{
+		Unmap(self->m_data, self->m_size);
+	}
+	else
+	{
+		ReplayDestroy(&self->replay);
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "replay.h"
+
+#include <stdbool.h>
+
+// A Replay file that is mapped into memory rather than read. If the file's input is stored planar,
+// the Replay's bits point directly into the mapping (pass it to InputStreamCreateView for playback
+// without any copies); otherwise, the input is decoded just like ReplayTryFromBytes would.
+typedef struct
+{
+	Replay replay;
+	void* m_data;
+	usize m_size;
+	// True if replay.bits points into m_data.
+	bool m_borrowed;
+} ReplayMapping;
+
+typedef struct
+{
+	ReplayResultType type;
+
+	union {
+		ReplayError err;
+		ReplayMapping ok;
+	} contents;
+} ReplayMappingResult;
+
+ReplayMappingResult ReplayMappingTryOpen(const char* path);
+void ReplayMappingDestroy(ReplayMapping* self);
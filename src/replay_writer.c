@@ -0,0 +1,286 @@
+#include "replay_writer.h"
+
+#include "bytes.h"
+#include "common.h"
+#include "replay.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Browsers (and Windows, for now) do not get a background thread; flushes happen in-place instead.
+#if !defined(PLATFORM_WEB) && !defined(_WIN32)
+	#define REPLAY_WRITER_THREADED
+
+	#include <pthread.h>
+#endif
+
+#define CHUNK_CAPACITY (4096)
+
+// Flush at least every ten seconds worth of input.
+#define CHUNK_MAX_FRAMES (60 * 10)
+
+typedef struct
+{
+	u8 data[CHUNK_CAPACITY];
+	usize size;
+	// The length of the Replay once this chunk has been written.
+	u32 length;
+} ReplayWriterChunk;
+
+struct ReplayWriter
+{
+	FILE* m_file;
+	ReplayToggleEncoder m_encoder;
+	// The chunk that is currently being filled by ReplayWriterPush.
+	ReplayWriterChunk* m_pending;
+	u32 m_pendingFrames;
+	// The chunk that is currently being written to disk.
+	ReplayWriterChunk* m_flushing;
+	ReplayWriterChunk m_chunks[2];
+#if defined(REPLAY_WRITER_THREADED)
+	pthread_t m_thread;
+	pthread_mutex_t m_mutex;
+	pthread_cond_t m_condition;
+	// True if m_flushing has yet to be written to disk.
+	bool m_busy;
+	bool m_quit;
+#endif
+};
+
+static void WriteChunk(FILE* file, const ReplayWriterChunk* chunk)
+{
+	fwrite(chunk->data, sizeof(u8), chunk->size, file);
+
+	// Update the header's length so the file remains a valid Replay.
+	{
+		const u32 lengthButInBigEndian = U32ToBigEndian(chunk->length);
+
+		fseek(file, REPLAY_HEADER_LENGTH_OFFSET, SEEK_SET);
+		fwrite(&lengthButInBigEndian, sizeof(lengthButInBigEndian), 1, file);
+		fseek(file, 0, SEEK_END);
+	}
+
+	fflush(file);
+}
+
+#if defined(REPLAY_WRITER_THREADED)
+static void* ReplayWriterWork(void* arguments)
+{
+	ReplayWriter* self = arguments;
+
+	pthread_mutex_lock(&self->m_mutex);
+
+	while (true)
+	{
+		while (!self->m_busy && !self->m_quit)
+		{
+			pthread_cond_wait(&self->m_condition, &self->m_mutex);
+		}
+
+		if (!self->m_busy)
+		{
+			break;
+		}
+
+		pthread_mutex_unlock(&self->m_mutex);
+		{
+			WriteChunk(self->m_file, self->m_flushing);
+		}
+		pthread_mutex_lock(&self->m_mutex);
+
+		self->m_busy = false;
+		pthread_cond_broadcast(&self->m_condition);
+	}
+
+	pthread_mutex_unlock(&self->m_mutex);
+
+	return NULL;
+}
+#endif
+
+ReplayWriter* ReplayWriterNew(
+	const char* path,
+	const u32 seed,
+	const u8 flags,
+	const u8 totalBindings
+)
+{
+	assert((usize)totalBindings * VARINT_MAX_SIZE <= CHUNK_CAPACITY);
+
+	// The file is read back by ReplayWriterSave.
+	FILE* file = path != NULL ? fopen(path, "w+b") : tmpfile();
+
+	if (file == NULL)
+	{
+		return NULL;
+	}
+
+	{
+		u8 header[REPLAY_HEADER_SIZE];
+		ReplayHeaderWrite(header, seed, flags, totalBindings, 0, REPLAY_ENCODING_TOGGLES);
+
+		fwrite(header, sizeof(u8), REPLAY_HEADER_SIZE, file);
+		fflush(file);
+	}
+
+	ReplayWriter* self = malloc(sizeof(ReplayWriter));
+
+	self->m_file = file;
+	self->m_encoder = ReplayToggleEncoderCreate(totalBindings);
+	self->m_pending = &self->m_chunks[0];
+	self->m_pending->size = 0;
+	self->m_pendingFrames = 0;
+	self->m_flushing = &self->m_chunks[1];
+	self->m_flushing->size = 0;
+
+#if defined(REPLAY_WRITER_THREADED)
+	self->m_busy = false;
+	self->m_quit = false;
+
+	pthread_mutex_init(&self->m_mutex, NULL);
+	pthread_cond_init(&self->m_condition, NULL);
+	pthread_create(&self->m_thread, NULL, ReplayWriterWork, self);
+#endif
+
+	return self;
+}
+
+void ReplayWriterFlush(ReplayWriter* self)
+{
+	if (self->m_pendingFrames == 0)
+	{
+		return;
+	}
+
+	self->m_pending->length = self->m_encoder.length;
+
+#if defined(REPLAY_WRITER_THREADED)
+	pthread_mutex_lock(&self->m_mutex);
+	{
+		// Only wait if the previous chunk somehow has not finished writing yet.
+		while (self->m_busy)
+		{
+			pthread_cond_wait(&self->m_condition, &self->m_mutex);
+		}
+
+		ReplayWriterChunk* tmp = self->m_flushing;
+		self->m_flushing = self->m_pending;
+		self->m_pending = tmp;
+
+		self->m_busy = true;
+		pthread_cond_broadcast(&self->m_condition);
+	}
+	pthread_mutex_unlock(&self->m_mutex);
+#else
+	WriteChunk(self->m_file, self->m_pending);
+#endif
+
+	self->m_pending->size = 0;
+	self->m_pendingFrames = 0;
+}
+
+void ReplayWriterPush(ReplayWriter* self, const bool* payload)
+{
+	const usize worstCase = (usize)self->m_encoder.totalBindings * VARINT_MAX_SIZE;
+
+	if (CHUNK_CAPACITY - self->m_pending->size < worstCase)
+	{
+		ReplayWriterFlush(self);
+	}
+
+	ReplayWriterChunk* chunk = self->m_pending;
+
+	chunk->size += ReplayToggleEncoderPush(&self->m_encoder, payload, chunk->data + chunk->size);
+	self->m_pendingFrames += 1;
+
+	if (self->m_pendingFrames >= CHUNK_MAX_FRAMES)
+	{
+		ReplayWriterFlush(self);
+	}
+}
+
+u32 ReplayWriterGetLength(const ReplayWriter* self)
+{
+	return self->m_encoder.length;
+}
+
+// Copies the whole file, then leaves it positioned at its end again (see WriteChunk).
+static bool CopyContents(FILE* source, FILE* destination)
+{
+	u8 buffer[CHUNK_CAPACITY];
+	bool success = fseek(source, 0, SEEK_SET) == 0;
+
+	while (success)
+	{
+		const usize size = fread(buffer, sizeof(u8), CHUNK_CAPACITY, source);
+
+		if (size == 0)
+		{
+			break;
+		}
+
+		success = fwrite(buffer, sizeof(u8), size, destination) == size;
+	}
+
+	success &= ferror(source) == 0;
+	fseek(source, 0, SEEK_END);
+
+	return success;
+}
+
+bool ReplayWriterSave(ReplayWriter* self, const char* path)
+{
+	FILE* destination = fopen(path, "wb");
+
+	if (destination == NULL)
+	{
+		return false;
+	}
+
+	ReplayWriterFlush(self);
+
+#if defined(REPLAY_WRITER_THREADED)
+	pthread_mutex_lock(&self->m_mutex);
+
+	// The background thread leaves the file alone for as long as the mutex is held.
+	while (self->m_busy)
+	{
+		pthread_cond_wait(&self->m_condition, &self->m_mutex);
+	}
+#endif
+
+	bool success = CopyContents(self->m_file, destination);
+
+#if defined(REPLAY_WRITER_THREADED)
+	pthread_mutex_unlock(&self->m_mutex);
+#endif
+
+	success &= fclose(destination) == 0;
+
+	return success;
+}
+
+void ReplayWriterDestroy(ReplayWriter* self)
+{
+	ReplayWriterFlush(self);
+
+#if defined(REPLAY_WRITER_THREADED)
+	pthread_mutex_lock(&self->m_mutex);
+	{
+		self->m_quit = true;
+		pthread_cond_broadcast(&self->m_condition);
+	}
+	pthread_mutex_unlock(&self->m_mutex);
+
+	pthread_join(self->m_thread, NULL);
+
+	pthread_cond_destroy(&self->m_condition);
+	pthread_mutex_destroy(&self->m_mutex);
+#endif
+
+	fclose(self->m_file);
+
+	free(self);
+}
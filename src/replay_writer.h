@@ -0,0 +1,24 @@
+#pragma once
+
+#include "common.h"
+
+#include <stdbool.h>
+
+// An append-only Replay file that is written to disk incrementally (in the background when
+// possible). Input is encoded with REPLAY_ENCODING_TOGGLES, and the file's header is kept up to
+// date after every flush, so the file is always a valid Replay of everything flushed so far.
+typedef struct ReplayWriter ReplayWriter;
+
+// Returns NULL if the file at the given path could not be created. If `path` is NULL, the Replay is
+// written to a temporary file instead, which is deleted once the writer is destroyed (see
+// ReplayWriterSave). See ReplayFlag for `flags`.
+ReplayWriter* ReplayWriterNew(const char* path, u32 seed, u8 flags, u8 totalBindings);
+void ReplayWriterPush(ReplayWriter* self, const bool* payload);
+// Hands off every frame pushed so far to be written to disk.
+void ReplayWriterFlush(ReplayWriter* self);
+u32 ReplayWriterGetLength(const ReplayWriter* self);
+// Waits for every frame pushed so far to be written, then copies the file to the given path;
+// returns false if that fails.
+bool ReplayWriterSave(ReplayWriter* self, const char* path);
+// Flushes any remaining input, waits for it to be written, and closes the file.
+void ReplayWriterDestroy(ReplayWriter* self);
@@ -5,13 +5,48 @@
 Rng RngCreate(const u64 seed)
 {
 	return (Rng) {
-		.seed = seed,
+		.key = wyhash64(seed, 0),
+		.counter = 0,
+		.sequential = false,
 	};
 }
 
+Rng RngCreateSequential(const u64 seed)
+{
+	return (Rng) {
+		.key = seed,
+		.counter = 0,
+		.sequential = true,
+	};
+}
+
+Rng RngSplit(const Rng* self, const u64 stream)
+{
+	// A sequential generator's key is its state, which is not a great source of entropy; it will do
+	// for deriving a counter-based generator though.
+	return (Rng) {
+		.key = wyhash64(self->key, stream + 1),
+		.counter = 0,
+		.sequential = false,
+	};
+}
+
+static u64 CounterNext(Rng* self)
+{
+	const u64 value = wyhash64(self->key, self->counter);
+	self->counter += 1;
+
+	return value;
+}
+
 u64 RngNextU64(Rng* self)
 {
-	return wyrand(&self->seed);
+	if (self->sequential)
+	{
+		return wyrand(&self->key);
+	}
+
+	return CounterNext(self);
 }
 
 f64 RngNextF64(Rng* self)
@@ -21,11 +56,63 @@ f64 RngNextF64(Rng* self)
 	return wy2u01(value);
 }
 
+// Returns an unbiased u32 within the range [0, range) using Lemire's multiply-and-reject method.
+static uint32_t CounterNextBounded(Rng* self, const uint32_t range)
+{
+	u64 product = (u64)(uint32_t)CounterNext(self) * range;
+	uint32_t low = (uint32_t)product;
+
+	// Rejection only happens for a handful of values out of 2^32.
+	if (low < range)
+	{
+		const uint32_t threshold = -range % range;
+
+		while (low < threshold)
+		{
+			product = (u64)(uint32_t)CounterNext(self) * range;
+			low = (uint32_t)product;
+		}
+	}
+
+	return product >> 32;
+}
+
 i32 RngNextRange(Rng* self, const i32 minimum, const i32 maximum)
 {
-	// TODO(thismarvin): This can definitely be better...
+	if (self->sequential)
+	{
+		// This is slightly biased, but it is how older Replays were generated.
+		const f64 step = RngNextF64(self);
+
+		return minimum + ((maximum - minimum) * step);
+	}
+
+	if (maximum <= minimum)
+	{
+		return minimum;
+	}
+
+	const uint32_t range = (uint32_t)((int64_t)maximum - minimum);
+
+	return (i32)((int64_t)minimum + CounterNextBounded(self, range));
+}
+
+void RngFillRange(Rng* self, i32* out, const usize length, const i32 minimum, const i32 maximum)
+{
+	if (self->sequential || maximum <= minimum)
+	{
+		for (usize i = 0; i < length; ++i)
+		{
+			out[i] = RngNextRange(self, minimum, maximum);
+		}
+
+		return;
+	}
 
-	const f64 step = RngNextF64(self);
+	const uint32_t range = (uint32_t)((int64_t)maximum - minimum);
 
-	return minimum + ((maximum - minimum) * step);
+	for (usize i = 0; i < length; ++i)
+	{
+		out[i] = (i32)((int64_t)minimum + CounterNextBounded(self, range));
+	}
 }
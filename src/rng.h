@@ -1,19 +1,34 @@
 #pragma once
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 typedef uint64_t u64;
 typedef double f64;
 typedef int32_t i32;
+typedef size_t usize;
 
 typedef struct
 {
-	u64 seed;
+	u64 key;
+	u64 counter;
+	// Whether this is a sequential generator (see RngCreateSequential).
+	bool sequential;
 } Rng;
 
-// Creates a simple wrapper around wyhash's API.
+// Creates a counter-based generator: the nth value is a hash of the seed and n, so values do not
+// depend on each other and independent generators can be split off of it (see RngSplit).
 Rng RngCreate(u64 seed);
 
+// Creates the generator that was used before RngCreate existed (wyrand); every value depends on
+// the previous one. This only exists so that older Replays play back exactly like they used to.
+Rng RngCreateSequential(u64 seed);
+
+// Derives a generator for the given stream that is independent of the original one (and of any
+// other stream), e.g. one per system or per entity.
+Rng RngSplit(const Rng* self, u64 stream);
+
 // Returns a pseudo-random u64.
 u64 RngNextU64(Rng* self);
 
@@ -22,3 +37,7 @@ f64 RngNextF64(Rng* self);
 
 // Returns a pseudo-random i32 within the range [minimum, maximum).
 i32 RngNextRange(Rng* self, i32 minimum, i32 maximum);
+
+// Fills the given array with pseudo-random i32s within the range [minimum, maximum); this is
+// equivalent to (but faster than) calling RngNextRange for every element.
+void RngFillRange(Rng* self, i32* out, usize length, i32 minimum, i32 maximum);
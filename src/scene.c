@@ -16,16 +16,21 @@
 #include "bit_mask.h"
 #include "common.h"
 #include "context.h"
+#include "counters.h"
 #include "easing.h"
 #include "fader.h"
 #include "game.h"
 #include "input.h"
 #include "level.h"
+#include "profiler.h"
 #include "replay.h"
+#include "replay_writer.h"
 #include "rng.h"
 #include "scene_generated.h"
 #include "shaders.h"
 #include "sprites_generated.h"
+#include "startup.h"
+#include "stress.h"
 
 #include <assert.h>
 #include <math.h>
@@ -46,13 +51,29 @@
 // Record the last 30 minutes of input!
 #define RECORDING_SIZE ((usize)1 * 60 * 60 * 30)
 
+#if defined(NDEBUG)
+	#define RECORDING_PATH "recording.ltlrr"
+#else
+	#define RECORDING_PATH "debug_recording.ltlrr"
+#endif
+
 #define RUN_SYSTEM(mSystemFn, mScene, mEntities) \
 	do \
 	{ \
+		PROFILE_BEGIN(#mSystemFn); \
 		for (usize i = 0; i < (mEntities); ++i) \
 		{ \
 			mSystemFn(mScene, i); \
 		} \
+		PROFILE_END(); \
+	} while (false)
+
+#define RENDER_LAYER(mRenderTexture, mRenderFn, mParams) \
+	do \
+	{ \
+		PROFILE_BEGIN(#mRenderFn); \
+		RenderLayer(mRenderTexture, mRenderFn, mParams); \
+		PROFILE_END(); \
 	} while (false)
 
 typedef struct
@@ -199,6 +220,11 @@ void SceneDeferSetTag(Scene* self, const usize entity, const u64 tag)
 
 static void SceneFlush(Scene* self)
 {
+	PROFILE_BEGIN("SceneFlush");
+
+	// Every entity is built by a deferred command, so bursts of spawns show up here.
+	CounterAdd(COUNTER_DEFERRED_COMMANDS, DequeGetSize(&self->deferred));
+
 	for (usize i = 0; i < DequeGetSize(&self->deferred); ++i)
 	{
 		SceneDeferParams* params = &DEQUE_GET_UNCHECKED(&self->deferred, SceneDeferParams, i);
@@ -208,8 +234,13 @@ static void SceneFlush(Scene* self)
 
 	ArenaAllocatorFlush(&self->arenaAllocator);
 	DequeClear(&self->deferred);
+
+	PROFILE_END();
 }
 
+// Headless builds have no window, so there is no content or render layers to set up.
+#if !defined(PLATFORM_HEADLESS)
+
 static void SceneSetupDropShadow(Scene* self)
 {
 	self->dropShadow = LoadShaderFromMemory(0, shaderDropShadowSource);
@@ -243,12 +274,7 @@ static void SceneSetupDropShadow(Scene* self)
 	SetShaderValue(self->dropShadow, colorLocation, &colorValue, SHADER_UNIFORM_VEC4);
 }
 
-static void SceneSetupContent(Scene* self)
-{
-	self->atlas = AtlasCreate(DATADIR "content/atlas.png");
-
-	SceneSetupDropShadow(self);
-}
+#endif
 
 // clang-format off
 
@@ -256,6 +282,23 @@ static InputProfile CreateDefaultInputProfile(void)
 {
 	InputProfile profile = InputProfileCreate(4);
 
+	// Add every action up front so that each InputAction matches its respective InputBinding.
+	{
+		static const char* const actions[TOTAL_INPUT_BINDINGS] = {
+			[INPUT_BINDING_LEFT] = "left",
+			[INPUT_BINDING_RIGHT] = "right",
+			[INPUT_BINDING_JUMP] = "jump",
+			[INPUT_BINDING_STOMP] = "stomp",
+		};
+
+		for (usize i = 0; i < TOTAL_INPUT_BINDINGS; ++i)
+		{
+			UNUSED const InputAction action = InputProfileAddAction(&profile, actions[i]);
+
+			assert(action == i);
+		}
+	}
+
 	// Keyboard.
 	{
 		{
@@ -368,12 +411,91 @@ static void SceneSetupInput(Scene* self)
 		self->inputProfiles[i] = CreateDefaultInputProfile();
 
 		InputHandlerSetProfile(&self->inputs[i], &self->inputProfiles[i]);
+
+		atomic_init(&self->sampledInput[i], 0);
+		self->liveInput[i] = 0;
 	}
+
+	InputQueueInit(&self->inputQueue);
+
+	self->inputDeadline = INFINITY;
+}
+
+Rectangle SceneGetLayerRegion(const SceneLayer layer, const Rectangle monitor)
+{
+	switch (layer)
+	{
+		case SCENE_LAYER_ROOT: {
+			return (Rectangle) {
+				.width = 1,
+				.height = 1,
+			};
+		}
+		case SCENE_LAYER_FOREGROUND:
+		case SCENE_LAYER_TREE: {
+			return CTX_VIEWPORT;
+		}
+		default: {
+			break;
+		}
+	}
+
+	// Every other layer uses the monitor's resolution as its render resolution. Ensure that the
+	// render resolution uses integer scaling.
+	const usize zoom = floor(CalculateZoom(CTX_VIEWPORT, monitor));
+
+	return (Rectangle) {
+		.width = CTX_VIEWPORT_WIDTH * zoom,
+		.height = CTX_VIEWPORT_HEIGHT * zoom,
+	};
+}
+
+RenderTexture2D SceneGetLayer(const Scene* self, const SceneLayer layer)
+{
+	switch (layer)
+	{
+		case SCENE_LAYER_BACKGROUND: {
+			return self->backgroundLayer;
+		}
+		case SCENE_LAYER_TARGET: {
+			return self->targetLayer;
+		}
+		case SCENE_LAYER_TARGET_BUFFER: {
+			return self->targetLayerBuffer;
+		}
+		case SCENE_LAYER_FOREGROUND: {
+			return self->foregroundLayer;
+		}
+		case SCENE_LAYER_INTERFACE: {
+			return self->interfaceLayer;
+		}
+		case SCENE_LAYER_TRANSITION: {
+			return self->transitionLayer;
+		}
+		case SCENE_LAYER_DEBUG: {
+			return self->debugLayer;
+		}
+		case SCENE_LAYER_TREE: {
+			return self->treeTexture;
+		}
+		default: {
+			return self->rootLayer;
+		}
+	}
+}
+
+#if !defined(PLATFORM_HEADLESS)
+
+static RenderTexture2D LoadLayer(const SceneLayer layer, const Rectangle monitor)
+{
+	const Rectangle region = SceneGetLayerRegion(layer, monitor);
+
+	return LoadRenderTexture(region.width, region.height);
 }
 
 static RenderTexture GenerateTreeTexture(void)
 {
-	const RenderTexture renderTexture = LoadRenderTexture(CTX_VIEWPORT_WIDTH, CTX_VIEWPORT_HEIGHT);
+	const RenderTexture renderTexture = LoadLayer(SCENE_LAYER_TREE, GetMonitorRectangle());
 
 	const Camera2D camera = (Camera2D) {
 		.zoom = 1,
@@ -439,33 +561,44 @@ static void SceneSetupLayers(Scene* self)
 {
 	// TODO(thismarvin): Expose a "Render Resolution" option?
 
-	// Use the monitor's resolution as the default render resolution.
-	Rectangle renderResolution = GetMonitorRectangle();
+	// Use the monitor's resolution as the default render resolution (see SceneGetLayerRegion).
+	const Rectangle monitor = GetMonitorRectangle();
 
-	f32 zoom = CalculateZoom(CTX_VIEWPORT, renderResolution);
+	self->rootLayer = LoadLayer(SCENE_LAYER_ROOT, monitor);
+	self->backgroundLayer = LoadLayer(SCENE_LAYER_BACKGROUND, monitor);
+	self->foregroundLayer = LoadLayer(SCENE_LAYER_FOREGROUND, monitor);
+	self->interfaceLayer = LoadLayer(SCENE_LAYER_INTERFACE, monitor);
+	self->debugLayer = LoadLayer(SCENE_LAYER_DEBUG, monitor);
 
-	// Ensure that the render resolution uses integer scaling.
-	zoom = floor(zoom);
+	// TODO(thismarvin): If this is just for fades thrn this resolution is overkill!
+	self->transitionLayer = LoadLayer(SCENE_LAYER_TRANSITION, monitor);
 
-	const usize scaledWidth = CTX_VIEWPORT_WIDTH * zoom;
-	const usize scaledHeight = CTX_VIEWPORT_HEIGHT * zoom;
+	// It's very important that these two render textures have the same dimensions!
+	self->targetLayer = LoadLayer(SCENE_LAYER_TARGET, monitor);
+	self->targetLayerBuffer = LoadLayer(SCENE_LAYER_TARGET_BUFFER, monitor);
+}
 
-	self->rootLayer = LoadRenderTexture(1, 1);
-	self->backgroundLayer = LoadRenderTexture(scaledWidth, scaledHeight);
-	self->foregroundLayer = LoadRenderTexture(CTX_VIEWPORT_WIDTH, CTX_VIEWPORT_HEIGHT);
-	self->interfaceLayer = LoadRenderTexture(scaledWidth, scaledHeight);
-	self->debugLayer = LoadRenderTexture(scaledWidth, scaledHeight);
+void SceneSetupGraphics(Scene* self, const Image* atlas)
+{
+	usize phase = StartupBegin("AtlasCreate");
+	self->atlas = AtlasCreate(atlas);
+	StartupEnd(phase);
 
-	// TODO(thismarvin): If this is just for fades thrn this resolution is overkill!
-	self->transitionLayer = LoadRenderTexture(scaledWidth, scaledHeight);
+	phase = StartupBegin("SceneSetupDropShadow");
+	SceneSetupDropShadow(self);
+	StartupEnd(phase);
 
-	// It's very important that these two render textures have the same dimensions!
-	self->targetLayer = LoadRenderTexture(scaledWidth, scaledHeight);
-	self->targetLayerBuffer = LoadRenderTexture(scaledWidth, scaledHeight);
+	phase = StartupBegin("SceneSetupLayers");
+	SceneSetupLayers(self);
+	StartupEnd(phase);
 
+	phase = StartupBegin("GenerateTreeTexture");
 	self->treeTexture = GenerateTreeTexture();
+	StartupEnd(phase);
 }
 
+#endif
+
 static void ArrayFillWithRange(i32* array, const i32 start, const i32 end)
 {
 	const usize domain = end - start;
@@ -568,7 +701,11 @@ static void ScenePopulateLevel(Scene* self)
 		builder->layer = LAYER_TERRAIN;
 		SceneDefer(self, BlockBuild, builder);
 	}
+}
 
+// Builds the entities that every stage has (no matter how the rest of it was built).
+static void ScenePopulateCast(Scene* self)
+{
 	{
 		self->player = SceneAllocateEntity(self);
 		PlayerBuilder* builder = ArenaAllocatorTake(&self->arenaAllocator, sizeof(PlayerBuilder));
@@ -621,6 +758,8 @@ static void ScenePlantTrees(Scene* self)
 		const Vector2 position = Vector2Create(x, y);
 		DEQUE_PUSH_BACK(&self->treePositionsFront, Vector2, position);
 	}
+
+	self->treePlantings += 1;
 }
 
 static void SceneBeginFadeIn(Scene* self)
@@ -658,17 +797,32 @@ static void SceneResetEcs(Scene* self)
 
 static void SceneBuildStage(Scene* self)
 {
+	PROFILE_BEGIN("SceneBuildStage");
+
+	CounterAdd(COUNTER_STAGE_BUILDS, 1);
+
 	SceneBeginFadeIn(self);
 
 	SceneResetEcs(self);
 
-	ScenePopulateLevel(self);
+	if (self->stress != NULL)
+	{
+		StressPopulate(self, self->stress);
+	}
+	else
+	{
+		ScenePopulateLevel(self);
+	}
+
+	ScenePopulateCast(self);
 	ScenePlantTrees(self);
 
 	self->resetRequested = false;
 	self->advanceStageRequested = false;
 
 	SceneFlush(self);
+
+	PROFILE_END();
 }
 
 static void SceneReset(Scene* self)
@@ -702,29 +856,118 @@ static void SceneAdvanceStage(Scene* self)
 	self->components.mortals[self->player] = playersMortal;
 }
 
-void SceneInit(Scene* self)
+// Input recorded under the previous seed would not play back under the new one, so every reseed
+// starts a recording of its own. Recordings stream into a temporary file, and only replace the last
+// saved one in SceneSaveRecording.
+#if !defined(PLATFORM_HEADLESS)
+static void SceneRestartRecording(Scene* self)
 {
-#if !defined(BENCHMARKING)
-	SceneSetupContent(self);
-	SceneSetupLayers(self);
+	if (self->recorder != NULL)
+	{
+		ReplayWriterDestroy(self->recorder);
+	}
+
+	self->recorder =
+		ReplayWriterNew(NULL, self->seed, self->replayFlags, TOTAL_INPUT_BINDINGS);
+
+	if (self->recorder == NULL)
+	{
+		TraceLog(LOG_WARNING, "Could not create a temporary file; input is not recorded.");
+	}
+}
 #endif
 
-	SceneSetupInput(self);
+void SceneStartPlayback(Scene* self, const Replay* replay)
+{
+	if (!self->inputStreams[0].readOnly)
+	{
+		self->m_ownInputStream = self->inputStreams[0];
+	}
+
+	self->inputStreams[0] = InputStreamCreateView(replay);
+}
+
+void SceneStopPlayback(Scene* self)
+{
+	if (!self->inputStreams[0].readOnly)
+	{
+		return;
+	}
+
+	const InputStream view = self->inputStreams[0];
 
+	// Player one takes over from the Replay at the current frame.
+	self->inputStreams[0] = self->m_ownInputStream;
+	InputStreamContinue(&self->inputStreams[0], &view, self->frame);
+}
+
+void SceneReseed(Scene* self, const u32 seed, const u8 replayFlags)
+{
 	self->frame = 0;
 	self->elapsedTime = 0;
 
+	self->seed = seed;
+	self->replayFlags = replayFlags;
+
+	if ((self->replayFlags & REPLAY_FLAG_COUNTER_RNG) != 0)
+	{
+		self->rng = RngCreate(self->seed);
+		self->m_cosmeticRng = RngSplit(&self->rng, 0);
+	}
+	else
+	{
+		self->rng = RngCreateSequential(self->seed);
+	}
+
+	for (usize i = 0; i < MAX_PLAYERS; ++i)
+	{
+		InputStreamClear(&self->inputStreams[i]);
+	}
+
+	// Forget any live input from before; whoever samples input (possibly on another thread) pushes
+	// whatever is still held down again, since it no longer matches what was sampled last.
+	{
+		InputEvent event;
+
+		while (InputQueueTryPopUntil(&self->inputQueue, INFINITY, &event))
+		{
+		}
+
+		for (usize i = 0; i < MAX_PLAYERS; ++i)
+		{
+			self->liveInput[i] = 0;
+			atomic_store(&self->sampledInput[i], 0);
+		}
+	}
+
+#if !defined(PLATFORM_HEADLESS)
+	SceneRestartRecording(self);
+#endif
+
+	self->state = SCENE_STATE_MENU;
+
+	self->director = DIRECTOR_STATE_ENTRANCE;
+	self->fader = FaderDefault();
+	self->fader.easer.ease = EaseInOutQuad;
+
+	SceneReset(self);
+}
+
+void SceneInit(Scene* self)
+{
+	SceneSetupInput(self);
+
 #if defined(NDEBUG)
-	self->seed = time(NULL);
+	const u32 seed = time(NULL);
 #else
-	self->seed = MAGIC_NUMBER;
+	const u32 seed = MAGIC_NUMBER;
 #endif
 
-	TraceLog(LOG_INFO, "SEED: %lu", self->seed);
-
-	self->rng = RngCreate(self->seed);
+	TraceLog(LOG_INFO, "SEED: %lu", seed);
 
-	self->deferred = DEQUE_OF(SceneDeferParams);
+	// Building a stage defers about one command per entity; sizing the Deque for that up front
+	// means that it never has to grow mid-game.
+	self->deferred = DEQUE_WITH_CAPACITY(SceneDeferParams, MAX_ENTITIES);
 
 	// Setup input recording.
 	{
@@ -732,11 +975,10 @@ void SceneInit(Scene* self)
 		{
 			self->inputStreams[i] = InputStreamCreate(TOTAL_INPUT_BINDINGS, RECORDING_SIZE);
 		}
-	}
 
-	self->state = SCENE_STATE_MENU;
-
-	self->debugging = false;
+		// See SceneRestartRecording.
+		self->recorder = NULL;
+	}
 
 	self->m_entityManager = (EntityManager) {
 		.m_nextFreshEntityIndex = 0,
@@ -745,14 +987,22 @@ void SceneInit(Scene* self)
 
 	self->treePositionsBack = DEQUE_OF(Vector2);
 	self->treePositionsFront = DEQUE_OF(Vector2);
+	self->treePlantings = 0;
 
-	self->director = DIRECTOR_STATE_ENTRANCE;
-	self->fader = FaderDefault();
-	self->fader.easer.ease = EaseInOutQuad;
+	self->debugging = false;
 
 	self->arenaAllocator = ArenaAllocatorCreate((usize)(1024 * 8));
 
-	SceneReset(self);
+	self->stress = NULL;
+
+	// Nobody is around to look at a headless simulation.
+#if defined(PLATFORM_HEADLESS)
+	self->cosmeticsEnabled = false;
+#else
+	self->cosmeticsEnabled = true;
+#endif
+
+	SceneReseed(self, seed, REPLAY_FLAGS_CURRENT);
 }
 
 f64 SceneGetElapsedTime(const Scene* self)
@@ -760,6 +1010,26 @@ f64 SceneGetElapsedTime(const Scene* self)
 	return self->elapsedTime;
 }
 
+Rng* SceneGetCosmeticRng(Scene* self)
+{
+	if ((self->replayFlags & REPLAY_FLAG_COUNTER_RNG) == 0)
+	{
+		return &self->rng;
+	}
+
+	return &self->m_cosmeticRng;
+}
+
+bool SceneSimulatesCosmetics(const Scene* self)
+{
+	return self->cosmeticsEnabled || (self->replayFlags & REPLAY_FLAG_COUNTER_RNG) == 0;
+}
+
+bool SceneUsesFixedPoint(const Scene* self)
+{
+	return (self->replayFlags & REPLAY_FLAG_FIXED_POINT) != 0;
+}
+
 static usize BufferFromInputBinding(const InputBinding binding)
 {
 	switch (binding)
@@ -1012,29 +1282,65 @@ static void SceneActionUpdate(Scene* self)
 
 	RUN_SYSTEM(SFleetingUpdate, self, entities);
 	RUN_SYSTEM(SSmoothUpdate, self, entities);
-	RUN_SYSTEM(SAnimationUpdate, self, entities);
 	RUN_SYSTEM(BatteryUpdate, self, entities);
 	RUN_SYSTEM(PlayerInputUpdate, self, entities);
-	/**/ RUN_SYSTEM(PlayerShadowUpdate, self, entities);
 	/**/ RUN_SYSTEM(SKineticUpdate, self, entities);
 	/****/ RUN_SYSTEM(SCollisionUpdate, self, entities);
 	/******/ RUN_SYSTEM(SPostCollisionUpdate, self, entities);
 	/********/ RUN_SYSTEM(PlayerPostCollisionUpdate, self, entities);
 	/**********/ RUN_SYSTEM(PlayerMortalUpdate, self, entities);
-	/**********/ RUN_SYSTEM(PlayerTrailUpdate, self, entities);
-	/**********/ RUN_SYSTEM(PlayerAnimationUpdate, self, entities);
 	/************/ RUN_SYSTEM(FogUpdate, self, entities);
 
+	// None of the following affect gameplay; they only exist to be looked at.
+	if (SceneSimulatesCosmetics(self))
+	{
+		RUN_SYSTEM(SAnimationUpdate, self, entities);
+		RUN_SYSTEM(PlayerShadowUpdate, self, entities);
+		RUN_SYSTEM(PlayerTrailUpdate, self, entities);
+		RUN_SYSTEM(PlayerAnimationUpdate, self, entities);
+	}
+
 	SceneUpdateScore(self);
 	SceneCheckEndCondition(self);
 }
 
-static void SceneUpdateInput(Scene* self)
+void SceneSampleInput(Scene* self, const f64 timestamp)
 {
-	// Update input handlers.
-	for (usize i = 0; i < MAX_PLAYERS; ++i)
+	for (u8 i = 0; i < MAX_PLAYERS; ++i)
 	{
 		InputHandlerUpdate(&self->inputs[i]);
+
+		const InputActions pressing = self->inputs[i].m_pressing;
+
+		if (pressing == atomic_load_explicit(&self->sampledInput[i], memory_order_relaxed))
+		{
+			continue;
+		}
+
+		const InputEvent event = {
+			.timestamp = timestamp,
+			.pressing = pressing,
+			.player = i,
+		};
+
+		// If the simulation has fallen this far behind, try again on the next sample.
+		if (InputQueuePush(&self->inputQueue, event))
+		{
+			atomic_store_explicit(&self->sampledInput[i], pressing, memory_order_relaxed);
+		}
+	}
+}
+
+static void SceneUpdateInput(Scene* self)
+{
+	// Apply every change in live input that happened before this frame.
+	{
+		InputEvent event;
+
+		while (InputQueueTryPopUntil(&self->inputQueue, self->inputDeadline, &event))
+		{
+			self->liveInput[event.player] = event.pressing;
+		}
 	}
 
 	// Update input streams.
@@ -1049,71 +1355,61 @@ static void SceneUpdateInput(Scene* self)
 
 		bool payload[TOTAL_INPUT_BINDINGS] = { false };
 
-		if (InputHandlerPressing(&self->inputs[i], "left"))
+		// Note that every InputAction matches its respective InputBinding.
+		for (usize j = 0; j < TOTAL_INPUT_BINDINGS; ++j)
 		{
-			payload[0] = true;
+			payload[j] = (self->liveInput[i] & ((InputActions)1 << j)) != 0;
 		}
-		if (InputHandlerPressing(&self->inputs[i], "right"))
-		{
-			payload[1] = true;
-		}
-		if (InputHandlerPressing(&self->inputs[i], "jump"))
-		{
-			payload[2] = true;
-		}
-		if (InputHandlerPressing(&self->inputs[i], "stomp"))
+
+		InputStreamPush(&self->inputStreams[i], payload);
+	}
+
+	// Record player-one's input (regardless of whether it is live or from a replay).
+	if (self->recorder != NULL)
+	{
+		bool payload[TOTAL_INPUT_BINDINGS];
+
+		for (usize i = 0; i < TOTAL_INPUT_BINDINGS; ++i)
 		{
-			payload[3] = true;
+			payload[i] = InputStreamPressing(&self->inputStreams[0], i, self->frame);
 		}
 
-		InputStreamPush(&self->inputStreams[i], payload);
+		ReplayWriterPush(self->recorder, payload);
 	}
 }
 
-void SceneUpdate(Scene* self)
+void SceneSaveRecording(Scene* self)
 {
-	SceneUpdateInput(self);
-
-#if defined(PLATFORM_DESKTOP)
-	if (IsKeyPressed(KEY_F11))
+	if (self->recorder == NULL)
 	{
-		ToggleFullscreenShim();
+		return;
 	}
-#endif
 
-	if (IsKeyPressed(KEY_EQUAL))
+	if (!ReplayWriterSave(self->recorder, RECORDING_PATH))
 	{
-		self->debugging = !self->debugging;
+		TraceLog(LOG_WARNING, "Could not save %s.", RECORDING_PATH);
+		return;
 	}
 
-	if (IsKeyPressed(KEY_MINUS))
-	{
-		ReplayResult result = ReplayTryFromInputStream(self->seed, &self->inputStreams[0]);
-
-		if (result.type == REPLAY_RESULT_TYPE_OK)
-		{
-			Replay* replay = &result.contents.ok;
-			ReplayBytes bytes = ReplayBytesFromReplay(replay);
-
-			SaveFileData("recording.ltlrr", bytes.data, bytes.size);
-
-			ReplayBytesDestroy(&bytes);
-			ReplayDestroy(replay);
+	TraceLog(LOG_INFO, "Saved %s.", RECORDING_PATH);
 
 #if defined(PLATFORM_WEB)
-			EM_ASM((saveFileFromMEMFSToDisk("recording.ltlrr", "recording.ltlrr");));
+	EM_ASM({ saveFileFromMEMFSToDisk(UTF8ToString($0), "recording.ltlrr"); }, RECORDING_PATH);
 #endif
-		}
-		else
-		{
-			TraceLog(LOG_ERROR, StringFromReplayError(result.contents.err));
-		}
-	}
+}
+
+void SceneUpdate(Scene* self)
+{
+	PROFILE_BEGIN("SceneUpdateInput");
+	SceneUpdateInput(self);
+	PROFILE_END();
 
 	switch (self->state)
 	{
 		case SCENE_STATE_MENU: {
+			PROFILE_BEGIN("SceneMenuUpdate");
 			SceneMenuUpdate(self);
+			PROFILE_END();
 			break;
 		}
 		case SCENE_STATE_ACTION: {
@@ -1122,48 +1418,42 @@ void SceneUpdate(Scene* self)
 		}
 	}
 
+	PROFILE_BEGIN("SceneUpdateDirector");
 	SceneUpdateDirector(self);
+	PROFILE_END();
 
 	SceneFlush(self);
 
+	{
+		const EntityManager* entityManager = &self->m_entityManager;
+		const usize total = entityManager->m_nextFreshEntityIndex;
+		const usize recycled = DequeGetSize(&entityManager->m_recycledEntityIndices);
+
+		CounterSet(COUNTER_LIVE_ENTITIES, total - recycled);
+		CounterSet(COUNTER_ENTITY_HIGH_WATER_MARK, total);
+	}
+
 	// TODO(thismarvin): Should this be at the end? Don't we usually have it first?!
 	self->frame += 1;
 	self->elapsedTime += CTX_DT;
 }
 
-// Return a Rectangle that is within the scene's bounds and centered on a given entity.
-static Rectangle SceneCalculateActionCameraBounds(const Scene* self, const usize targetEntity)
+// Return a Rectangle that is within the scene's bounds and centered on whichever entity the camera
+// follows.
+static Rectangle CalculateActionCameraBounds(const RenderSnapshot* snapshot)
 {
-	if ((self->components.tags[targetEntity] & (TAG_POSITION)) != (TAG_POSITION))
+	if (!snapshot->cameraFollows)
 	{
 		return CTX_VIEWPORT;
 	}
 
-	Vector2 cameraPosition = self->components.positions[targetEntity].value;
-
-	if ((self->components.tags[targetEntity] & (TAG_SMOOTH)) == (TAG_SMOOTH))
-	{
-		const CSmooth* smooth = &self->components.smooths[targetEntity];
-
-		cameraPosition = Vector2Lerp(smooth->previous, cameraPosition, ContextGetAlpha());
-	}
-
-	if ((self->components.tags[targetEntity] & (TAG_DIMENSION)) == (TAG_DIMENSION))
-	{
-		const CDimension* dimension = &self->components.dimensions[targetEntity];
-
-		const Vector2 offset = (Vector2) {
-			.x = dimension->width * 0.5,
-			.y = dimension->height * 0.5,
-		};
-
-		cameraPosition = Vector2Add(cameraPosition, offset);
-	}
+	Vector2 cameraPosition =
+		Vector2Lerp(snapshot->cameraPrevious, snapshot->cameraTarget, ContextGetAlpha());
 
 	// Camera x-axis collision.
 	{
-		const f32 min = RectangleLeft(self->bounds) + (CTX_VIEWPORT_WIDTH * 0.5);
-		const f32 max = RectangleRight(self->bounds) - (CTX_VIEWPORT_WIDTH * 0.5);
+		const f32 min = RectangleLeft(snapshot->bounds) + (CTX_VIEWPORT_WIDTH * 0.5);
+		const f32 max = RectangleRight(snapshot->bounds) - (CTX_VIEWPORT_WIDTH * 0.5);
 
 		cameraPosition.x = MAX(min, cameraPosition.x);
 		cameraPosition.x = MIN(max, cameraPosition.x);
@@ -1171,8 +1461,8 @@ static Rectangle SceneCalculateActionCameraBounds(const Scene* self, const usize
 
 	// Camera y-axis collision.
 	{
-		const f32 min = RectangleTop(self->bounds) + (CTX_VIEWPORT_HEIGHT * 0.5);
-		const f32 max = RectangleBottom(self->bounds) - (CTX_VIEWPORT_HEIGHT * 0.5);
+		const f32 min = RectangleTop(snapshot->bounds) + (CTX_VIEWPORT_HEIGHT * 0.5);
+		const f32 max = RectangleBottom(snapshot->bounds) - (CTX_VIEWPORT_HEIGHT * 0.5);
 
 		cameraPosition.y = MAX(min, cameraPosition.y);
 		cameraPosition.y = MIN(max, cameraPosition.y);
@@ -1186,15 +1476,25 @@ static Rectangle SceneCalculateActionCameraBounds(const Scene* self, const usize
 	};
 }
 
-static void SceneDrawScore(const Scene* self, const Vector2 position)
+// What every render function is handed (as RenderFnParams' `scene`).
+typedef struct
+{
+	// The scene owns every layer and texture, while the snapshot says what to draw with them.
+	const Scene* scene;
+	const RenderSnapshot* snapshot;
+	// The top-left corner of the action camera, which trees scroll along with.
+	Vector2 actionCameraPosition;
+} SceneDrawParams;
+
+static void SceneDrawScore(const SceneDrawParams* params, const Vector2 position)
 {
 	for (usize i = 0; i < MAX_SCORE_DIGITS - 1; ++i)
 	{
 		const i32 index = (MAX_SCORE_DIGITS - 2) - i;
 
-		const Sprite digit = SPRITE_NUMBERS_0000 + (self->scoreString[index] - '0');
+		const Sprite digit = SPRITE_NUMBERS_0000 + (params->snapshot->scoreString[index] - '0');
 
-		const AtlasDrawParams params = (AtlasDrawParams) {
+		const AtlasDrawParams drawParams = (AtlasDrawParams) {
 			.sprite = digit,
 			.position = (Vector2) { position.x + (index * 14), position.y },
 			.scale = Vector2Create(1, 1),
@@ -1202,11 +1502,11 @@ static void SceneDrawScore(const Scene* self, const Vector2 position)
 			.reflection = REFLECTION_NONE,
 			.tint = COLOR_WHITE,
 		};
-		AtlasDraw(&self->atlas, &params);
+		AtlasDraw(&params->scene->atlas, &drawParams);
 	}
 }
 
-static void SceneDrawHealthBar(const Scene* self, const Vector2 position)
+static void SceneDrawHealthBar(const SceneDrawParams* params, const Vector2 position)
 {
 	static const usize totalHearts = PLAYER_MAX_HIT_POINTS;
 
@@ -1225,7 +1525,7 @@ static void SceneDrawHealthBar(const Scene* self, const Vector2 position)
 			.y = position.y,
 		};
 
-		const AtlasDrawParams params = (AtlasDrawParams) {
+		const AtlasDrawParams drawParams = (AtlasDrawParams) {
 			.sprite = SPRITE_HEART_0000,
 			.position = myPosition,
 			.scale = Vector2Create(1, 1),
@@ -1233,19 +1533,19 @@ static void SceneDrawHealthBar(const Scene* self, const Vector2 position)
 			.reflection = REFLECTION_NONE,
 			.tint = COLOR_WHITE,
 		};
-		AtlasDraw(&self->atlas, &params);
+		AtlasDraw(&params->scene->atlas, &drawParams);
 	}
 
 	// Draw heart containers.
 	{
-		const usize hp = self->components.mortals[self->player].hp;
+		const usize hp = params->snapshot->hp;
 		const usize hearts = totalHearts - hp;
 
 		for (usize i = hearts; i < totalHearts; ++i)
 		{
 			const Vector2 myPosition = (Vector2) { .x = position.x + (i * 15), .y = position.y };
 
-			const AtlasDrawParams params = (AtlasDrawParams) {
+			const AtlasDrawParams drawParams = (AtlasDrawParams) {
 				.sprite = SPRITE_HEART_0001,
 				.position = myPosition,
 				.scale = Vector2Create(1, 1),
@@ -1253,7 +1553,7 @@ static void SceneDrawHealthBar(const Scene* self, const Vector2 position)
 				.reflection = REFLECTION_NONE,
 				.tint = COLOR_WHITE,
 			};
-			AtlasDraw(&self->atlas, &params);
+			AtlasDraw(&params->scene->atlas, &drawParams);
 		}
 	}
 }
@@ -1265,12 +1565,12 @@ static void RenderRootLayer(UNUSED const RenderFnParams* params)
 
 static void DrawTree(const RenderFnParams* params, const Vector2 position, const f32 scrollFactor)
 {
-	const Scene* scene = (Scene*)params->scene;
+	const SceneDrawParams* drawParams = params->scene;
 
-	const RenderTexture* renderTexture = &scene->treeTexture;
+	const RenderTexture* renderTexture = &drawParams->scene->treeTexture;
 
-	const f32 domain = scene->bounds.width - CTX_VIEWPORT_WIDTH;
-	const f32 progress = scene->actionCameraPosition.x / domain;
+	const f32 domain = drawParams->snapshot->bounds.width - CTX_VIEWPORT_WIDTH;
+	const f32 progress = drawParams->actionCameraPosition.x / domain;
 	const f32 partialDomain = domain * scrollFactor;
 	const f32 offset = partialDomain * progress;
 
@@ -1315,17 +1615,66 @@ static void DrawTreeLayer(
 
 static void RenderBackgroundLayer(const RenderFnParams* params)
 {
-	const Scene* scene = (Scene*)params->scene;
+	const SceneDrawParams* drawParams = params->scene;
 
 	ClearBackground(COLOR_TRANSPARENT);
 
-	DrawTreeLayer(params, &scene->treePositionsBack, 0.15);
-	DrawTreeLayer(params, &scene->treePositionsFront, 0.2);
+	DrawTreeLayer(params, &drawParams->snapshot->treePositionsBack, 0.15);
+	DrawTreeLayer(params, &drawParams->snapshot->treePositionsFront, 0.2);
+}
+
+static void DrawSprite(const Atlas* atlas, const RenderSprite* sprite)
+{
+	const AtlasDrawParams params = (AtlasDrawParams) {
+		.sprite = sprite->sprite,
+		.position = Vector2Lerp(sprite->previous, sprite->position, ContextGetAlpha()),
+		.scale = Vector2Create(1, 1),
+		.intramural = sprite->intramural,
+		.reflection = sprite->reflection,
+		.tint = sprite->tint,
+	};
+	AtlasDraw(atlas, &params);
+}
+
+static void DrawPolygon(const RenderPolygon* polygon)
+{
+	const Vector2 center = Vector2Lerp(polygon->previous, polygon->center, ContextGetAlpha());
+
+	DrawPoly(center, polygon->sides, polygon->radius, polygon->rotation, polygon->color);
+}
+
+// Draws every sprite, followed by every animation (see RenderSnapshot).
+static void DrawSprites(const Atlas* atlas, const RenderSnapshot* snapshot)
+{
+	for (usize i = 0; i < snapshot->spritesLength; ++i)
+	{
+		DrawSprite(atlas, &snapshot->sprites[i]);
+	}
+
+	for (usize i = 0; i < snapshot->animationsLength; ++i)
+	{
+		DrawSprite(atlas, &snapshot->sprites[MAX_ENTITIES - 1 - i]);
+	}
+}
+
+// Draws every cloud particle, followed by every fog particle (see RenderSnapshot).
+static void DrawPolygons(const RenderSnapshot* snapshot)
+{
+	for (usize i = 0; i < snapshot->cloudParticlesLength; ++i)
+	{
+		DrawPolygon(&snapshot->polygons[i]);
+	}
+
+	for (usize i = 0; i < snapshot->fogParticlesLength; ++i)
+	{
+		DrawPolygon(&snapshot->polygons[MAX_ENTITIES - 1 - i]);
+	}
 }
 
 static void RenderTargetLayer(const RenderFnParams* params)
 {
-	const Scene* scene = (Scene*)params->scene;
+	const SceneDrawParams* drawParams = params->scene;
+	const RenderSnapshot* snapshot = drawParams->snapshot;
 
 	ClearBackground(COLOR_TRANSPARENT);
 
@@ -1333,9 +1682,9 @@ static void RenderTargetLayer(const RenderFnParams* params)
 	{
 		Vector2 offset = VECTOR2_ZERO;
 
-		for (usize i = 0; i < scene->level.segmentsLength; ++i)
+		for (usize i = 0; i < snapshot->level.segmentsLength; ++i)
 		{
-			const LevelSegment* segment = &scene->level.segments[i];
+			const LevelSegment* segment = &snapshot->level.segments[i];
 
 			const Rectangle segmentBounds = (Rectangle) {
 				.x = offset.x,
@@ -1346,26 +1695,25 @@ static void RenderTargetLayer(const RenderFnParams* params)
 
 			if (CheckCollisionRecs(params->cameraBounds, segmentBounds))
 			{
-				LevelSegmentDraw(segment, &scene->atlas, offset);
+				LevelSegmentDraw(segment, &drawParams->scene->atlas, offset);
 			}
 
 			offset.x += segment->width;
 		}
 	}
 
-	const usize entities = SceneGetTotalAllocatedEntities(scene);
-
 	// TODO(thismarvin): There needs to be a better way to sort draw calls...
 
-	RUN_SYSTEM(SSpriteDraw, scene, entities);
-	RUN_SYSTEM(SAnimationDraw, scene, entities);
+	PROFILE_BEGIN("DrawSprites");
+	DrawSprites(&drawParams->scene->atlas, snapshot);
+	PROFILE_END();
 }
 
 static void RenderTargetLayerShader(const RenderFnParams* params)
 {
-	const Scene* scene = (Scene*)params->scene;
+	const SceneDrawParams* drawParams = params->scene;
 
-	const RenderTexture2D* renderTexture = &scene->targetLayer;
+	const RenderTexture2D* renderTexture = &drawParams->scene->targetLayer;
 
 	const i32 width = renderTexture->texture.width;
 	const i32 height = renderTexture->texture.height;
@@ -1382,7 +1730,7 @@ static void RenderTargetLayerShader(const RenderFnParams* params)
 		.y = floor(height * 0.5),
 	};
 
-	BeginShaderMode(scene->dropShadow);
+	BeginShaderMode(drawParams->scene->dropShadow);
 	BeginDrawing();
 	{
 		ClearBackground(COLOR_TRANSPARENT);
@@ -1398,7 +1746,7 @@ static void RenderTargetLayerShader(const RenderFnParams* params)
 
 static void RenderMenuInterface(const RenderFnParams* params)
 {
-	const Scene* scene = (Scene*)params->scene;
+	const SceneDrawParams* drawParams = params->scene;
 
 	const Color transparentBlack = (Color) { 0, 0, 0, 100 };
 
@@ -1406,7 +1754,7 @@ static void RenderMenuInterface(const RenderFnParams* params)
 
 	// Draw logo.
 	{
-		const AtlasDrawParams drawParams = (AtlasDrawParams) {
+		const AtlasDrawParams logoParams = (AtlasDrawParams) {
 			.sprite = SPRITE_LOGO,
 			.position = (Vector2) { 32, (180.0 - 112) / 2 },
 			.scale = Vector2Create(1, 1),
@@ -1414,7 +1762,7 @@ static void RenderMenuInterface(const RenderFnParams* params)
 			.reflection = REFLECTION_NONE,
 			.tint = COLOR_WHITE,
 		};
-		AtlasDraw(&scene->atlas, &drawParams);
+		AtlasDraw(&drawParams->scene->atlas, &logoParams);
 	}
 }
 
@@ -1423,22 +1771,22 @@ static void RenderActionInterface(const RenderFnParams* params)
 	static const usize healthBarWidth = (15 * PLAYER_MAX_HIT_POINTS) + 4;
 	static const usize padding = 4;
 
-	const Scene* scene = (Scene*)params->scene;
+	const SceneDrawParams* drawParams = params->scene;
 
 	ClearBackground(COLOR_TRANSPARENT);
 
-	SceneDrawScore(scene, Vector2Create(padding, padding));
+	SceneDrawScore(drawParams, Vector2Create(padding, padding));
 	SceneDrawHealthBar(
-		scene,
+		drawParams,
 		Vector2Create(CTX_VIEWPORT_WIDTH - padding - healthBarWidth, padding)
 	);
 }
 
 static void RenderInterfaceLayer(const RenderFnParams* params)
 {
-	const Scene* scene = (Scene*)params->scene;
+	const SceneDrawParams* drawParams = params->scene;
 
-	switch (scene->state)
+	switch (drawParams->snapshot->state)
 	{
 		case SCENE_STATE_MENU: {
 			RenderMenuInterface(params);
@@ -1453,73 +1801,85 @@ static void RenderInterfaceLayer(const RenderFnParams* params)
 
 static void RenderTransitionLayer(const RenderFnParams* params)
 {
-	const Scene* scene = (Scene*)params->scene;
+	const SceneDrawParams* drawParams = params->scene;
 
 	ClearBackground(COLOR_TRANSPARENT);
 
-	if (scene->director == DIRECTOR_STATE_SUPERVISE)
+	if (drawParams->snapshot->director == DIRECTOR_STATE_SUPERVISE)
 	{
 		return;
 	}
 
-	FaderDraw(&scene->fader);
+	FaderDraw(&drawParams->snapshot->fader);
 }
 
 static void RenderForegroundLayer(const RenderFnParams* params)
 {
-	const Scene* scene = (Scene*)params->scene;
+	const SceneDrawParams* drawParams = params->scene;
 
 	ClearBackground(COLOR_TRANSPARENT);
 
-	const usize entities = SceneGetTotalAllocatedEntities(scene);
+	PROFILE_BEGIN("DrawPolygons");
+	DrawPolygons(drawParams->snapshot);
+	PROFILE_END();
 
-	RUN_SYSTEM(CloudParticleDraw, scene, entities);
-	RUN_SYSTEM(FogParticleDraw, scene, entities);
-	RUN_SYSTEM(FogDraw, scene, entities);
+	PROFILE_BEGIN("FogDraw");
+	FogDraw(drawParams->snapshot);
+	PROFILE_END();
 }
 
 static void RenderDebugLayer(const RenderFnParams* params)
 {
-	const Scene* scene = (Scene*)params->scene;
+	const SceneDrawParams* drawParams = params->scene;
 
 	ClearBackground(COLOR_TRANSPARENT);
 
-	if (!scene->debugging)
+	if (!drawParams->snapshot->debugging)
 	{
 		return;
 	}
 
-	const usize entities = SceneGetTotalAllocatedEntities(scene);
+	PROFILE_BEGIN("SDebugColliderDraw");
+	SDebugColliderDraw(drawParams->snapshot);
+	PROFILE_END();
+
+	PROFILE_BEGIN("FogDebugDraw");
+	FogDebugDraw(drawParams->snapshot);
+	PROFILE_END();
 
-	RUN_SYSTEM(SDebugColliderDraw, scene, entities);
-	RUN_SYSTEM(FogDebugDraw, scene, entities);
-	RUN_SYSTEM(PlayerDebugDraw, scene, entities);
+	PROFILE_BEGIN("PlayerDebugDraw");
+	PlayerDebugDraw(drawParams->snapshot);
+	PROFILE_END();
 }
 
-static void SceneMenuDraw(Scene* self)
+static void SceneMenuDraw(const Scene* self, const RenderSnapshot* snapshot)
 {
-	Rectangle actionCameraBounds = SceneCalculateActionCameraBounds(self, self->lakitu);
+	const Rectangle actionCameraBounds = CalculateActionCameraBounds(snapshot);
 
-	self->actionCameraPosition = (Vector2) {
-		.x = actionCameraBounds.x,
-		.y = actionCameraBounds.y,
+	SceneDrawParams drawParams = (SceneDrawParams) {
+		.scene = self,
+		.snapshot = snapshot,
+		.actionCameraPosition = (Vector2) {
+			.x = actionCameraBounds.x,
+			.y = actionCameraBounds.y,
+		},
 	};
 
 	const RenderFnParams actionCameraParams = (RenderFnParams) {
-		.scene = self,
+		.scene = &drawParams,
 		.cameraBounds = actionCameraBounds,
 	};
 	const RenderFnParams stationaryCameraParams = (RenderFnParams) {
-		.scene = self,
+		.scene = &drawParams,
 		.cameraBounds = CTX_VIEWPORT,
 	};
 
-	RenderLayer(&self->rootLayer, RenderRootLayer, &stationaryCameraParams);
-	RenderLayer(&self->backgroundLayer, RenderBackgroundLayer, &stationaryCameraParams);
-	RenderLayer(&self->targetLayer, RenderTargetLayer, &actionCameraParams);
-	RenderLayer(&self->targetLayerBuffer, RenderTargetLayerShader, &stationaryCameraParams);
-	RenderLayer(&self->interfaceLayer, RenderInterfaceLayer, &stationaryCameraParams);
-	RenderLayer(&self->transitionLayer, RenderTransitionLayer, &stationaryCameraParams);
+	RENDER_LAYER(&self->rootLayer, RenderRootLayer, &stationaryCameraParams);
+	RENDER_LAYER(&self->backgroundLayer, RenderBackgroundLayer, &stationaryCameraParams);
+	RENDER_LAYER(&self->targetLayer, RenderTargetLayer, &actionCameraParams);
+	RENDER_LAYER(&self->targetLayerBuffer, RenderTargetLayerShader, &stationaryCameraParams);
+	RENDER_LAYER(&self->interfaceLayer, RenderInterfaceLayer, &stationaryCameraParams);
+	RENDER_LAYER(&self->transitionLayer, RenderTransitionLayer, &stationaryCameraParams);
 
 	// clang-format off
 	const RenderTexture renderTextures[5] = {
@@ -1530,35 +1890,42 @@ static void SceneMenuDraw(Scene* self)
 		self->transitionLayer,
 	};
 	// clang-format on
+
+	PROFILE_BEGIN("DrawLayers");
 	DrawLayers(renderTextures, 5);
+	PROFILE_END();
 }
 
-static void SceneActionDraw(Scene* self)
+static void SceneActionDraw(const Scene* self, const RenderSnapshot* snapshot)
 {
-	Rectangle actionCameraBounds = SceneCalculateActionCameraBounds(self, self->player);
+	const Rectangle actionCameraBounds = CalculateActionCameraBounds(snapshot);
 
-	self->actionCameraPosition = (Vector2) {
-		.x = actionCameraBounds.x,
-		.y = actionCameraBounds.y,
+	SceneDrawParams drawParams = (SceneDrawParams) {
+		.scene = self,
+		.snapshot = snapshot,
+		.actionCameraPosition = (Vector2) {
+			.x = actionCameraBounds.x,
+			.y = actionCameraBounds.y,
+		},
 	};
 
 	const RenderFnParams actionCameraParams = (RenderFnParams) {
-		.scene = self,
+		.scene = &drawParams,
 		.cameraBounds = actionCameraBounds,
 	};
 	const RenderFnParams stationaryCameraParams = (RenderFnParams) {
-		.scene = self,
+		.scene = &drawParams,
 		.cameraBounds = CTX_VIEWPORT,
 	};
 
-	RenderLayer(&self->rootLayer, RenderRootLayer, &stationaryCameraParams);
-	RenderLayer(&self->backgroundLayer, RenderBackgroundLayer, &stationaryCameraParams);
-	RenderLayer(&self->targetLayer, RenderTargetLayer, &actionCameraParams);
-	RenderLayer(&self->targetLayerBuffer, RenderTargetLayerShader, &stationaryCameraParams);
-	RenderLayer(&self->foregroundLayer, RenderForegroundLayer, &actionCameraParams);
-	RenderLayer(&self->interfaceLayer, RenderInterfaceLayer, &stationaryCameraParams);
-	RenderLayer(&self->transitionLayer, RenderTransitionLayer, &stationaryCameraParams);
-	RenderLayer(&self->debugLayer, RenderDebugLayer, &actionCameraParams);
+	RENDER_LAYER(&self->rootLayer, RenderRootLayer, &stationaryCameraParams);
+	RENDER_LAYER(&self->backgroundLayer, RenderBackgroundLayer, &stationaryCameraParams);
+	RENDER_LAYER(&self->targetLayer, RenderTargetLayer, &actionCameraParams);
+	RENDER_LAYER(&self->targetLayerBuffer, RenderTargetLayerShader, &stationaryCameraParams);
+	RENDER_LAYER(&self->foregroundLayer, RenderForegroundLayer, &actionCameraParams);
+	RENDER_LAYER(&self->interfaceLayer, RenderInterfaceLayer, &stationaryCameraParams);
+	RENDER_LAYER(&self->transitionLayer, RenderTransitionLayer, &stationaryCameraParams);
+	RENDER_LAYER(&self->debugLayer, RenderDebugLayer, &actionCameraParams);
 
 	// clang-format off
 	const RenderTexture renderTextures[7] = {
@@ -1571,21 +1938,24 @@ static void SceneActionDraw(Scene* self)
 		self->debugLayer,
 	};
 	// clang-format on
+
+	PROFILE_BEGIN("DrawLayers");
 	DrawLayers(renderTextures, 7);
+	PROFILE_END();
 }
 
-void SceneDraw(Scene* self)
+void SceneDraw(const Scene* self, const RenderSnapshot* snapshot)
 {
 	BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
 
-	switch (self->state)
+	switch (snapshot->state)
 	{
 		case SCENE_STATE_MENU: {
-			SceneMenuDraw(self);
+			SceneMenuDraw(self, snapshot);
 			break;
 		}
 		case SCENE_STATE_ACTION: {
-			SceneActionDraw(self);
+			SceneActionDraw(self, snapshot);
 			break;
 		}
 	}
@@ -1593,6 +1963,154 @@ void SceneDraw(Scene* self)
 	EndBlendMode();
 }
 
+void SceneInitSnapshot(RenderSnapshot* self)
+{
+	self->treePositionsBack = DEQUE_OF(Vector2);
+	self->treePositionsFront = DEQUE_OF(Vector2);
+	// Scenes plant trees as soon as they are initialized, so the first snapshot always copies them.
+	self->treePlantings = 0;
+
+	self->spritesLength = 0;
+	self->animationsLength = 0;
+	self->cloudParticlesLength = 0;
+	self->fogParticlesLength = 0;
+	self->collidersLength = 0;
+	self->playerBoundsLength = 0;
+}
+
+static void CopyDeque(Deque* destination, const Deque* source)
+{
+	DequeClear(destination);
+
+	for (usize i = 0; i < DequeGetSize(source); ++i)
+	{
+		DequePushBack(destination, DequeGetUnchecked(source, i));
+	}
+}
+
+// Copies the center of whichever entity the camera follows (see CalculateActionCameraBounds).
+static void SnapshotCamera(RenderSnapshot* self, const Scene* source)
+{
+	const usize target = source->state == SCENE_STATE_MENU ? source->lakitu : source->player;
+	const u64 tags = source->components.tags[target];
+
+	self->cameraFollows = (tags & TAG_POSITION) == TAG_POSITION;
+
+	if (!self->cameraFollows)
+	{
+		return;
+	}
+
+	Vector2 position = source->components.positions[target].value;
+	Vector2 previous = position;
+
+	if ((tags & TAG_SMOOTH) == TAG_SMOOTH)
+	{
+		previous = source->components.smooths[target].previous;
+	}
+
+	if ((tags & TAG_DIMENSION) == TAG_DIMENSION)
+	{
+		const CDimension* dimension = &source->components.dimensions[target];
+
+		const Vector2 offset = (Vector2) {
+			.x = dimension->width * 0.5,
+			.y = dimension->height * 0.5,
+		};
+
+		position = Vector2Add(position, offset);
+		previous = Vector2Add(previous, offset);
+	}
+
+	self->cameraTarget = position;
+	self->cameraPrevious = previous;
+}
+
+void SceneTakeSnapshot(RenderSnapshot* self, const Scene* source)
+{
+	const usize entities = SceneGetTotalAllocatedEntities(source);
+
+	self->state = source->state;
+	self->director = source->director;
+	self->fader = source->fader;
+	self->level = source->level;
+	self->bounds = source->bounds;
+	self->elapsedTime = source->elapsedTime;
+	memcpy(self->scoreString, source->scoreString, sizeof(self->scoreString));
+	self->hp = source->components.mortals[source->player].hp;
+
+	SnapshotCamera(self, source);
+
+	self->debugging = source->debugging;
+
+	self->spritesLength = 0;
+	self->animationsLength = 0;
+	self->cloudParticlesLength = 0;
+	self->fogParticlesLength = 0;
+	self->collidersLength = 0;
+	self->playerBoundsLength = 0;
+
+	// Only hand each entity to the systems that could possibly draw it; most entities are only
+	// drawn by one of them, if any.
+	for (usize i = 0; i < entities; ++i)
+	{
+		const u64 tags = source->components.tags[i];
+
+		if ((tags & TAG_SPRITE) == TAG_SPRITE)
+		{
+			SSpriteSnapshot(source, i, self);
+		}
+
+		if ((tags & TAG_ANIMATION) == TAG_ANIMATION)
+		{
+			SAnimationSnapshot(source, i, self);
+		}
+
+		if ((tags & (TAG_IDENTIFIER | TAG_FLEETING)) == (TAG_IDENTIFIER | TAG_FLEETING))
+		{
+			switch (source->components.identifiers[i].type)
+			{
+				case ENTITY_TYPE_CLOUD_PARTICLE: {
+					CloudParticleSnapshot(source, i, self);
+					break;
+				}
+				case ENTITY_TYPE_FOG_PARTICLE: {
+					FogParticleSnapshot(source, i, self);
+					break;
+				}
+				default: {
+					break;
+				}
+			}
+		}
+
+		if (!self->debugging)
+		{
+			continue;
+		}
+
+		if ((tags & TAG_COLLIDER) == TAG_COLLIDER)
+		{
+			SDebugColliderSnapshot(source, i, self);
+		}
+
+		if ((tags & TAG_PLAYER) == TAG_PLAYER)
+		{
+			PlayerDebugSnapshot(source, i, self);
+		}
+	}
+
+	self->fogVisible = false;
+	FogSnapshot(source, source->fog, self);
+
+	if (self->treePlantings != source->treePlantings)
+	{
+		CopyDeque(&self->treePositionsBack, &source->treePositionsBack);
+		CopyDeque(&self->treePositionsFront, &source->treePositionsFront);
+		self->treePlantings = source->treePlantings;
+	}
+}
+
 void SceneDestroy(Scene* self)
 {
 	AtlasDestroy(&self->atlas);
@@ -1604,37 +2122,22 @@ void SceneDestroy(Scene* self)
 
 	ArenaAllocatorDestroy(&self->arenaAllocator);
 
-	UnloadRenderTexture(self->treeTexture);
-	UnloadRenderTexture(self->backgroundLayer);
-	UnloadRenderTexture(self->targetLayer);
-	UnloadRenderTexture(self->targetLayerBuffer);
-	UnloadRenderTexture(self->foregroundLayer);
-	UnloadRenderTexture(self->interfaceLayer);
-	UnloadRenderTexture(self->transitionLayer);
-	UnloadRenderTexture(self->debugLayer);
+	for (SceneLayer i = 0; i < SCENE_LAYER_TOTAL; ++i)
+	{
+		UnloadRenderTexture(SceneGetLayer(self, i));
+	}
 
 	for (usize i = 0; i < MAX_PLAYERS; ++i)
 	{
 		InputProfileDestroy(&self->inputProfiles[i]);
 	}
 
-#if !defined(NDEBUG)
-	// Dump player-one's input.
+	if (self->recorder != NULL)
 	{
-		ReplayResult result = ReplayTryFromInputStream(self->seed, &self->inputStreams[0]);
-
-		if (result.type == REPLAY_RESULT_TYPE_OK)
-		{
-			Replay* replay = &result.contents.ok;
-			ReplayBytes bytes = ReplayBytesFromReplay(replay);
-
-			SaveFileData("debug_recording.ltlrr", bytes.data, bytes.size);
-
-			ReplayBytesDestroy(&bytes);
-			ReplayDestroy(replay);
-		}
+		ReplayWriterDestroy(self->recorder);
 	}
-#endif
+
+	SceneStopPlayback(self);
 
 	for (usize i = 0; i < MAX_PLAYERS; ++i)
 	{
@@ -1643,3 +2146,9 @@ void SceneDestroy(Scene* self)
 
 	UnloadShader(self->dropShadow);
 }
+
+void SceneDestroySnapshot(RenderSnapshot* self)
+{
+	DequeDestroy(&self->treePositionsBack);
+	DequeDestroy(&self->treePositionsFront);
+}
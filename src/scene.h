@@ -7,11 +7,15 @@
 #include "common.h"
 #include "fader.h"
 #include "input.h"
+#include "input_queue.h"
 #include "level.h"
 #include "replay.h"
+#include "replay_writer.h"
 #include "rng.h"
+#include "stress.h"
 
 #include <raylib.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 
 #define TOTAL_INPUT_BINDINGS (4)
@@ -38,6 +42,21 @@ typedef enum
 	SCENE_STATE_ACTION,
 } SceneState;
 
+// Every render texture the scene loads (see SceneSetupGraphics).
+typedef enum
+{
+	SCENE_LAYER_ROOT,
+	SCENE_LAYER_BACKGROUND,
+	SCENE_LAYER_TARGET,
+	SCENE_LAYER_TARGET_BUFFER,
+	SCENE_LAYER_FOREGROUND,
+	SCENE_LAYER_INTERFACE,
+	SCENE_LAYER_TRANSITION,
+	SCENE_LAYER_DEBUG,
+	SCENE_LAYER_TREE,
+	SCENE_LAYER_TOTAL,
+} SceneLayer;
+
 typedef enum
 {
 	DIRECTOR_STATE_ENTRANCE,
@@ -77,6 +96,7 @@ struct Scene
 	SceneState state;
 	Components components;
 	EntityManager m_entityManager;
+	// Whether snapshots include what the debug layer draws (see SceneTakeSnapshot).
 	bool debugging;
 	u32 score;
 	f32 scoreBufferTimerDuration;
@@ -93,6 +113,7 @@ struct Scene
 	u8 stage;
 	DirectorState director;
 	Fader fader;
+	// Every layer (and the tree texture) is listed in SceneLayer.
 	RenderTexture2D rootLayer;
 	RenderTexture2D backgroundLayer;
 	RenderTexture2D targetLayer;
@@ -104,28 +125,158 @@ struct Scene
 	InputProfile inputProfiles[MAX_PLAYERS];
 	InputHandler inputs[MAX_PLAYERS];
 	InputStream inputStreams[MAX_PLAYERS];
+	// Player one's own InputStream, set aside while a Replay is played back in its place (see
+	// SceneStartPlayback).
+	InputStream m_ownInputStream;
+	// Changes in live input, timestamped by SceneSampleInput and consumed by SceneUpdate.
+	InputQueue inputQueue;
+	// The last state pushed onto the queue, and the state the simulation is currently using. The
+	// former is atomic since SceneReseed (on the simulation's thread) forgets it too.
+	_Atomic(InputActions) sampledInput[MAX_PLAYERS];
+	InputActions liveInput[MAX_PLAYERS];
+	// SceneUpdate only consumes input that was sampled at or before this time.
+	f64 inputDeadline;
+	// Continuously records player-one's input to a temporary file since the scene was last reseeded
+	// (NULL if recording is unavailable); see SceneSaveRecording.
+	ReplayWriter* recorder;
 	Player players[MAX_PLAYERS];
+	FogState fogState;
 	bool resetRequested;
 	bool advanceStageRequested;
-	Vector2 actionCameraPosition;
 	RenderTexture2D treeTexture;
 	// `Deque<Vector2>`
 	Deque treePositionsBack;
 	// `Deque<Vector2>`
 	Deque treePositionsFront;
+	// How many times trees have been planted, so that snapshots only copy them when they change.
+	usize treePlantings;
 	// `Deque<SceneDeferParams>`
 	Deque deferred;
 	usize frame;
 	f64 elapsedTime;
 	u32 seed;
+	// How the scene is simulated; any combination of ReplayFlag (see SceneReseed).
+	u8 replayFlags;
+	// Anything that can affect gameplay (e.g. level generation) draws from `rng`; purely visual
+	// effects draw from SceneGetCosmeticRng so that they can be skipped without changing gameplay.
 	Rng rng;
+	Rng m_cosmeticRng;
+	// Whether visual-only entities and systems (e.g. particles, trails, animation) should run at
+	// all; see SceneSimulatesCosmetics.
+	bool cosmeticsEnabled;
 	ArenaAllocator arenaAllocator;
+	// When this is not NULL, every stage is a synthetic stress test rather than a generated level
+	// (see StressPopulate); it only takes effect the next time a stage is built.
+	const StressParams* stress;
 	Shader dropShadow;
 };
 
+// Something drawn from the atlas: either a CSprite, or the current frame of a CAnimation.
+typedef struct
+{
+	// Where the entity was as of the previous frame, and where it is now; the two are interpolated
+	// when drawn (see ContextGetAlpha).
+	Vector2 previous;
+	Vector2 position;
+	Sprite sprite;
+	Rectangle intramural;
+	Reflection reflection;
+	Color tint;
+} RenderSprite;
+
+// A filled regular polygon (e.g. a particle), interpolated just like a RenderSprite.
+typedef struct
+{
+	Vector2 previous;
+	Vector2 center;
+	f32 radius;
+	f32 rotation;
+	u8 sides;
+	Color color;
+} RenderPolygon;
+
+// An entity's collider, as drawn by the debug layer.
+typedef struct
+{
+	Rectangle aabb;
+	u64 layer;
+	u8 resolutionSchema;
+} RenderCollider;
+
+// Everything SceneDraw reads, copied out of a scene with SceneTakeSnapshot. Only entities that are
+// actually drawn are copied, and only as much of them as drawing needs, so that a snapshot is cheap
+// to take every frame and can be drawn while the scene keeps being simulated on another thread.
+typedef struct RenderSnapshot
+{
+	SceneState state;
+	DirectorState director;
+	Fader fader;
+	Level level;
+	Rectangle bounds;
+	f64 elapsedTime;
+	// Whichever entity the camera follows (its center), unless it has no position.
+	bool cameraFollows;
+	Vector2 cameraPrevious;
+	Vector2 cameraTarget;
+	char scoreString[MAX_SCORE_DIGITS];
+	i16 hp;
+	// Sprites fill `sprites` from the front while animations fill it from the back, both in the
+	// order of their entities. This way, a single pass over the scene gathers both, and every
+	// sprite is still drawn before any animation. Cloud and fog particles share `polygons` alike.
+	RenderSprite sprites[MAX_ENTITIES];
+	usize spritesLength;
+	usize animationsLength;
+	RenderPolygon polygons[MAX_ENTITIES];
+	usize cloudParticlesLength;
+	usize fogParticlesLength;
+	bool fogVisible;
+	Vector2 fogPrevious;
+	Vector2 fogPosition;
+	FogState fogState;
+	// `Deque<Vector2>`; only copied again once the scene plants new trees.
+	Deque treePositionsBack;
+	// `Deque<Vector2>`
+	Deque treePositionsFront;
+	usize treePlantings;
+	// Colliders and players' bounds are only copied while the scene is being debugged.
+	bool debugging;
+	RenderCollider colliders[MAX_ENTITIES];
+	usize collidersLength;
+	Rectangle playerBounds[MAX_PLAYERS];
+	usize playerBoundsLength;
+} RenderSnapshot;
+
+// Sets up everything the simulation needs, up to and including the first stage. This never touches
+// the window or the graphics context, so it is free to run on any thread (see SceneSetupGraphics).
 void SceneInit(Scene* self);
+#if !defined(PLATFORM_HEADLESS)
+// Uploads the atlas, compiles shaders, and allocates every layer. This has to run on the thread
+// that owns the graphics context, once the window is open.
+void SceneSetupGraphics(Scene* self, const Image* atlas);
+#endif
+// Returns how large the given layer is when it is loaded on a monitor of the given size.
+Rectangle SceneGetLayerRegion(SceneLayer layer, Rectangle monitor);
+// Returns the given layer, which has an id of zero unless SceneSetupGraphics loaded it.
+RenderTexture2D SceneGetLayer(const Scene* self, SceneLayer layer);
+// Restarts the scene from scratch with the given seed (e.g. before playing back a Replay), and
+// simulates it like a Replay with the given flags was recorded (see ReplayFlag). Every InputStream
+// is cleared; read-only ones keep playing back their Replay from the start.
+void SceneReseed(Scene* self, u32 seed, u8 replayFlags);
+// Plays the given Replay back as player one's input, in place (see InputStreamCreateView). Call
+// SceneStopPlayback before the Replay is freed.
+void SceneStartPlayback(Scene* self, const Replay* replay);
+// Gives player one back their own InputStream (if a Replay was being played back).
+void SceneStopPlayback(Scene* self);
+// Polls every player's devices and queues any change in their input as happening at the given time.
+void SceneSampleInput(Scene* self, f64 timestamp);
 
 f64 SceneGetElapsedTime(const Scene* self);
+Rng* SceneGetCosmeticRng(Scene* self);
+// Replays recorded without REPLAY_FLAG_COUNTER_RNG shared a single Rng between gameplay and
+// cosmetics, so cosmetics are always simulated while playing one back.
+bool SceneSimulatesCosmetics(const Scene* self);
+// Whether kinematics are integrated with fixed-point numbers (see REPLAY_FLAG_FIXED_POINT).
+bool SceneUsesFixedPoint(const Scene* self);
 
 usize SceneAllocateEntity(Scene* self);
 usize SceneGetTotalAllocatedEntities(const Scene* self);
@@ -149,7 +300,17 @@ void SceneDeferSetTag(Scene* self, usize entity, u64 tag);
 void SceneDeferReset(Scene* self);
 void SceneDeferAdvanceStage(Scene* self);
 
+// Saves every input recorded since the scene was last reseeded over the previous recording (and
+// offers it as a download on the web).
+void SceneSaveRecording(Scene* self);
+
 void SceneUpdate(Scene* self);
-void SceneDraw(Scene* self);
+// Draws a snapshot of the scene with the scene's own layers and textures, which only the thread
+// that owns the graphics context ever touches.
+void SceneDraw(const Scene* self, const RenderSnapshot* snapshot);
+
+void SceneInitSnapshot(RenderSnapshot* self);
+void SceneTakeSnapshot(RenderSnapshot* self, const Scene* source);
+void SceneDestroySnapshot(RenderSnapshot* self);
 
 void SceneDestroy(Scene* self);
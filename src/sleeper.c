@@ -0,0 +1,74 @@
+#include "sleeper.h"
+
+#include "common.h"
+
+#include <math.h>
+#include <raylib.h>
+
+#if defined(_WIN32)
+// Including windows.h clashes with raylib, so declare the one function we need instead.
+__declspec(dllimport) void __stdcall Sleep(unsigned long milliseconds);
+#else
+	#include <time.h>
+#endif
+
+// How much weight each new measurement of how long the OS oversleeps carries.
+#define OVERSLEEP_WEIGHT (0.05)
+// An upper bound on how long to spin for; rare spikes beyond it are not worth burning the CPU on.
+#define OVERSLEEP_LIMIT (0.001)
+
+Sleeper SleeperCreate(void)
+{
+	return (Sleeper) {
+		.m_oversleepMean = 0.001,
+		.m_oversleepVariance = 0,
+	};
+}
+
+static void SleepFor(const f64 seconds)
+{
+#if defined(_WIN32)
+	Sleep((unsigned long)(seconds * 1000));
+#else
+	const struct timespec duration = (struct timespec) {
+		.tv_sec = (time_t)seconds,
+		.tv_nsec = (long)((seconds - (time_t)seconds) * 1e9),
+	};
+
+	nanosleep(&duration, NULL);
+#endif
+}
+
+void SleeperWaitUntil(Sleeper* self, const f64 deadline)
+{
+	// Wake up early enough to cover most oversleeps, then spin for the remainder.
+	const f64 margin = self->m_oversleepMean + 2 * sqrt(self->m_oversleepVariance);
+	const f64 wakeTime = deadline - MIN(margin, OVERSLEEP_LIMIT);
+	const f64 currentTime = GetTime();
+
+	if (wakeTime > currentTime)
+	{
+		SleepFor(wakeTime - currentTime);
+
+		const f64 overslept = GetTime() - wakeTime;
+		const f64 difference = overslept - self->m_oversleepMean;
+
+		self->m_oversleepMean += OVERSLEEP_WEIGHT * difference;
+		self->m_oversleepVariance = (1 - OVERSLEEP_WEIGHT)
+			* (self->m_oversleepVariance + OVERSLEEP_WEIGHT * difference * difference);
+	}
+
+	while (GetTime() < deadline)
+	{
+	}
+}
+
+void SleeperSleepUntil(const f64 deadline)
+{
+	const f64 currentTime = GetTime();
+
+	if (deadline > currentTime)
+	{
+		SleepFor(deadline - currentTime);
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "common.h"
+
+// Waits for a given time (see GetTime) more precisely than the OS would on its own, without
+// spinning the whole time either. Most of the wait is slept away, and only the last stretch (about
+// as long as the OS usually oversleeps by) is spent spinning.
+typedef struct
+{
+	// How much longer than requested sleeping tends to take (in seconds), and how much that varies.
+	f64 m_oversleepMean;
+	f64 m_oversleepVariance;
+} Sleeper;
+
+Sleeper SleeperCreate(void);
+void SleeperWaitUntil(Sleeper* self, f64 deadline);
+// Sleeps until roughly the given time, without spinning at all; for waits where a millisecond or so
+// of oversleeping does not matter.
+void SleeperSleepUntil(f64 deadline);
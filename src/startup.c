@@ -0,0 +1,101 @@
+#include "startup.h"
+
+#include <stdatomic.h>
+#include <time.h>
+
+static f64 start;
+static StartupPhase phases[STARTUP_MAX_PHASES];
+static atomic_size_t phasesLength;
+static atomic_bool finished;
+static f64 timeToFirstFrame;
+
+static _Thread_local const char* threadName = "?";
+
+// Neither raylib's GetTime (which only starts once a window is open) nor CLOCK_MONOTONIC (which
+// Windows lacks) work here; a wall clock is good enough for something that takes a second at most.
+static f64 Now(void)
+{
+	struct timespec time;
+	timespec_get(&time, TIME_UTC);
+
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+void StartupInit(void)
+{
+	start = Now();
+	atomic_store(&phasesLength, 0);
+	atomic_store(&finished, false);
+	timeToFirstFrame = 0;
+}
+
+void StartupNameThread(const char* name)
+{
+	threadName = name;
+}
+
+usize StartupBegin(const char* name)
+{
+	const usize phase = atomic_fetch_add(&phasesLength, 1);
+
+	if (phase < STARTUP_MAX_PHASES)
+	{
+		phases[phase] = (StartupPhase) {
+			.name = name,
+			.thread = threadName,
+			.begin = Now() - start,
+			.end = 0,
+		};
+	}
+
+	return phase;
+}
+
+void StartupEnd(const usize phase)
+{
+	if (phase < STARTUP_MAX_PHASES)
+	{
+		phases[phase].end = Now() - start;
+	}
+}
+
+void StartupFinish(void)
+{
+	if (!atomic_exchange(&finished, true))
+	{
+		timeToFirstFrame = Now() - start;
+	}
+}
+
+bool StartupIsFinished(void)
+{
+	return atomic_load(&finished);
+}
+
+f64 StartupGetTimeToFirstFrame(void)
+{
+	return timeToFirstFrame;
+}
+
+void StartupWriteReport(FILE* file)
+{
+	const usize length = MIN(atomic_load(&phasesLength), STARTUP_MAX_PHASES);
+
+	fprintf(file, "%-24s %-8s %10s %10s\n", "startup phase", "thread", "begin (ms)", "took (ms)");
+
+	for (usize i = 0; i < length; ++i)
+	{
+		const StartupPhase* phase = &phases[i];
+
+		fprintf(
+			file,
+			"%-24s %-8s %10.2f %10.2f\n",
+			phase->name,
+			phase->thread,
+			phase->begin * 1e3,
+			(phase->end - phase->begin) * 1e3
+		);
+	}
+
+	fprintf(file, "%-24s %-8s %10.2f\n", "first frame", "", timeToFirstFrame * 1e3);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "common.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#define STARTUP_MAX_PHASES (16)
+
+typedef struct
+{
+	const char* name;
+	// The name of the thread that the phase ran on (see StartupNameThread).
+	const char* thread;
+	// When the phase began and ended, in seconds since StartupInit.
+	f64 begin;
+	f64 end;
+} StartupPhase;
+
+// Records how long each phase of startup takes (on whichever thread it runs on) until the first
+// frame is presented. Unlike GetTime, this works before the window is created.
+
+// Starts the clock that every phase is measured against; call this before anything else.
+void StartupInit(void);
+// Names the calling thread in the report.
+void StartupNameThread(const char* name);
+// Returns a handle to pass to StartupEnd. Phases on different threads are free to overlap; any
+// beyond STARTUP_MAX_PHASES are not recorded.
+usize StartupBegin(const char* name);
+void StartupEnd(usize phase);
+// Marks the first frame as presented, which ends startup as a whole; only the first call counts.
+void StartupFinish(void);
+bool StartupIsFinished(void);
+// How long it took from StartupInit until the first frame was presented (in seconds).
+f64 StartupGetTimeToFirstFrame(void);
+// Writes a table of every phase (in the order they began) to the given file.
+void StartupWriteReport(FILE* file);
@@ -0,0 +1,153 @@
+#include "stress.h"
+
+#include "./ecs/components.h"
+#include "./ecs/entities.h"
+#include "common.h"
+#include "context.h"
+#include "rng.h"
+#include "scene.h"
+
+#include <assert.h>
+#include <raylib.h>
+#include <stdbool.h>
+
+// Real levels average a little under one entity per 8 pixels.
+#define STRESS_PIXELS_PER_ENTITY (8)
+// Room for the player, fog and lakitu, and for everything they spawn while the stage is played.
+#define STRESS_RESERVED_ENTITIES (128)
+
+#define STRESS_FLOOR_Y (16 * 10)
+#define STRESS_FLOOR_HEIGHT (16 * 2)
+
+StressParams StressParamsCreate(const usize entities, const u32 width)
+{
+	const usize total = MIN(entities, MAX_ENTITIES - STRESS_RESERVED_ENTITIES);
+	const u32 minimumWidth = CTX_VIEWPORT_WIDTH * 2;
+	const u32 denseWidth = (u32)total * STRESS_PIXELS_PER_ENTITY;
+
+	// Blocks make up most of a real level, followed by enemies, hazards, and collectibles.
+	const u16 walkers = total / 5;
+	const u16 spikes = total / 8;
+	const u16 batteries = total / 16;
+	const u16 particles = total / 8;
+
+	return (StressParams) {
+		.width = width != 0 ? width : MAX(denseWidth, minimumWidth),
+		.blocks = MAX(total - walkers - spikes - batteries - particles, 3),
+		.walkers = walkers,
+		.spikes = spikes,
+		.batteries = batteries,
+		.particles = particles,
+	};
+}
+
+usize StressParamsGetTotalEntities(const StressParams* self)
+{
+	return self->blocks + self->walkers + self->spikes + self->batteries + self->particles;
+}
+
+static f32 RandomX(Scene* scene, const u32 width)
+{
+	return RngNextRange(&scene->rng, 0, width - 16);
+}
+
+// Builders are called directly (rather than deferred like a level segment's are); the scene's
+// arena is only sized for real levels.
+void StressPopulate(Scene* scene, const StressParams* params)
+{
+	const u32 width = MAX(params->width, CTX_VIEWPORT_WIDTH);
+
+	scene->bounds = (Rectangle) {
+		.x = 0,
+		.y = 0,
+		.width = width,
+		.height = CTX_VIEWPORT_HEIGHT,
+	};
+
+	// The fog stops a screen short of the end of the level, just like it does before a real
+	// level's last segment.
+	scene->level.segments[0] = (LevelSegment) {
+		.type = 0,
+		.width = CTX_VIEWPORT_WIDTH,
+	};
+	scene->level.segmentsLength = 1;
+
+	// The first two blocks are walls that keep walkers from walking off of the stage.
+	{
+		assert(params->blocks >= 3);
+
+		const usize floors = params->blocks - 2;
+		const f32 floorWidth = (f32)width / floors;
+
+		for (usize i = 0; i < params->blocks; ++i)
+		{
+			const bool wall = i < 2;
+			const Rectangle aabb = wall ? (Rectangle) {
+				.x = i == 0 ? -16.0F : width,
+				.y = 0,
+				.width = 16,
+				.height = STRESS_FLOOR_Y,
+			} : (Rectangle) {
+				.x = floorWidth * (i - 2),
+				.y = STRESS_FLOOR_Y,
+				.width = floorWidth,
+				.height = STRESS_FLOOR_HEIGHT,
+			};
+
+			const BlockBuilder builder = {
+				.entity = SceneAllocateEntity(scene),
+				.aabb = aabb,
+				.resolutionSchema = RESOLVE_ALL,
+				.layer = LAYER_TERRAIN,
+			};
+			BlockBuild(scene, &builder);
+		}
+	}
+
+	for (usize i = 0; i < params->walkers; ++i)
+	{
+		const WalkerBuilder builder = {
+			.entity = SceneAllocateEntity(scene),
+			.x = RandomX(scene, width),
+			.y = STRESS_FLOOR_Y - 16 * RngNextRange(&scene->rng, 1, 4 + 1),
+		};
+		WalkerBuild(scene, &builder);
+	}
+
+	for (usize i = 0; i < params->spikes; ++i)
+	{
+		const SpikeBuilder builder = {
+			.entity = SceneAllocateEntity(scene),
+			.x = RandomX(scene, width),
+			.y = 0,
+			.rotation = SPIKE_ROTATE_180,
+		};
+		SpikeBuild(scene, &builder);
+	}
+
+	for (usize i = 0; i < params->batteries; ++i)
+	{
+		const BatteryBuilder builder = {
+			.entity = SceneAllocateEntity(scene),
+			.x = RandomX(scene, width),
+			.y = STRESS_FLOOR_Y - 16 * RngNextRange(&scene->rng, 2, 5 + 1),
+		};
+		BatteryBuild(scene, &builder);
+	}
+
+	for (usize i = 0; i < params->particles; ++i)
+	{
+		const CloudParticleBuilder builder = {
+			.entity = SceneAllocateEntity(scene),
+			.position = Vector2Create(RandomX(scene, width), RngNextRange(&scene->rng, 16, 128)),
+			.radius = RngNextRange(&scene->rng, 1, 3 + 1),
+			.initialVelocity = Vector2Create(
+				RngNextRange(&scene->rng, -16, 16 + 1),
+				RngNextRange(&scene->rng, -8, 8 + 1)
+			),
+			.acceleration = VECTOR2_ZERO,
+			.lifetime = RngNextRange(&scene->rng, 10, 60 + 1),
+		};
+		CloudParticleBuild(scene, &builder);
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "common.h"
+
+typedef struct Scene Scene;
+
+// Describes a synthetic stage that is filled with however many entities it takes to see how the
+// simulation scales (real levels only ever have a few hundred of them). Stress stages are only
+// meant to be simulated; they are not drawn like a real level.
+typedef struct
+{
+	// How wide the stage is in pixels; it is always a single screen tall.
+	u32 width;
+	// Two of these are walls at either end of the stage; the floor is split between the rest.
+	u16 blocks;
+	u16 walkers;
+	// Spikes hang from the ceiling, out of the player's reach, so that they never end a run early.
+	u16 spikes;
+	u16 batteries;
+	u16 particles;
+} StressParams;
+
+// Splits the given number of entities between every kind of entity (in roughly the proportions a
+// real level has them). If `width` is zero, the stage is made just wide enough to keep entities as
+// dense as they are in a real level.
+StressParams StressParamsCreate(usize entities, u32 width);
+usize StressParamsGetTotalEntities(const StressParams* self);
+
+// Builds a stress stage in place of a generated level (see Scene.stress). Every entity is placed
+// with the scene's Rng, so the same seed always results in the same stage.
+void StressPopulate(Scene* scene, const StressParams* params);
@@ -0,0 +1,258 @@
+#include "tracing.h"
+
+#include <raylib.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+typedef enum
+{
+	TRACING_EVENT_BEGIN,
+	TRACING_EVENT_END,
+	TRACING_EVENT_COUNTER,
+} TracingEventType;
+
+// Every field is atomic so that events can be saved while they are potentially being overwritten;
+// events that were overwritten midway are detected and skipped (see TracingSaveBuffer).
+typedef struct
+{
+	_Atomic(const char*) name;
+	// When the event happened (in nanoseconds), shifted left to make room for its TracingEventType.
+	_Atomic u64 stamp;
+	_Atomic i64 value;
+} TracingEvent;
+
+typedef struct
+{
+	const char* name;
+	u64 stamp;
+	i64 value;
+} TracingEventCopy;
+
+// A ring of events that only one thread ever writes to.
+typedef struct
+{
+	TracingEvent events[TRACING_CAPACITY];
+	_Atomic(const char*) name;
+	// How many events have begun to be written, and how many of those are done.
+	_Atomic usize begun;
+	_Atomic usize written;
+} TracingBuffer;
+
+static atomic_bool enabled;
+
+static _Atomic(TracingBuffer*) buffers[TRACING_MAX_THREADS];
+static atomic_size_t buffersLength;
+
+static _Thread_local TracingBuffer* buffer;
+static _Thread_local bool registered;
+
+void TracingEnable(void)
+{
+	atomic_store(&enabled, true);
+}
+
+// Returns the calling thread's buffer (if there is room for one).
+static TracingBuffer* TracingGetBuffer(void)
+{
+	if (!registered)
+	{
+		registered = true;
+
+		const usize index = atomic_fetch_add(&buffersLength, 1);
+
+		// Any threads beyond the limit are simply not traced.
+		if (index >= TRACING_MAX_THREADS)
+		{
+			return NULL;
+		}
+
+		buffer = calloc(1, sizeof(TracingBuffer));
+		atomic_store(&buffers[index], buffer);
+	}
+
+	return buffer;
+}
+
+void TracingNameThread(const char* name)
+{
+	if (!atomic_load_explicit(&enabled, memory_order_relaxed) || TracingGetBuffer() == NULL)
+	{
+		return;
+	}
+
+	atomic_store(&buffer->name, name);
+}
+
+static void TracingPush(const char* name, const TracingEventType type, const i64 value)
+{
+	if (!atomic_load_explicit(&enabled, memory_order_relaxed) || TracingGetBuffer() == NULL)
+	{
+		return;
+	}
+
+	const usize index = atomic_load_explicit(&buffer->written, memory_order_relaxed);
+	TracingEvent* event = &buffer->events[index % TRACING_CAPACITY];
+
+	const u64 stamp = ((u64)(GetTime() * 1e9) << 2) | type;
+
+	// Announce that the oldest event is about to be overwritten before actually doing so.
+	atomic_store_explicit(&buffer->begun, index + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+
+	atomic_store_explicit(&event->name, name, memory_order_relaxed);
+	atomic_store_explicit(&event->stamp, stamp, memory_order_relaxed);
+	atomic_store_explicit(&event->value, value, memory_order_relaxed);
+
+	atomic_store_explicit(&buffer->written, index + 1, memory_order_release);
+}
+
+void TracingBegin(const char* name)
+{
+	TracingPush(name, TRACING_EVENT_BEGIN, 0);
+}
+
+void TracingEnd(void)
+{
+	TracingPush(NULL, TRACING_EVENT_END, 0);
+}
+
+void TracingCounter(const char* name, const i64 value)
+{
+	TracingPush(name, TRACING_EVENT_COUNTER, value);
+}
+
+static void TracingSeparate(FILE* file, bool* first)
+{
+	if (!*first)
+	{
+		fputs(",\n", file);
+	}
+
+	*first = false;
+}
+
+static void TracingSaveBuffer(TracingBuffer* source, const usize thread, FILE* file, bool* first)
+{
+	const usize written = atomic_load_explicit(&source->written, memory_order_acquire);
+	const usize start = written > TRACING_CAPACITY ? written - TRACING_CAPACITY : 0;
+
+	TracingEventCopy* events = malloc(sizeof(TracingEventCopy) * (written - start));
+
+	for (usize i = start; i < written; ++i)
+	{
+		TracingEvent* event = &source->events[i % TRACING_CAPACITY];
+		TracingEventCopy* copy = &events[i - start];
+
+		copy->name = atomic_load_explicit(&event->name, memory_order_relaxed);
+		copy->stamp = atomic_load_explicit(&event->stamp, memory_order_relaxed);
+		copy->value = atomic_load_explicit(&event->value, memory_order_relaxed);
+	}
+
+	// Skip whichever events the thread started overwriting while they were being copied.
+	atomic_thread_fence(memory_order_acquire);
+
+	const usize begun = atomic_load_explicit(&source->begun, memory_order_relaxed);
+	const usize valid = MAX(start, begun > TRACING_CAPACITY ? begun - TRACING_CAPACITY : 0);
+
+	const char* name = atomic_load(&source->name);
+
+	if (name != NULL)
+	{
+		TracingSeparate(file, first);
+		fprintf(
+			file,
+			"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,"
+			"\"args\":{\"name\":\"%s\"}}",
+			thread,
+			name
+		);
+	}
+
+	// The oldest events may end sections whose beginning was already overwritten.
+	usize depth = 0;
+
+	for (usize i = valid; i < written; ++i)
+	{
+		const TracingEventCopy* event = &events[i - start];
+		const TracingEventType type = event->stamp & 3;
+		const f64 microseconds = (event->stamp >> 2) * 1e-3;
+
+		if (type == TRACING_EVENT_END && depth == 0)
+		{
+			continue;
+		}
+
+		TracingSeparate(file, first);
+
+		// Note that names are assumed not to need escaping.
+		switch (type)
+		{
+			case TRACING_EVENT_BEGIN: {
+				fprintf(
+					file,
+					"{\"name\":\"%s\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%zu}",
+					event->name,
+					microseconds,
+					thread
+				);
+				depth += 1;
+				break;
+			}
+			case TRACING_EVENT_END: {
+				fprintf(
+					file,
+					"{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%zu}",
+					microseconds,
+					thread
+				);
+				depth -= 1;
+				break;
+			}
+			case TRACING_EVENT_COUNTER: {
+				fprintf(
+					file,
+					"{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%zu,"
+					"\"args\":{\"value\":%lld}}",
+					event->name,
+					microseconds,
+					thread,
+					(long long)event->value
+				);
+				break;
+			}
+		}
+	}
+
+	free(events);
+}
+
+bool TracingSave(const char* path)
+{
+	FILE* file = fopen(path, "w");
+
+	if (file == NULL)
+	{
+		return false;
+	}
+
+	fputs("{\"traceEvents\":[\n", file);
+
+	bool first = true;
+
+	const usize length = MIN(atomic_load(&buffersLength), TRACING_MAX_THREADS);
+
+	for (usize i = 0; i < length; ++i)
+	{
+		TracingBuffer* source = atomic_load(&buffers[i]);
+
+		// The thread may still be setting its buffer up.
+		if (source != NULL)
+		{
+			TracingSaveBuffer(source, i + 1, file, &first);
+		}
+	}
+
+	fputs("\n]}\n", file);
+
+	return fclose(file) == 0;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "common.h"
+
+// How many of the most recent events are kept per thread.
+#define TRACING_CAPACITY ((usize)1 << 16)
+#define TRACING_MAX_THREADS (8)
+
+// Records when sections of code begin and end (see PROFILE_BEGIN), along with counters, into a
+// lock-free buffer per thread. The most recent events can be saved as a Chrome trace (JSON) at any
+// time, and opened in Perfetto or chrome://tracing.
+
+// Nothing is recorded until tracing is enabled.
+void TracingEnable(void);
+// Names the calling thread in saved traces.
+void TracingNameThread(const char* name);
+void TracingBegin(const char* name);
+void TracingEnd(void);
+void TracingCounter(const char* name, i64 value);
+// Writes every thread's most recent events to the given path; returns false if that fails. This is
+// safe to call while other threads keep recording.
+bool TracingSave(const char* path);
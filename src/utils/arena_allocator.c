@@ -1,10 +1,15 @@
 #include "arena_allocator.h"
 
+#include "../allocations.h"
+#include "../counters.h"
+
 #include <assert.h>
 #include <stdlib.h>
 
 ArenaAllocator ArenaAllocatorCreate(const usize size)
 {
+	TRACK_ALLOCATION();
+
 	return (ArenaAllocator) {
 		.data = malloc(size),
 		.head = 0,
@@ -20,6 +25,8 @@ void* ArenaAllocatorTake(ArenaAllocator* self, const usize size)
 
 	assert(self->head <= self->size);
 
+	CounterRaise(COUNTER_ARENA_BYTES, self->head);
+
 	return (char*)self->data + offset;
 }
 
@@ -1,6 +1,7 @@
 #include "quadtree.h"
 
 #include "../collections/deque.h"
+#include "../allocations.h"
 
 #include <stdbool.h>
 #include <stdint.h>
@@ -47,6 +48,7 @@ static bool RegionContains(const Region self, const Region other)
 static Quadtree* New(const Region region, const uint8_t maxDepth, const uint8_t depth)
 {
 	Quadtree* quadtree = malloc(sizeof(Quadtree));
+	TRACK_ALLOCATION();
 
 	quadtree->region = region;
 	quadtree->maxDepth = maxDepth;
@@ -197,11 +199,16 @@ static void QuadtreeQueryHelper(const Quadtree* current, const Region region, De
 Deque QuadtreeQuery(const Quadtree* self, const Region region)
 {
 	Deque result = DEQUE_OF(size_t);
-	QuadtreeQueryHelper(self, region, &result);
+	QuadtreeQueryInto(self, region, &result);
 
 	return result;
 }
 
+void QuadtreeQueryInto(const Quadtree* self, const Region region, Deque* result)
+{
+	QuadtreeQueryHelper(self, region, result);
+}
+
 void QuadtreeClear(Quadtree* self)
 {
 	DequeClear(&self->entries);
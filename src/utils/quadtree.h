@@ -32,5 +32,8 @@ typedef struct Quadtree Quadtree;
 Quadtree* QuadtreeNew(Region region, uint8_t maxDepth);
 bool QuadtreeAdd(Quadtree* self, size_t id, Region aabb);
 Deque QuadtreeQuery(const Quadtree* self, Region region);
+// Like QuadtreeQuery, but pushes the entities onto the back of an existing `Deque<usize>` so that
+// the same Deque can be reused from query to query without allocating.
+void QuadtreeQueryInto(const Quadtree* self, Region region, Deque* result);
 void QuadtreeClear(Quadtree* self);
 void QuadtreeDestroy(Quadtree* self);
@@ -0,0 +1,101 @@
+// Tests that need the whole simulation, which is built headless for them (see `@sim/test`).
+
+#include "../src/context.h"
+#include "../src/footprint.h"
+#include "../src/scene.h"
+#include "testing.h"
+
+#include <raylib.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+static Scene* CreateScene(void)
+{
+	Scene* scene = calloc(1, sizeof(Scene));
+	SceneInit(scene);
+
+	return scene;
+}
+
+static void DestroyScene(Scene* scene)
+{
+	SceneDestroy(scene);
+	free(scene);
+}
+
+static bool FootprintTestFitsEveryBudget(void)
+{
+	Scene* scene = CreateScene();
+
+	const Footprint footprint = FootprintMeasure(scene);
+
+	bool passed = true;
+
+	for (usize i = 0; i < FOOTPRINT_TOTAL; ++i)
+	{
+		passed &= FootprintIsWithinBudget(&footprint, i);
+	}
+
+	DestroyScene(scene);
+
+	return passed;
+}
+
+static bool FootprintTestEstimatesEveryLayer(void)
+{
+	Scene* scene = CreateScene();
+
+	const Rectangle monitor = (Rectangle) {
+		.width = 1920,
+		.height = 1080,
+	};
+	const Footprint footprint = FootprintMeasureOnMonitor(scene, monitor);
+
+	// 1x1, two layers as large as the viewport, and six scaled up six times.
+	const usize viewportPixels = CTX_VIEWPORT_WIDTH * CTX_VIEWPORT_HEIGHT;
+	const usize expected = (1 + viewportPixels * 2 + viewportPixels * 36 * 6) * 8;
+
+	DestroyScene(scene);
+
+	return footprint.entries[FOOTPRINT_LAYERS].vramBytes == expected;
+}
+
+static bool FootprintTestFailsOverBudget(void)
+{
+	Scene* scene = CreateScene();
+
+	// An 8K monitor would need layers four times larger than the reference one's.
+	const Rectangle monitor = (Rectangle) {
+		.width = 7680,
+		.height = 4320,
+	};
+	const Footprint footprint = FootprintMeasureOnMonitor(scene, monitor);
+
+	DestroyScene(scene);
+
+	return !FootprintIsWithinBudget(&footprint, FOOTPRINT_LAYERS)
+		&& FootprintIsWithinBudget(&footprint, FOOTPRINT_ATLAS);
+}
+
+static bool ExecuteFootprintTests(void)
+{
+	TestSuite suite = TestSuiteCreate("Footprint Tests");
+
+	TestSuiteAdd(&suite, "Fit every budget on the reference monitor", FootprintTestFitsEveryBudget);
+	TestSuiteAdd(&suite, "Estimate every layer", FootprintTestEstimatesEveryLayer);
+	TestSuiteAdd(&suite, "Go over budget on an 8K monitor", FootprintTestFailsOverBudget);
+
+	return TestSuitePresentResults(&suite);
+}
+
+int main(void)
+{
+	bool allPass = true;
+
+	allPass &= ExecuteFootprintTests();
+
+	if (!allPass)
+	{
+		return EXIT_FAILURE;
+	}
+}
@@ -1,10 +1,23 @@
+#include "../src/bytes.h"
 #include "../src/collections/deque.h"
+#include "../src/counters.h"
+#include "../src/fixed.h"
+#include "../src/input_queue.h"
+#include "../src/profiler.h"
+#include "../src/replay.h"
+#include "../src/rng.h"
+#include "../src/startup.h"
+#include "../src/tracing.h"
 #include "../src/utils/quadtree.h"
 #include "testing.h"
 
+#include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <wyhash.h>
 
 typedef int32_t i32;
 
@@ -408,6 +421,41 @@ static bool TestQuadtreeQuery(void)
 	return totalHits == 2 + 3 + 0 + 0;
 }
 
+static bool TestQuadtreeQueryInto(void)
+{
+	const Region region = (Region) {
+		.x = 0,
+		.y = 0,
+		.width = 100,
+		.height = 100,
+	};
+	Quadtree* quadtree = QuadtreeNew(region, 4);
+
+	QuadtreeAdd(quadtree, 1, (Region) { 10, 10, 30, 30 });
+	QuadtreeAdd(quadtree, 2, (Region) { 60, 10, 30, 30 });
+
+	Deque queryResults = DEQUE_WITH_CAPACITY(usize, 8);
+	usize totalHits = 0;
+
+	// Reusing the same Deque for every query should never allocate.
+	CountersSample();
+
+	for (usize i = 0; i < 4; ++i)
+	{
+		DequeClear(&queryResults);
+		QuadtreeQueryInto(quadtree, (Region) { 0, 0, 100, 50 }, &queryResults);
+
+		totalHits += DequeGetSize(&queryResults);
+	}
+
+	const CounterSample sample = CountersSample();
+
+	DequeDestroy(&queryResults);
+	QuadtreeDestroy(quadtree);
+
+	return totalHits == 8 && sample.values[COUNTER_HEAP_ALLOCATIONS] == 0;
+}
+
 static bool TestQuadtreeClear(void)
 {
 	const Region region = (Region) {
@@ -503,17 +551,1009 @@ static bool ExecuteQuadtreeTests(void)
 	TestSuiteAdd(&suite, "Create an empty Quadtree", TestQuadtreeNew);
 	TestSuiteAdd(&suite, "Add entries to a Quadtree", TestQuadtreeAdd);
 	TestSuiteAdd(&suite, "Query a Quadtree", TestQuadtreeQuery);
+	TestSuiteAdd(&suite, "Query a Quadtree into a reused Deque", TestQuadtreeQueryInto);
 	TestSuiteAdd(&suite, "Clear a Quadtree", TestQuadtreeClear);
 
 	return TestSuitePresentResults(&suite);
 }
 
+#define TEST_REPLAY_LENGTH (1000)
+#define MAGIC_SEED (20180217)
+
+// Creates a Replay where every binding is toggled periodically (and at different rates).
+static Replay CreateTestReplay(void)
+{
+	InputStream stream = InputStreamCreate(4, TEST_REPLAY_LENGTH + 1);
+
+	for (usize i = 0; i < TEST_REPLAY_LENGTH; ++i)
+	{
+		const bool payload[4] = {
+			(i / 7) % 2 == 0,
+			(i / 60) % 3 == 1,
+			i % 13 == 0,
+			i > TEST_REPLAY_LENGTH / 2,
+		};
+
+		InputStreamPush(&stream, payload);
+	}
+
+	ReplayResult result = ReplayTryFromInputStream(MAGIC_SEED, &stream);
+
+	InputStreamDestroy(&stream);
+
+	return result.contents.ok;
+}
+
+static bool ReplaysAreEqual(const Replay* a, const Replay* b)
+{
+	return a->seed == b->seed && a->totalBindings == b->totalBindings && a->length == b->length
+		   && a->bits.size == b->bits.size
+		   && memcmp(a->bits.contents, b->bits.contents, a->bits.size) == 0;
+}
+
+static bool ReplayTestRoundTrip(const ReplayEncoding encoding)
+{
+	Replay replay = CreateTestReplay();
+	ReplayBytes bytes = ReplayBytesFromReplayWithEncoding(&replay, encoding);
+	ReplayResult result = ReplayTryFromBytes(bytes.data, bytes.size);
+
+	bool passed = result.type == REPLAY_RESULT_TYPE_OK;
+
+	if (passed)
+	{
+		passed = ReplaysAreEqual(&replay, &result.contents.ok);
+		ReplayDestroy(&result.contents.ok);
+	}
+
+	ReplayBytesDestroy(&bytes);
+	ReplayDestroy(&replay);
+
+	return passed;
+}
+
+static bool ReplayTestRoundTripRaw(void)
+{
+	return ReplayTestRoundTrip(REPLAY_ENCODING_RAW);
+}
+
+static bool ReplayTestRoundTripToggles(void)
+{
+	return ReplayTestRoundTrip(REPLAY_ENCODING_TOGGLES);
+}
+
+static bool ReplayTestRoundTripPlanar(void)
+{
+	return ReplayTestRoundTrip(REPLAY_ENCODING_PLANAR);
+}
+
+static bool ReplayTestPrefersSmallerEncoding(void)
+{
+	Replay replay = CreateTestReplay();
+	ReplayBytes raw = ReplayBytesFromReplayWithEncoding(&replay, REPLAY_ENCODING_RAW);
+	ReplayBytes bytes = ReplayBytesFromReplay(&replay);
+
+	const bool passed = bytes.size < raw.size;
+
+	ReplayBytesDestroy(&bytes);
+	ReplayBytesDestroy(&raw);
+	ReplayDestroy(&replay);
+
+	return passed;
+}
+
+static bool ReplayTestFallsBackToPlanar(void)
+{
+	InputStream stream = InputStreamCreate(4, TEST_REPLAY_LENGTH + 1);
+
+	for (usize i = 0; i < TEST_REPLAY_LENGTH; ++i)
+	{
+		// Toggling almost every frame makes toggles larger than the planar body.
+		const bool payload[4] = {
+			i % 2 == 0,
+			i % 3 == 0,
+			(i * 7) % 5 < 2,
+			i % 2 == 1,
+		};
+
+		InputStreamPush(&stream, payload);
+	}
+
+	Replay replay = ReplayTryFromInputStream(MAGIC_SEED, &stream).contents.ok;
+	ReplayBytes planar = ReplayBytesFromReplayWithEncoding(&replay, REPLAY_ENCODING_PLANAR);
+	ReplayBytes bytes = ReplayBytesFromReplay(&replay);
+
+	const bool passed
+		= bytes.size == planar.size && memcmp(bytes.data, planar.data, planar.size) == 0;
+
+	ReplayBytesDestroy(&bytes);
+	ReplayBytesDestroy(&planar);
+	ReplayDestroy(&replay);
+	InputStreamDestroy(&stream);
+
+	return passed;
+}
+
+static bool ReplayTestDecodesVersion1(void)
+{
+	Replay replay = CreateTestReplay();
+
+	// Construct a version 1 Replay by hand (its body is the same as a raw version 2 Replay).
+	ReplayBytes raw = ReplayBytesFromReplayWithEncoding(&replay, REPLAY_ENCODING_RAW);
+
+	const usize bodySize = raw.size - 16;
+	const usize size = 5 + 4 + 1 + 4 + bodySize;
+	u8* data = malloc(size);
+	{
+		const u32 seed = U32ToBigEndian(replay.seed);
+		const u32 length = U32ToBigEndian(replay.length);
+
+		memcpy(data, "ltlrr", 5);
+		memcpy(data + 5, &seed, 4);
+		memcpy(data + 9, &replay.totalBindings, 1);
+		memcpy(data + 10, &length, 4);
+		memcpy(data + 14, (u8*)raw.data + 16, bodySize);
+	}
+
+	ReplayBytesDestroy(&raw);
+
+	ReplayResult result = ReplayTryFromBytes(data, size);
+
+	bool passed = result.type == REPLAY_RESULT_TYPE_OK;
+
+	if (passed)
+	{
+		passed = ReplaysAreEqual(&replay, &result.contents.ok);
+		ReplayDestroy(&result.contents.ok);
+	}
+
+	free(data);
+	ReplayDestroy(&replay);
+
+	return passed;
+}
+
+static bool ReplayTestRoundTripsFlags(void)
+{
+	Replay replay = CreateTestReplay();
+	ReplayBytes bytes = ReplayBytesFromReplayWithEncoding(&replay, REPLAY_ENCODING_PLANAR);
+	ReplayResult result = ReplayTryFromBytes(bytes.data, bytes.size);
+
+	bool passed = replay.flags == REPLAY_FLAGS_CURRENT && result.type == REPLAY_RESULT_TYPE_OK;
+
+	if (passed)
+	{
+		passed = result.contents.ok.flags == replay.flags;
+		ReplayDestroy(&result.contents.ok);
+	}
+
+	ReplayBytesDestroy(&bytes);
+	ReplayDestroy(&replay);
+
+	return passed;
+}
+
+static bool ReplayTestVersion2HasNoFlags(void)
+{
+	Replay replay = CreateTestReplay();
+	ReplayBytes bytes = ReplayBytesFromReplayWithEncoding(&replay, REPLAY_ENCODING_PLANAR);
+
+	// Version 2 Replays are identical to version 3 ones, except that their flags are padding.
+	u8* data = bytes.data;
+	data[4] = 2;
+	data[REPLAY_HEADER_SIZE - 1] = 0xFF;
+
+	ReplayResult result = ReplayTryFromBytes(bytes.data, bytes.size);
+
+	bool passed = result.type == REPLAY_RESULT_TYPE_OK;
+
+	if (passed)
+	{
+		passed = result.contents.ok.flags == 0 && ReplaysAreEqual(&replay, &result.contents.ok);
+		ReplayDestroy(&result.contents.ok);
+	}
+
+	ReplayBytesDestroy(&bytes);
+	ReplayDestroy(&replay);
+
+	return passed;
+}
+
+static bool ReplayTestRejectsTruncatedBytes(void)
+{
+	Replay replay = CreateTestReplay();
+	ReplayBytes bytes = ReplayBytesFromReplayWithEncoding(&replay, REPLAY_ENCODING_RAW);
+
+	const ReplayResult result = ReplayTryFromBytes(bytes.data, bytes.size - 1);
+
+	const bool passed = result.type == REPLAY_RESULT_TYPE_ERR
+						&& result.contents.err == REPLAY_ERROR_TOO_FEW_BYTES;
+
+	ReplayBytesDestroy(&bytes);
+	ReplayDestroy(&replay);
+
+	return passed;
+}
+
+static bool ReplayTestRejectsMalformedToggles(void)
+{
+	Replay replay = CreateTestReplay();
+	ReplayBytes bytes = ReplayBytesFromReplayWithEncoding(&replay, REPLAY_ENCODING_TOGGLES);
+
+	// Make the last varint claim that more bytes follow it.
+	((u8*)bytes.data)[bytes.size - 1] |= 0x80;
+
+	const ReplayResult result = ReplayTryFromBytes(bytes.data, bytes.size);
+
+	const bool passed = result.type == REPLAY_RESULT_TYPE_ERR
+						&& result.contents.err == REPLAY_ERROR_MALFORMED_BODY;
+
+	ReplayBytesDestroy(&bytes);
+	ReplayDestroy(&replay);
+
+	return passed;
+}
+
+static bool ReplayTestViewsPlanarBytesInPlace(void)
+{
+	Replay replay = CreateTestReplay();
+	ReplayBytes planar = ReplayBytesFromReplayWithEncoding(&replay, REPLAY_ENCODING_PLANAR);
+	ReplayBytes raw = ReplayBytesFromReplayWithEncoding(&replay, REPLAY_ENCODING_RAW);
+
+	const ReplayResult view = ReplayTryViewBytes(planar.data, planar.size);
+	const ReplayResult unviewable = ReplayTryViewBytes(raw.data, raw.size);
+
+	const bool passed = view.type == REPLAY_RESULT_TYPE_OK
+						&& ReplaysAreEqual(&replay, &view.contents.ok)
+						&& (u8*)view.contents.ok.bits.contents == (u8*)planar.data + 16
+						&& unviewable.type == REPLAY_RESULT_TYPE_ERR
+						&& unviewable.contents.err == REPLAY_ERROR_UNVIEWABLE_BODY;
+
+	ReplayBytesDestroy(&raw);
+	ReplayBytesDestroy(&planar);
+	ReplayDestroy(&replay);
+
+	return passed;
+}
+
+static bool ReplayTestViewIsReadOnly(void)
+{
+	Replay replay = CreateTestReplay();
+	InputStream stream = InputStreamCreateView(&replay);
+
+	bool passed = true;
+
+	// Pushing must neither modify the Replay nor wrap around to the start of it.
+	for (usize i = 0; i < TEST_REPLAY_LENGTH + 1; ++i)
+	{
+		const bool payload[4] = { true, true, true, true };
+
+		InputStreamPush(&stream, payload);
+	}
+
+	for (u32 frame = 0; frame < TEST_REPLAY_LENGTH * 2; ++frame)
+	{
+		for (u8 binding = 0; binding < 4; ++binding)
+		{
+			const bool expected = BitMaskGet(&replay.bits, frame, binding);
+
+			passed &= InputStreamPressing(&stream, binding, frame) == expected;
+		}
+	}
+
+	passed &= stream.length == TEST_REPLAY_LENGTH;
+
+	InputStreamDestroy(&stream);
+	ReplayDestroy(&replay);
+
+	return passed;
+}
+
+static bool ReplayTestCutsOffInputStream(void)
+{
+	Replay replay = CreateTestReplay();
+	InputStream view = InputStreamCreateView(&replay);
+
+	const u32 frames = TEST_REPLAY_LENGTH / 3;
+
+	ReplayResult result = ReplayTryFromInputStreamUntil(MAGIC_SEED, &view, frames);
+
+	bool passed = result.type == REPLAY_RESULT_TYPE_OK && result.contents.ok.length == frames;
+
+	if (passed)
+	{
+		InputStream cut = InputStreamCreateView(&result.contents.ok);
+
+		for (u32 frame = 0; frame < TEST_REPLAY_LENGTH; ++frame)
+		{
+			for (u8 binding = 0; binding < 4; ++binding)
+			{
+				const bool expected = frame < frames && InputStreamPressing(&view, binding, frame);
+
+				passed &= InputStreamPressing(&cut, binding, frame) == expected;
+			}
+		}
+
+		ReplayDestroy(&result.contents.ok);
+	}
+
+	ReplayDestroy(&replay);
+
+	return passed;
+}
+
+static bool ReplayTestClearForgetsEverything(void)
+{
+	InputStream stream = InputStreamCreate(4, 128);
+
+	for (usize i = 0; i < 100; ++i)
+	{
+		const bool payload[4] = { i % 2 == 0, true, false, i % 3 == 0 };
+
+		InputStreamPush(&stream, payload);
+	}
+
+	InputStreamConsume(&stream, 1, 99);
+	InputStreamClear(&stream);
+
+	bool passed = stream.length == 0 && stream.barriers[1] == 0;
+
+	for (u32 frame = 0; frame < 128; ++frame)
+	{
+		for (u8 binding = 0; binding < 4; ++binding)
+		{
+			passed &= !InputStreamPressing(&stream, binding, frame);
+		}
+	}
+
+	InputStreamDestroy(&stream);
+
+	return passed;
+}
+
+static bool ReplayTestContinuesInputStream(void)
+{
+	Replay replay = CreateTestReplay();
+	InputStream view = InputStreamCreateView(&replay);
+	InputStream stream = InputStreamCreate(4, 128);
+
+	const u32 frames = TEST_REPLAY_LENGTH / 2;
+
+	InputStreamConsume(&view, 2, frames - 1);
+	InputStreamContinue(&stream, &view, frames);
+
+	bool passed = stream.length == frames && stream.barriers[2] == view.barriers[2];
+
+	// Everything InputStreamPressed and InputStreamReleased can look back on must be intact.
+	for (u32 frame = frames - BIT_MASK_ENTRY_TOTAL_BITS; frame < frames; ++frame)
+	{
+		for (u8 binding = 0; binding < 4; ++binding)
+		{
+			passed &=
+				InputStreamPressing(&stream, binding, frame)
+				== InputStreamPressing(&view, binding, frame);
+		}
+	}
+
+	const bool payload[4] = { true, false, true, false };
+	InputStreamPush(&stream, payload);
+
+	passed &= InputStreamPressing(&stream, 0, frames) && !InputStreamPressing(&stream, 1, frames);
+
+	InputStreamDestroy(&stream);
+	ReplayDestroy(&replay);
+
+	return passed;
+}
+
+static bool ReplayTestCopiesInputStream(void)
+{
+	InputStream source = InputStreamCreate(4, 128);
+	InputStream copy = InputStreamCreate(4, 128);
+
+	for (usize i = 0; i < 200; ++i)
+	{
+		const bool payload[4] = { i % 2 == 0, true, false, i % 3 == 0 };
+
+		InputStreamPush(&source, payload);
+	}
+
+	InputStreamConsume(&source, 3, 150);
+	InputStreamCopy(&copy, &source);
+
+	bool passed = copy.length == source.length && copy.barriers[3] == 150;
+
+	for (u32 frame = 200 - 128; frame < 200; ++frame)
+	{
+		for (u8 binding = 0; binding < 4; ++binding)
+		{
+			passed &=
+				InputStreamPressing(&copy, binding, frame)
+				== InputStreamPressing(&source, binding, frame);
+		}
+	}
+
+	InputStreamDestroy(&copy);
+	InputStreamDestroy(&source);
+
+	return passed;
+}
+
+// A frame by frame implementation of InputStreamPressed (and InputStreamReleased when `pressed`
+// is false) to compare against.
+static bool ReferencePressedOrReleased(
+	const InputStream* stream,
+	const u8 binding,
+	const usize buffer,
+	const u32 frame,
+	const bool pressed
+)
+{
+	if (InputStreamPressing(stream, binding, frame) != pressed)
+	{
+		return false;
+	}
+
+	for (usize i = 1; i <= buffer; ++i)
+	{
+		if (frame - i < stream->barriers[binding])
+		{
+			return false;
+		}
+
+		if (InputStreamPressing(stream, binding, frame - i) != pressed)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool ReplayTestPressedAndReleasedMatchReference(void)
+{
+	// The InputStream wraps around several times.
+	InputStream stream = InputStreamCreate(4, 100);
+	u32 state = MAGIC_SEED;
+
+	bool passed = true;
+
+	for (u32 frame = 0; frame < TEST_REPLAY_LENGTH; ++frame)
+	{
+		bool payload[4];
+
+		for (usize i = 0; i < 4; ++i)
+		{
+			state = state * 1664525 + 1013904223;
+			payload[i] = (state >> 28) < 6 + (i * 2);
+		}
+
+		InputStreamPush(&stream, payload);
+
+		for (u8 binding = 0; binding < 4; ++binding)
+		{
+			for (usize buffer = 0; buffer < 64; buffer += buffer < 16 ? 1 : 23)
+			{
+				passed &= InputStreamPressed(&stream, binding, buffer, frame)
+						  == ReferencePressedOrReleased(&stream, binding, buffer, frame, true);
+				passed &= InputStreamReleased(&stream, binding, buffer, frame)
+						  == ReferencePressedOrReleased(&stream, binding, buffer, frame, false);
+			}
+
+			if ((state >> 24) % 5 == binding)
+			{
+				InputStreamConsume(&stream, binding, frame);
+			}
+		}
+	}
+
+	InputStreamDestroy(&stream);
+
+	return passed;
+}
+
+static bool ExecuteReplayTests(void)
+{
+	TestSuite suite = TestSuiteCreate("Replay Tests");
+
+	TestSuiteAdd(&suite, "Round trip a raw Replay", ReplayTestRoundTripRaw);
+	TestSuiteAdd(&suite, "Round trip a toggles Replay", ReplayTestRoundTripToggles);
+	TestSuiteAdd(&suite, "Round trip a planar Replay", ReplayTestRoundTripPlanar);
+	TestSuiteAdd(&suite, "Prefer the smaller encoding", ReplayTestPrefersSmallerEncoding);
+	TestSuiteAdd(&suite, "Fall back to planar encoding", ReplayTestFallsBackToPlanar);
+	TestSuiteAdd(&suite, "Decode a version 1 Replay", ReplayTestDecodesVersion1);
+	TestSuiteAdd(&suite, "Round trip a Replay's flags", ReplayTestRoundTripsFlags);
+	TestSuiteAdd(&suite, "Decode a version 2 Replay without flags", ReplayTestVersion2HasNoFlags);
+	TestSuiteAdd(&suite, "Reject a truncated Replay", ReplayTestRejectsTruncatedBytes);
+	TestSuiteAdd(&suite, "Reject a malformed Replay", ReplayTestRejectsMalformedToggles);
+	TestSuiteAdd(&suite, "View a planar Replay in place", ReplayTestViewsPlanarBytesInPlace);
+	TestSuiteAdd(&suite, "Ignore pushes to a read-only InputStream", ReplayTestViewIsReadOnly);
+	TestSuiteAdd(&suite, "Clear an InputStream", ReplayTestClearForgetsEverything);
+	TestSuiteAdd(&suite, "Continue from another InputStream", ReplayTestContinuesInputStream);
+	TestSuiteAdd(&suite, "Copy an InputStream", ReplayTestCopiesInputStream);
+	TestSuiteAdd(&suite, "Cut an InputStream off at a given frame", ReplayTestCutsOffInputStream);
+	TestSuiteAdd(
+		&suite,
+		"Match the frame by frame definition of pressed and released",
+		ReplayTestPressedAndReleasedMatchReference
+	);
+
+	return TestSuitePresentResults(&suite);
+}
+
+static bool InputQueueTestPopsInOrder(void)
+{
+	InputQueue queue;
+	InputQueueInit(&queue);
+
+	bool passed = true;
+
+	for (u32 i = 0; i < 3; ++i)
+	{
+		const InputEvent event = { .timestamp = i, .pressing = i, .player = 0 };
+
+		passed &= InputQueuePush(&queue, event);
+	}
+
+	InputEvent event;
+
+	for (u32 i = 0; i < 3; ++i)
+	{
+		passed &= InputQueueTryPopUntil(&queue, INFINITY, &event) && event.pressing == i;
+	}
+
+	passed &= !InputQueueTryPopUntil(&queue, INFINITY, &event);
+
+	return passed;
+}
+
+static bool InputQueueTestRespectsDeadline(void)
+{
+	InputQueue queue;
+	InputQueueInit(&queue);
+
+	InputQueuePush(&queue, (InputEvent) { .timestamp = 1.0, .pressing = 1, .player = 0 });
+	InputQueuePush(&queue, (InputEvent) { .timestamp = 2.0, .pressing = 2, .player = 1 });
+
+	InputEvent event;
+
+	bool passed = !InputQueueTryPopUntil(&queue, 0.5, &event);
+	passed &= InputQueueTryPopUntil(&queue, 1.5, &event) && event.pressing == 1;
+	passed &= !InputQueueTryPopUntil(&queue, 1.5, &event);
+	passed &= InputQueueTryPopUntil(&queue, 2.0, &event) && event.player == 1;
+
+	return passed && InputQueueGetSize(&queue) == 0;
+}
+
+static bool InputQueueTestRejectsWhenFull(void)
+{
+	InputQueue queue;
+	InputQueueInit(&queue);
+
+	bool passed = true;
+
+	// Go around the ring a few times to make sure indices wrap correctly.
+	for (u32 lap = 0; lap < 3; ++lap)
+	{
+		for (u32 i = 0; i < INPUT_QUEUE_CAPACITY; ++i)
+		{
+			passed &= InputQueuePush(&queue, (InputEvent) { .timestamp = 0, .pressing = i });
+		}
+
+		passed &= !InputQueuePush(&queue, (InputEvent) { .timestamp = 0, .pressing = 0 });
+		passed &= InputQueueGetSize(&queue) == INPUT_QUEUE_CAPACITY;
+
+		InputEvent event;
+
+		for (u32 i = 0; i < INPUT_QUEUE_CAPACITY; ++i)
+		{
+			passed &= InputQueueTryPopUntil(&queue, 0, &event) && event.pressing == i;
+		}
+	}
+
+	return passed;
+}
+
+static bool ExecuteInputQueueTests(void)
+{
+	TestSuite suite = TestSuiteCreate("InputQueue Tests");
+
+	TestSuiteAdd(&suite, "Pop events in the order they were pushed", InputQueueTestPopsInOrder);
+	TestSuiteAdd(&suite, "Only pop events before the deadline", InputQueueTestRespectsDeadline);
+	TestSuiteAdd(&suite, "Reject events when full", InputQueueTestRejectsWhenFull);
+
+	return TestSuitePresentResults(&suite);
+}
+
+static bool RngTestSequentialMatchesWyrand(void)
+{
+	// Older Replays depend on this exact sequence.
+	Rng rng = RngCreateSequential(MAGIC_SEED);
+	u64 state = MAGIC_SEED;
+
+	bool passed = true;
+
+	for (usize i = 0; i < 100; ++i)
+	{
+		const u64 expected = wyrand(&state);
+		const i32 expectedRange = -3 + (10 * wy2u01(wyrand(&state)));
+
+		passed &= RngNextU64(&rng) == expected;
+		passed &= RngNextRange(&rng, -3, 7) == expectedRange;
+	}
+
+	return passed;
+}
+
+static bool RngTestFillMatchesNextRange(void)
+{
+	Rng a = RngCreate(MAGIC_SEED);
+	Rng b = RngCreate(MAGIC_SEED);
+
+	i32 values[257];
+	RngFillRange(&a, values, 257, -5, 12);
+
+	bool passed = true;
+
+	for (usize i = 0; i < 257; ++i)
+	{
+		passed &= values[i] >= -5 && values[i] < 12 && values[i] == RngNextRange(&b, -5, 12);
+	}
+
+	// Both should continue from the same place.
+	passed &= RngNextU64(&a) == RngNextU64(&b);
+
+	// The widest possible range should not overflow.
+	RngFillRange(&a, values, 257, INT32_MIN, INT32_MAX);
+
+	for (usize i = 0; i < 257; ++i)
+	{
+		passed &= values[i] != INT32_MAX;
+	}
+
+	return passed;
+}
+
+static bool RngTestRangeIsUniform(void)
+{
+	Rng rng = RngCreate(MAGIC_SEED);
+
+	usize counts[3] = { 0 };
+
+	for (usize i = 0; i < 30000; ++i)
+	{
+		counts[RngNextRange(&rng, 0, 3)] += 1;
+	}
+
+	bool passed = true;
+
+	for (usize i = 0; i < 3; ++i)
+	{
+		passed &= counts[i] > 9700 && counts[i] < 10300;
+	}
+
+	return passed;
+}
+
+static bool RngTestSplitStreamsAreIndependent(void)
+{
+	const Rng rng = RngCreate(MAGIC_SEED);
+	Rng parent = rng;
+	Rng a = RngSplit(&rng, 0);
+	Rng b = RngSplit(&rng, 1);
+	Rng c = RngSplit(&rng, 1);
+
+	const u64 valueParent = RngNextU64(&parent);
+	const u64 valueA = RngNextU64(&a);
+	const u64 valueB = RngNextU64(&b);
+
+	return valueParent != valueA && valueParent != valueB && valueA != valueB
+		   && valueB == RngNextU64(&c);
+}
+
+static bool ExecuteRngTests(void)
+{
+	TestSuite suite = TestSuiteCreate("Rng Tests");
+
+	TestSuiteAdd(&suite, "Sequential Rng matches wyrand", RngTestSequentialMatchesWyrand);
+	TestSuiteAdd(&suite, "Fill a range like RngNextRange", RngTestFillMatchesNextRange);
+	TestSuiteAdd(&suite, "Ranges are uniform", RngTestRangeIsUniform);
+	TestSuiteAdd(&suite, "Split streams are independent", RngTestSplitStreamsAreIndependent);
+
+	return TestSuitePresentResults(&suite);
+}
+
+static bool FixedTestRoundTripsThroughF32(void)
+{
+	bool passed = true;
+
+	for (Fixed value = -(1 << 16); value <= (1 << 16); value += 7)
+	{
+		passed &= FixedFromF32(FixedToF32(value)) == value;
+	}
+
+	passed &= FixedFromF32(1.0F / 512) == 1;
+	passed &= FixedFromF32(-1.0F / 512) == 0;
+	passed &= FixedFromF32(3.1F) == 794;
+
+	return passed;
+}
+
+static bool FixedTestScaleRoundsToNearest(void)
+{
+	return FixedScale(FIXED_ONE, 1, 60) == 4 && FixedScale(-FIXED_ONE, 1, 60) == -4
+		   && FixedScale(30, 1, 60) == 1 && FixedScale(-30, 1, 60) == -1
+		   && FixedScale(29, 1, 60) == 0 && FixedScale(FIXED_ONE * 5, 3, 2) == FIXED_ONE * 15 / 2;
+}
+
+static bool FixedTestTrigIsAccurate(void)
+{
+	bool passed = true;
+
+	for (f64 radians = -40; radians < 40; radians += 0.01)
+	{
+		passed &= fabs(FixedSin(radians) - sin(radians)) < 1e-4;
+		passed &= fabs(FixedCos(radians) - cos(radians)) < 1e-4;
+	}
+
+	return passed;
+}
+
+static bool ExecuteFixedTests(void)
+{
+	TestSuite suite = TestSuiteCreate("Fixed Tests");
+
+	TestSuiteAdd(&suite, "Round trip a Fixed through an f32", FixedTestRoundTripsThroughF32);
+	TestSuiteAdd(&suite, "Scale a Fixed to the nearest value", FixedTestScaleRoundsToNearest);
+	TestSuiteAdd(&suite, "Approximate sin and cos", FixedTestTrigIsAccurate);
+
+	return TestSuitePresentResults(&suite);
+}
+
+// Profilers measure time with raylib's GetTime; let the tests decide what time it is instead.
+static f64 fakeTime;
+
+double GetTime(void)
+{
+	return fakeTime;
+}
+
+static bool ProfilerTestNestsSections(void)
+{
+	static Profiler profiler;
+	ProfilerInit(&profiler);
+
+	fakeTime = 0;
+
+	for (usize i = 0; i < 2; ++i)
+	{
+		ProfilerBeginFrame(&profiler);
+		{
+			PROFILE_BEGIN("outer");
+			fakeTime += 1;
+			{
+				// Sections that run more than once per frame add up.
+				PROFILE_BEGIN("inner");
+				fakeTime += 2;
+				PROFILE_END();
+
+				PROFILE_BEGIN("inner");
+				fakeTime += 3;
+				PROFILE_END();
+			}
+			PROFILE_END();
+		}
+		fakeTime += 4;
+		ProfilerEndFrame(&profiler);
+	}
+
+	// Nothing should be recorded outside of a frame.
+	PROFILE_BEGIN("ignored");
+	PROFILE_END();
+
+	const ProfilerSection* outer = &profiler.sections[0];
+	const ProfilerSection* inner = &profiler.sections[1];
+
+	return profiler.frames == 2 && profiler.sectionsLength == 2 && profiler.frameTimes[1] == 10
+		   && strcmp(outer->name, "outer") == 0 && outer->depth == 0 && outer->history[1] == 6
+		   && strcmp(inner->name, "inner") == 0 && inner->depth == 1 && inner->history[1] == 5;
+}
+
+static bool ProfilerTestCalculatesStats(void)
+{
+	static Profiler profiler;
+	ProfilerInit(&profiler);
+
+	fakeTime = 0;
+
+	// Frames take 1 through 300 seconds; only the most recent PROFILER_HISTORY count.
+	for (usize i = 1; i <= 300; ++i)
+	{
+		ProfilerBeginFrame(&profiler);
+		fakeTime += i;
+		ProfilerEndFrame(&profiler);
+	}
+
+	const ProfilerStats stats = ProfilerGetFrameStats(&profiler);
+
+	return stats.min == 300 - PROFILER_HISTORY + 1 && stats.max == 300
+		   && stats.average == 300 - (PROFILER_HISTORY - 1) * 0.5F && stats.p99 == 298;
+}
+
+static bool ExecuteProfilerTests(void)
+{
+	TestSuite suite = TestSuiteCreate("Profiler Tests");
+
+	TestSuiteAdd(&suite, "Nest and accumulate sections", ProfilerTestNestsSections);
+	TestSuiteAdd(&suite, "Calculate min, average, p99, and max", ProfilerTestCalculatesStats);
+
+	return TestSuitePresentResults(&suite);
+}
+
+static bool TracingTestSavesChromeTrace(void)
+{
+	static const char* path = "trace_test.json";
+
+	TracingEnable();
+	TracingNameThread("Tests");
+
+	// Ends without a beginning (e.g. because it was overwritten) should be left out.
+	TracingEnd();
+
+	fakeTime = 1;
+	TracingBegin("outer");
+	TracingCounter("count", 42);
+	fakeTime = 2;
+	TracingEnd();
+
+	if (!TracingSave(path))
+	{
+		return false;
+	}
+
+	FILE* file = fopen(path, "r");
+	char contents[1024] = { 0 };
+	fread(contents, 1, sizeof(contents) - 1, file);
+	fclose(file);
+	remove(path);
+
+	usize ends = 0;
+
+	for (const char* end = strstr(contents, "\"ph\":\"E\""); end != NULL;
+		 end = strstr(end + 1, "\"ph\":\"E\""))
+	{
+		ends += 1;
+	}
+
+	return ends == 1 && strstr(contents, "\"args\":{\"name\":\"Tests\"}") != NULL
+		   && strstr(contents, "{\"name\":\"outer\",\"ph\":\"B\",\"ts\":1000000.000") != NULL
+		   && strstr(contents, "\"name\":\"count\",\"ph\":\"C\"") != NULL
+		   && strstr(contents, "\"args\":{\"value\":42}") != NULL
+		   && strstr(contents, "{\"ph\":\"E\",\"ts\":2000000.000") != NULL;
+}
+
+static bool ExecuteTracingTests(void)
+{
+	TestSuite suite = TestSuiteCreate("Tracing Tests");
+
+	TestSuiteAdd(&suite, "Save events as a Chrome trace", TracingTestSavesChromeTrace);
+
+	return TestSuitePresentResults(&suite);
+}
+
+static bool CountersTestSamplesFrames(void)
+{
+	// Start from a clean frame.
+	CountersSample();
+
+	Deque deque = DEQUE_WITH_CAPACITY(usize, 2);
+
+	for (usize i = 0; i < 4; ++i)
+	{
+		DEQUE_PUSH_BACK(&deque, usize, i);
+	}
+
+	DequeDestroy(&deque);
+
+	CounterSet(COUNTER_LIVE_ENTITIES, 7);
+	CounterRaise(COUNTER_ARENA_BYTES, 64);
+	CounterRaise(COUNTER_ARENA_BYTES, 32);
+
+	const CounterSample first = CountersSample();
+	const CounterSample second = CountersSample();
+
+	for (usize i = 0; i < COUNTER_TOTAL; ++i)
+	{
+		// Every frame starts from zero.
+		if (second.values[i] != 0)
+		{
+			return false;
+		}
+	}
+
+	// The Deque was created, then resized once it held more than its initial capacity.
+	return first.values[COUNTER_DEQUE_RESIZES] == 1 && first.values[COUNTER_HEAP_ALLOCATIONS] == 2
+		   && first.values[COUNTER_LIVE_ENTITIES] == 7 && first.values[COUNTER_ARENA_BYTES] == 64;
+}
+
+static bool ExecuteCountersTests(void)
+{
+	TestSuite suite = TestSuiteCreate("Counters Tests");
+
+	TestSuiteAdd(&suite, "Count a frame, then start over", CountersTestSamplesFrames);
+
+	return TestSuitePresentResults(&suite);
+}
+
+static bool StartupTestRecordsPhases(void)
+{
+	StartupInit();
+	StartupNameThread("Tests");
+
+	const usize first = StartupBegin("first");
+	const usize second = StartupBegin("second");
+	StartupEnd(second);
+	StartupEnd(first);
+
+	// Phases beyond the limit are dropped rather than overflowing.
+	for (usize i = 2; i < STARTUP_MAX_PHASES + 4; ++i)
+	{
+		StartupEnd(StartupBegin("filler"));
+	}
+
+	if (StartupIsFinished())
+	{
+		return false;
+	}
+
+	StartupFinish();
+	const f64 timeToFirstFrame = StartupGetTimeToFirstFrame();
+	StartupFinish();
+
+	FILE* file = tmpfile();
+	StartupWriteReport(file);
+	rewind(file);
+
+	char contents[4096] = { 0 };
+	fread(contents, 1, sizeof(contents) - 1, file);
+	fclose(file);
+
+	usize lines = 0;
+
+	for (const char* line = strchr(contents, '\n'); line != NULL; line = strchr(line + 1, '\n'))
+	{
+		lines += 1;
+	}
+
+	// A header, every phase that fit, and the first frame.
+	return StartupIsFinished() && StartupGetTimeToFirstFrame() == timeToFirstFrame
+		   && timeToFirstFrame >= 0 && lines == 1 + STARTUP_MAX_PHASES + 1
+		   && strstr(contents, "first                    Tests") != NULL
+		   && strstr(contents, "second                   Tests") != NULL;
+}
+
+static bool ExecuteStartupTests(void)
+{
+	TestSuite suite = TestSuiteCreate("Startup Tests");
+
+	TestSuiteAdd(&suite, "Record phases until the first frame", StartupTestRecordsPhases);
+
+	return TestSuitePresentResults(&suite);
+}
+
 int main(void)
 {
 	bool allPass = true;
 
 	allPass &= ExecuteDequeTests();
 	allPass &= ExecuteQuadtreeTests();
+	allPass &= ExecuteReplayTests();
+	allPass &= ExecuteInputQueueTests();
+	allPass &= ExecuteRngTests();
+	allPass &= ExecuteFixedTests();
+	allPass &= ExecuteProfilerTests();
+	allPass &= ExecuteTracingTests();
+	allPass &= ExecuteCountersTests();
+	allPass &= ExecuteStartupTests();
 
 	if (!allPass)
 	{